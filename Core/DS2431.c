@@ -11,6 +11,7 @@
 #include "DS2431.h"
 
 #include <stdio.h>
+#include <string.h>
 
 uint64_t ds2431ROMid = 0x00000000;
 owParamPage1 st_OwParamPage1;
@@ -24,6 +25,49 @@ ChipConnectStatus ds2431connectstatus;
 extern I2C_HandleTypeDef hi2cOneWire; /*I2C peripheral handeller*/
 #define DS2484_I2C &hi2cOneWire
 
+/* overdrive is used until the first CRC failure */
+static uint8_t b_ow_overdrive = DS2431_OVERDRIVE;
+
+/* ROM IDs of the devices on the 1-Wire bus, validated by CRC8. With more than one device the torch EEPROM
+ * (ow_rom_target) is addressed by MATCH ROM, then by RESUME as long as no other device was addressed. */
+static uint8_t ow_rom_ids[OW_ROM_MAX][OW_ROM_BYTES];
+static uint8_t ow_rom_count = 0;
+static uint8_t ow_rom_target = OW_ROM_MAX; // index of the torch EEPROM
+static uint8_t ow_rom_resume = OW_ROM_MAX; // index of the device with its RESUME flag set
+
+/* buffers and scripts of the asynchronous transactions, valid until the transaction is done */
+static uint8_t ow_async_cmd[1 + ADDRESS_SIZE_BYTES + BYTES_PER_ROW]; // command, TA1, TA2, data
+static uint8_t ow_async_skip_cmd;
+static uint8_t ow_async_scratch_cmd;
+static uint8_t ow_async_copy_cmd;
+static uint8_t ow_async_match[1 + OW_ROM_BYTES]; // MATCH ROM command, ROM ID
+static uint8_t ow_async_data[Read_Scratchpad_BYTES];
+static uint8_t ow_async_crc[Read_CRC_BYTES];
+static uint8_t ow_async_copy_status;
+static uint16_t ow_async_address;
+static ow_op_t ow_async_ops[14];
+static uint8_t ow_async_image[NUM_PARAM_PAGES * BYTES_PER_PAGE];
+static ow_async_cb_t *p_ow_async_cb;
+
+/* RAM shadow: content of the parameter pages in the EEPROM as last read or written. A row is dirty if the page content
+ * differs from the shadow or if its content in the EEPROM is unknown. */
+static uint8_t ow_shadow[NUM_PARAM_PAGES * BYTES_PER_PAGE];
+static volatile uint16_t ow_shadow_unknown = OW_ROWS_ALL;
+
+static uint8_t ow_scratchpad_valid_ds2431(const uint8_t *p_scratch, uint16_t MemAddress, const uint8_t *p_bytes);
+static uint8_t ow_async_select(ow_op_t *p_ops);
+static uint8_t *ow_page_data_ds2431(owPage localpage);
+static uint16_t ow_page_address_ds2431(owPage localpage);
+static uint8_t *ow_row_data_ds2431(uint8_t row);
+static void ow_shadow_store_ds2431(uint16_t MemAddress, const uint8_t *p_bytes, uint16_t Size);
+static uint8_t ow_rom_valid_ds2431(const uint8_t *p_rom);
+static void ow_rom_set_target_ds2431(uint8_t index);
+static void ow_read_ROMID_async_done(HAL_StatusTypeDef status);
+static void owParamPage_read_all_async_done(HAL_StatusTypeDef status);
+static void ow_read_memory_async_done(HAL_StatusTypeDef status);
+static void ow_write_mem_row_async_scratch_done(HAL_StatusTypeDef status);
+static void ow_write_mem_row_async_done(HAL_StatusTypeDef status);
+
 /******************************************************************************
 ** Name               : @fn update_chipstatus
 **
@@ -70,8 +114,7 @@ HAL_StatusTypeDef ow_write_scratchpad_ds2431(uint16_t Address, uint8_t bytes[],
 
     HAL_StatusTypeDef I2C_Return = HAL_OK;
 
-    I2C_Return = ow_one_wire_reset_ds2484();                // Reset pulse
-    I2C_Return = ow_write_byte_ds2484(DS2431_SKIPROM);      // Issue �Skip ROM� command
+    I2C_Return = ow_select_ds2431();                        // Reset pulse and Skip ROM
     I2C_Return = ow_write_byte_ds2484(DS2431_WRITESCRATCH); // Issue �Write Scratchpad� command
     I2C_Return = ow_write_byte_ds2484(targetAdress[0]);
     I2C_Return = ow_write_byte_ds2484(targetAdress[1]);
@@ -80,13 +123,8 @@ HAL_StatusTypeDef ow_write_scratchpad_ds2431(uint16_t Address, uint8_t bytes[],
         I2C_Return = ow_write_byte_ds2484(bytes[i]);
     for (int i = 0; i < Read_CRC_BYTES; i++) // Read CRC to check for data integrity
     {
-        I2C_Return = ow_read_byte_ds2484();
-        I2C_Return = ow_set_read_pointer_ds2484(DS2484_PTR_CODE_DATA);
-        HAL_Delay(DS2484_DELAY);
-        I2C_Return =
-            HAL_I2C_Master_Receive(DS2484_I2C, DS2484_ADDRESS_READ, &Read_CRC[i], 1, Time_OUT); // read databyte
+        I2C_Return = ow_read_data_ds2484(&Read_CRC[i]); // read databyte
     }
-    HAL_Delay(DS2484_DELAY);
     return I2C_Return;
 }
 
@@ -109,18 +147,12 @@ HAL_StatusTypeDef ow_read_scratchpad_ds2431(uint8_t *Read_Scratchpad) {
 
     HAL_StatusTypeDef I2C_Return = HAL_OK;
 
-    I2C_Return = ow_one_wire_reset_ds2484();               // Reset pulse
-    I2C_Return = ow_write_byte_ds2484(DS2431_SKIPROM);     // Issue �Skip ROM� command
+    I2C_Return = ow_select_ds2431();                       // Reset pulse and Skip ROM
     I2C_Return = ow_write_byte_ds2484(DS2431_READSCRATCH); // Issue �Read Scratchpad� command
     for (int i = 0; i < Read_Scratchpad_BYTES; i++) // Read 3-byte authorization code, 8-byte data, and 2-byte CRC
     {
-        I2C_Return = ow_read_byte_ds2484();
-        I2C_Return = ow_set_read_pointer_ds2484(DS2484_PTR_CODE_DATA);
-        HAL_Delay(DS2484_DELAY);
-        I2C_Return =
-            HAL_I2C_Master_Receive(DS2484_I2C, DS2484_ADDRESS_READ, &Read_Scratchpad[i], 1, Time_OUT); // read databyte
+        I2C_Return = ow_read_data_ds2484(&Read_Scratchpad[i]); // read databyte
     }
-    HAL_Delay(DS2484_DELAY);
     return I2C_Return;
 }
 
@@ -146,22 +178,16 @@ HAL_StatusTypeDef ow_copy_scratchpad_ds2431(uint8_t Authorization_Code[], uint8_
 
     HAL_StatusTypeDef I2C_Return = HAL_OK;
 
-    I2C_Return = ow_one_wire_reset_ds2484();                  // Reset pulse
-    I2C_Return = ow_write_byte_ds2484(DS2431_SKIPROM);        // Issue �Skip ROM� command
+    I2C_Return = ow_select_ds2431();                          // Reset pulse and Skip ROM
     I2C_Return = ow_write_byte_ds2484(DS2431_COPYSCRATCH);    // Issue �Copy Scratchpad� command
     I2C_Return = ow_write_byte_ds2484(Authorization_Code[0]); // TA1
     I2C_Return = ow_write_byte_ds2484(Authorization_Code[1]); // TA2
     I2C_Return = ow_write_byte_ds2484(Authorization_Code[2]); // E/s
-    HAL_Delay(DS2484_DELAY);
+    HAL_Delay(ds2431_tPROG); // 1-Wire line has to stay idle while the EEPROM is programmed
     for (int i = 0; i < Copy_Scratchpad_BYTES; i++) // Read copy status byte  (AAh = success).
     {
-        I2C_Return = ow_read_byte_ds2484();
-        I2C_Return = ow_set_read_pointer_ds2484(DS2484_PTR_CODE_DATA);
-        HAL_Delay(DS2484_DELAY);
-        I2C_Return =
-            HAL_I2C_Master_Receive(DS2484_I2C, DS2484_ADDRESS_READ, &Copy_Status[i], 1, Time_OUT); // read databyte
+        I2C_Return = ow_read_data_ds2484(&Copy_Status[i]); // read databyte
     }
-    HAL_Delay(DS2484_DELAY);
     return I2C_Return;
 }
 /******************************************************************************
@@ -169,7 +195,8 @@ HAL_StatusTypeDef ow_copy_scratchpad_ds2431(uint8_t Authorization_Code[], uint8_
 **
 ** Created from /on   : @ama / @30.11.2022
 **
-** Description        : @brief This function write 8-byte data starting from a certain memory address.
+** Description        : @brief This function write 8-byte data starting from a certain memory address. The
+*scratchpad is verified by its CRC16 before it is copied, the RAM shadow and the page content are updated on success.
 **
 ** Calling            : @Aus main.c
 ** InputValues        : @param uint16_t MemAddress which is start address of the writing operation
@@ -180,18 +207,39 @@ HAL_StatusTypeDef ow_copy_scratchpad_ds2431(uint8_t Authorization_Code[], uint8_
 HAL_StatusTypeDef ow_write_memory_address_ds2431(uint16_t MemAddress, uint64_t Value) {
 
     HAL_StatusTypeDef I2C_Return = HAL_OK;
+    uint8_t b_overdrive, b_valid;
 
     uint8_t bytes[BYTES_PER_ROW];
     for (int i = 0; i < BYTES_PER_ROW; i++) // Convert from uint64_t to uint8_t
         bytes[i] = *((uint8_t *)&(Value) + i);
     uint8_t Read_CRC[Read_CRC_BYTES];
-    I2C_Return = ow_write_scratchpad_ds2431(MemAddress, &bytes[0], Read_CRC); // Write Scratchpad
     uint8_t Read_Scratchpad[Read_Scratchpad_BYTES];
-    I2C_Return = ow_read_scratchpad_ds2431(Read_Scratchpad); // Read Scratchpad
+    do {
+        b_overdrive = b_ow_overdrive;
+        I2C_Return = ow_write_scratchpad_ds2431(MemAddress, &bytes[0], Read_CRC); // Write Scratchpad
+        I2C_Return = ow_read_scratchpad_ds2431(Read_Scratchpad);                 // Read Scratchpad
+        b_valid = (I2C_Return == HAL_OK) && ow_scratchpad_valid_ds2431(Read_Scratchpad, MemAddress, bytes);
+        if (!b_valid && b_overdrive)
+            ow_overdrive_fallback_ds2431(); // retry at standard speed
+    } while (!b_valid && b_overdrive);
+    if (!b_valid)
+        return HAL_ERROR; // scratchpad is not copied into the EEPROM
+
     uint8_t Authorization_Code[Authorization_Code_BYTES] = {Read_Scratchpad[0], Read_Scratchpad[1],
                                                             Read_Scratchpad[2]}; // TA1, TA2, E/S (Authorization code)
     uint8_t Copy_Status[Copy_Scratchpad_BYTES];
     I2C_Return = ow_copy_scratchpad_ds2431(&Authorization_Code[0], Copy_Status); // Copy Scratchpad
+    if ((I2C_Return == HAL_OK) && (Copy_Status[0] != 0xAA))                      // AAh = success
+        I2C_Return = HAL_ERROR;
+
+    // RAM shadow and page content follow the EEPROM, also for writes by address
+    if (I2C_Return != HAL_OK) {
+        ow_shadow_store_ds2431(MemAddress, NULL, BYTES_PER_ROW);
+    } else {
+        ow_shadow_store_ds2431(MemAddress, bytes, BYTES_PER_ROW);
+        if ((MemAddress < sizeof(ow_shadow)) && ((MemAddress % BYTES_PER_ROW) == 0))
+            memcpy(ow_row_data_ds2431(MemAddress / BYTES_PER_ROW), bytes, BYTES_PER_ROW);
+    }
     return I2C_Return;
 }
 
@@ -200,18 +248,20 @@ HAL_StatusTypeDef ow_write_memory_address_ds2431(uint16_t MemAddress, uint64_t V
 **
 ** Created from /on   : @ama / @30.11.2022
 **
-** Description        : @brief This function reads a certain number of bytes starting from a certain address.
+** Description        : @brief This function reads a certain number of bytes starting from a certain address. One
+*"Read Memory" command is issued, the bytes are streamed from the 1-Wire line without further commands, so the whole
+*memory image (Num_BYTES) can be read in one call.
 **
 ** Calling            : @Aus main.c
 **
 ** InputValues        : @param uint16_t MemAddress which is start address of the reading operation
 **                             uint8_t *ReadMemory which is pointer to an array to which the return value of the read
 *operation is stored
-**                             uint8_t Size which is the number of bytes to be read
+**                             uint16_t Size which is the number of bytes to be read
 **
 ** OutputValues       : @retval I2C_Return which is return stauts for I2C read/write operation.
 ******************************************************************************/
-HAL_StatusTypeDef ow_read_memory_address_ds2431(uint16_t MemAddress, uint8_t *ReadMemory, uint8_t Size) {
+HAL_StatusTypeDef ow_read_memory_address_ds2431(uint16_t MemAddress, uint8_t *ReadMemory, uint16_t Size) {
 
     uint8_t targetAdress[ADDRESS_SIZE_BYTES]; // 0x1234
     for (int i = 0; i < ADDRESS_SIZE_BYTES; i++)
@@ -219,19 +269,15 @@ HAL_StatusTypeDef ow_read_memory_address_ds2431(uint16_t MemAddress, uint8_t *Re
 
     HAL_StatusTypeDef I2C_Return = HAL_OK;
 
-    I2C_Return = ow_one_wire_reset_ds2484();            // Reset Pulse
-    I2C_Return = ow_write_byte_ds2484(DS2431_SKIPROM);  // Issue �Skip ROM� command
+    I2C_Return = ow_select_ds2431(); // Reset pulse and Skip ROM
+    if (I2C_Return != HAL_OK)
+        return I2C_Return;
     I2C_Return = ow_write_byte_ds2484(DS2431_READMEM);  // Issue �Read Memory� command
     I2C_Return = ow_write_byte_ds2484(targetAdress[0]); // TA1
     I2C_Return = ow_write_byte_ds2484(targetAdress[1]); // TA2
-    for (int i = 0; i < Size; i++)                      // Read bytes from memory
-    {
-        I2C_Return = ow_read_byte_ds2484();
-        I2C_Return = ow_set_read_pointer_ds2484(DS2484_PTR_CODE_DATA);
-        HAL_Delay(DS2484_DELAY);
-        I2C_Return =
-            HAL_I2C_Master_Receive(DS2484_I2C, DS2484_ADDRESS_READ, &ReadMemory[i], 1, Time_OUT); // read databyte
-    }
+    if (I2C_Return != HAL_OK)
+        return I2C_Return;
+    I2C_Return = ow_read_block_ds2484(ReadMemory, Size); // Read bytes from memory
     return I2C_Return;
 }
 
@@ -289,7 +335,8 @@ HAL_StatusTypeDef ow_read_memory_row_ds2431(uint8_t row, uint64_t *ReadRow) {
 **
 ** Created from /on   : @ama / @30.11.2022
 **
-** Description        : @brief This function clears the entire epprom by writing 0x00 in all memory addresses.
+** Description        : @brief This function clears a page or the entire epprom by writing 0x00 in all memory
+*addresses. Rows which are already cleared according to the RAM shadow are not written again.
 **
 ** Calling            : @Aus main.c
 **
@@ -300,79 +347,31 @@ HAL_StatusTypeDef ow_read_memory_row_ds2431(uint8_t row, uint64_t *ReadRow) {
 uint8_t ow_clear_memory_ds2431(owPage localpage) {
     HAL_StatusTypeDef I2C_Return = HAL_OK;
     uint16_t MemAddress;
-    uint8_t bytes[BYTES_PER_ROW], start, end, i, returntype; // 8-byte clear bytes
+    uint64_t Value; // 8-byte clear bytes
+    uint8_t returntype;
 
     if (ds2431connectstatus == ChipOff) {
         returntype = CMD_BKCTEST_FAIL;
         return returntype;
     }
 
-    for (int i = 0; i < BYTES_PER_ROW; i++)
-        bytes[i] = CLEAR_BYTE;
-
-    if (localpage == Page1) {
-        st_OwParamPage1.TEST = 0x0000;
-        st_OwParamPage1.OwnVERSION = 0x0000;
-        st_OwParamPage1.dummy1 = 0x0000;
-        st_OwParamPage1.dummy2 = 0x0000;
-        for (i = 0; i < 6; i++)
-            st_OwParamPage1.Reserved1[i] = 0x0000;
-
-        MemAddress = 0x0000; // Page Numbering (1-17)
-        start = 0;
-        end = 4;
-    } else if (localpage == Page2) {
-        MemAddress = 0x0020; // Page Numbering (1-17)
-        start = 4;
-        end = 8;
-        st_OwParamPage2.Weldtime[0] = 0x00000000;
-        st_OwParamPage2.Weldtime[1] = 0x00000000;
-        for (i = 0; i < 6; i++)
-            st_OwParamPage2.Reserved2[i] = 0x0000;
-
-    } else if (localpage == Page3) {
-        MemAddress = 0x0040; // Page Numbering (1-17)
-        start = 8;
-        end = 12;
-        st_OwParamPage3.Writterflag = 0x00000000;
-        st_OwParamPage3.TorchType = 0x00000000;
-        for (i = 0; i < 6; i++)
-            st_OwParamPage3.Reserved3[i] = 0x0000;
-    } else if (localpage == Page4) {
-        MemAddress = 0x0060; // Page Numbering (1-17)
-        start = 12;
-        end = 16;
-        for (i = 0; i < 8; i++)
-            st_OwParamPage4.Reserved4[i] = 0x0000;
-
-    } else if (localpage == PageAll) {
-        MemAddress = 0x0000; // Page Numbering (1-17)
-        start = 0;
-        end = NUM_PAGES;
-    }
-
-    //
-    for (i = start; i < end; i++) // Iterate over memory pages
-    {
-        uint8_t Read_CRC[2];
-        I2C_Return = ow_write_scratchpad_ds2431(MemAddress, &bytes[0], Read_CRC); // Write scratchpad
-        uint8_t Read_Scratchpad[13];
-        I2C_Return = ow_read_scratchpad_ds2431(Read_Scratchpad); // Read scratchpad
-        uint8_t Authorization_Code[3] = {Read_Scratchpad[0], Read_Scratchpad[1], Read_Scratchpad[2]};
-        uint8_t Copy_Status[1];
-        I2C_Return = ow_copy_scratchpad_ds2431(&Authorization_Code[0], Copy_Status); // Copy scratchpad
-        MemAddress += (SEG_SIZE_HEX);
-    }
-    if (I2C_Return == HAL_OK) {
-        returntype = CMD_BKCTEST_PASS; // clear success
-        return returntype;
+    if (localpage == PageAll) {
+        for (owPage clearpage = Page1; clearpage <= Page4; clearpage++)
+            memset(ow_page_data_ds2431(clearpage), CLEAR_BYTE, BYTES_PER_PAGE);
+        I2C_Return = owParamPage_flush_ds2431(OW_ROWS_ALL);
+
+        // rows behind the parameter pages are not part of the RAM shadow
+        memset(&Value, CLEAR_BYTE, sizeof(Value));
+        for (MemAddress = sizeof(ow_shadow); (MemAddress < (NUM_PAGES * BYTES_PER_ROW)) && (I2C_Return == HAL_OK);
+             MemAddress += SEG_SIZE_HEX)
+            I2C_Return = ow_write_memory_address_ds2431(MemAddress, Value);
+    } else if (ow_page_data_ds2431(localpage) != NULL) {
+        memset(ow_page_data_ds2431(localpage), CLEAR_BYTE, BYTES_PER_PAGE);
+        I2C_Return = owParamPage_flush_ds2431(OW_PAGE_ROWS(localpage)); // only rows not cleared yet are written
     } else {
-        returntype = CMD_BKCTEST_FAIL; // clear fail
-        return returntype;
+        I2C_Return = HAL_ERROR;
     }
 
-    I2C_Return = owParamPage_init_ds2431(); // read all eeprom member element
-
     if (I2C_Return == HAL_OK) {
         returntype = CMD_BKCTEST_PASS; // clear success
     } else {
@@ -397,32 +396,14 @@ uint8_t ow_clear_memory_ds2431(owPage localpage) {
 HAL_StatusTypeDef ow_read_all_memory_ds2431(uint64_t *ReadAllMemory) {
     HAL_StatusTypeDef I2C_Return = HAL_OK;
 
-    uint16_t MemAddress = BASE_ADDRESS;       // Memory Base address
-    uint8_t targetAdress[ADDRESS_SIZE_BYTES]; // 0x1234
-    uint8_t ReadMemory[BYTES_PER_ROW];
+    uint8_t ReadMemory[NUM_PAGES * BYTES_PER_ROW];
     uint64_t temp = 0ULL;
+
+    I2C_Return = ow_read_memory_address_ds2431(BASE_ADDRESS, ReadMemory, sizeof(ReadMemory)); // Read all rows at once
     for (int j = 0; j < NUM_PAGES; j++) // Iterate over the entire memory pages
     {
-        MemAddress = SEG_SIZE_HEX * j;
-
-        for (int i = 0; i < ADDRESS_SIZE_BYTES; i++)
-            targetAdress[i] = *((uint8_t *)&(MemAddress) + i); // TA1  (0x34) //TA2  (0x12)
-
-        I2C_Return = ow_one_wire_reset_ds2484();            // Reset Pulse
-        I2C_Return = ow_write_byte_ds2484(DS2431_SKIPROM);  // Issue �Skip ROM� command
-        I2C_Return = ow_write_byte_ds2484(DS2431_READMEM);  // Issue �Read Memory� command
-        I2C_Return = ow_write_byte_ds2484(targetAdress[0]); // TA1
-        I2C_Return = ow_write_byte_ds2484(targetAdress[1]); // TA2
-        for (int i = 0; i < BYTES_PER_ROW; i++)             // Read one memory page
-        {
-            I2C_Return = ow_read_byte_ds2484();
-            I2C_Return = ow_set_read_pointer_ds2484(DS2484_PTR_CODE_DATA);
-            HAL_Delay(DS2484_DELAY);
-            I2C_Return =
-                HAL_I2C_Master_Receive(DS2484_I2C, DS2484_ADDRESS_READ, &ReadMemory[i], 1, Time_OUT); // read databyte
-        }
         for (int i = (SEG_SIZE_BITS - 1); i >= 0; --i) // Convert from uint8_t to uint64_t
-            temp = (temp << SEG_SIZE_BITS) | ReadMemory[i];
+            temp = (temp << SEG_SIZE_BITS) | ReadMemory[(j * BYTES_PER_ROW) + i];
         ReadAllMemory[j] = temp;
     }
     return I2C_Return;
@@ -501,7 +482,7 @@ HAL_StatusTypeDef ow_read_mem_row_ds2431_offset(owPage localpage, uint8_t *ReadM
 HAL_StatusTypeDef ow_read_ROMID_ds2431(void) {
 
     HAL_StatusTypeDef I2C_Return = HAL_OK;
-    uint8_t Read_Scratchpad[8], offcount;
+    uint8_t Read_Scratchpad[8];
     uint64_t sentdata1, sentdata2;
 
     for (int ii = 0; ii < 8; ii++)
@@ -509,21 +490,13 @@ HAL_StatusTypeDef ow_read_ROMID_ds2431(void) {
 
     sentdata1 = 0;
     sentdata2 = 0;
-    offcount = 0;
 
-    I2C_Return = ow_one_wire_reset_ds2484(); // Reset pulse
-    HAL_Delay(100);
+    I2C_Return = ow_set_speed_ds2484(0);               // ROM ID is read at standard speed
+    I2C_Return = ow_one_wire_reset_ds2484();           // Reset pulse
     I2C_Return = ow_write_byte_ds2484(DS2431_READROM); // Issue �Read Memory� command
-    HAL_Delay(200);
-
-    for (int j = 0; j < 8; j++) {
-        ow_read_byte_ds2484();
-        HAL_Delay(DS2484_DELAY);
-        ow_set_read_pointer_ds2484(0xE1);
-        HAL_Delay(DS2484_DELAY);
-        I2C_Return = HAL_I2C_Master_Receive(DS2484_I2C, DS2484_ADDRESS_READ, &Read_Scratchpad[j], 1, Time_OUT);
-        HAL_Delay(DS2484_DELAY);
-    }
+
+    for (int j = 0; j < 8; j++)
+        I2C_Return = ow_read_data_ds2484(&Read_Scratchpad[j]);
 
     if (I2C_Return == HAL_OK) {
         sentdata1 = Read_Scratchpad[0] | Read_Scratchpad[1] << 8 | Read_Scratchpad[2] << 16 | Read_Scratchpad[3] << 24;
@@ -532,13 +505,14 @@ HAL_StatusTypeDef ow_read_ROMID_ds2431(void) {
         ds2431ROMid += sentdata1;
     }
 
-    for (int ii = 0; ii < 8; ii++) {
-        if (Read_Scratchpad[ii] == 0xff)
-            offcount++;
-    }
-
-    if (offcount >= 6)
+    // a single device answers READ ROM, with more devices the ROM IDs collide and the CRC8 fails
+    if ((I2C_Return == HAL_OK) && !ow_rom_valid_ds2431(Read_Scratchpad))
         I2C_Return = HAL_ERROR;
+    if (I2C_Return == HAL_OK) {
+        memcpy(ow_rom_ids[0], Read_Scratchpad, OW_ROM_BYTES);
+        ow_rom_count = 1;
+        ow_rom_set_target_ds2431(0);
+    }
 
     return I2C_Return;
 }
@@ -573,7 +547,8 @@ void ow_split_ROMID_ds2431(uint8_t *idslitbufer) {
 ** Created from /on   : @spa / @23.02.2024
 **
 ** Description        : @brief This function read the page - 32 bytes(4 rows)
-**                             Each row is 8 byte in size.
+**                             Each row is 8 byte in size, the page is read with one "Read Memory" command.
+**                             The page content and the RAM shadow are updated only on success.
 ** InputValues        : @param uint8_t page - page no: 1 or 2 or 3 or 4
 **                             read the entire page
 **
@@ -582,29 +557,18 @@ void ow_split_ROMID_ds2431(uint8_t *idslitbufer) {
 
 HAL_StatusTypeDef owParamPage_read_ds2431(owPage localpage) {
     HAL_StatusTypeDef I2C_Return = HAL_OK;
-    uint8_t *ptrDataRead, i, ii, offset;
-    uint8_t ReadMemoryPage[BYTES_PER_ROW];
+    uint8_t *ptrDataRead = ow_page_data_ds2431(localpage);
+    uint8_t ReadMemory[BYTES_PER_PAGE];
 
-    if (localpage == Page1)
-        ptrDataRead = (uint8_t *)&st_OwParamPage1;
-    else if (localpage == Page2)
-        ptrDataRead = (uint8_t *)&st_OwParamPage2;
-    else if (localpage == Page3)
-        ptrDataRead = (uint8_t *)&st_OwParamPage3;
-    else if (localpage == Page4)
-        ptrDataRead = (uint8_t *)&st_OwParamPage4;
-
-    for (i = 0; i < 4; i++) {
-        for (ii = 0; ii < 8; ii++)
-            ReadMemoryPage[ii] = 0;
-        offset = (i * 8);
-        I2C_Return = ow_read_mem_row_ds2431_offset(localpage, &ReadMemoryPage[0], offset);
-        if (I2C_Return == HAL_ERROR)
-            return I2C_Return;
-        for (ii = 0; ii < 8; ii++)
-            *ptrDataRead++ = ReadMemoryPage[ii];
-    }
+    if (ptrDataRead == NULL)
+        return HAL_ERROR;
+
+    I2C_Return = ow_read_memory_address_ds2431(ow_page_address_ds2431(localpage), ReadMemory, sizeof(ReadMemory));
+    if (I2C_Return != HAL_OK)
+        return I2C_Return; // page content is kept
 
+    memcpy(ptrDataRead, ReadMemory, BYTES_PER_PAGE);
+    ow_shadow_store_ds2431(ow_page_address_ds2431(localpage), ReadMemory, BYTES_PER_PAGE);
     return I2C_Return;
 }
 
@@ -613,7 +577,7 @@ HAL_StatusTypeDef owParamPage_read_ds2431(owPage localpage) {
 **
 ** Created from /on   : @spa / @23.02.2024
 **
-** Description        : @brief This function read all the pages.
+** Description        : @brief This function read all the pages with one "Read Memory" command.
 **                             No. of pages = 4
 **                             No. of bytes per page = 32
 **                             No. of rows per page = 4
@@ -625,24 +589,158 @@ HAL_StatusTypeDef owParamPage_read_ds2431(owPage localpage) {
 ******************************************************************************/
 HAL_StatusTypeDef owParamPage_init_ds2431(void) {
     HAL_StatusTypeDef I2C_Return = HAL_OK;
+    uint8_t ReadMemory[NUM_PARAM_PAGES * BYTES_PER_PAGE];
 
-    // pagesied read from eeprom and initialized
-    I2C_Return = owParamPage_read_ds2431(Page1);
-    if (I2C_Return != HAL_OK)
-        return I2C_Return;
-    I2C_Return = owParamPage_read_ds2431(Page2);
-    if (I2C_Return != HAL_OK)
-        return I2C_Return;
-    I2C_Return = owParamPage_read_ds2431(Page3);
-    if (I2C_Return != HAL_OK)
-        return I2C_Return;
-    I2C_Return = owParamPage_read_ds2431(Page4);
+    // all pages read from eeprom at once and initialized
+    I2C_Return = ow_read_memory_address_ds2431(BASE_ADDRESS, ReadMemory, sizeof(ReadMemory));
     if (I2C_Return != HAL_OK)
         return I2C_Return;
 
+    owParamPage_set_ds2431(ReadMemory);
+    return I2C_Return;
+}
+
+/******************************************************************************
+** Name               : @fn owParamPage_set_ds2431
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function initializes the page content structures and the RAM shadow from a
+**                             memory image of the parameter pages, as read from address 0x0000.
+** InputValues        : @param const uint8_t *p_image - NUM_PARAM_PAGES * BYTES_PER_PAGE bytes
+**
+** OutputValues       : @retval none
+******************************************************************************/
+void owParamPage_set_ds2431(const uint8_t *p_image) {
+    for (owPage localpage = Page1; localpage <= Page4; localpage++)
+        memcpy(ow_page_data_ds2431(localpage), &p_image[ow_page_address_ds2431(localpage)], BYTES_PER_PAGE);
+    ow_shadow_store_ds2431(BASE_ADDRESS, p_image, sizeof(ow_shadow));
+
     if (st_OwParamPage3.TorchType == undef)
         enumTorchType = u300G;
+}
+
+/******************************************************************************
+** Name               : @fn ow_page_data_ds2431
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function returns the page content structure of a page.
+** InputValues        : @param uint8_t page - page no: 1 or 2 or 3 or 4
+**
+** OutputValues       : @retval pointer to the page content structure, NULL for an invalid page.
+******************************************************************************/
+static uint8_t *ow_page_data_ds2431(owPage localpage) {
+    if (localpage == Page1)
+        return (uint8_t *)&st_OwParamPage1;
+    else if (localpage == Page2)
+        return (uint8_t *)&st_OwParamPage2;
+    else if (localpage == Page3)
+        return (uint8_t *)&st_OwParamPage3;
+    else if (localpage == Page4)
+        return (uint8_t *)&st_OwParamPage4;
+    return NULL;
+}
+
+/******************************************************************************
+** Name               : @fn ow_page_address_ds2431
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function returns the EEPROM address of a page.
+** InputValues        : @param uint8_t page - page no: 1 or 2 or 3 or 4
+**
+** OutputValues       : @retval address of the first byte of the page.
+******************************************************************************/
+static uint16_t ow_page_address_ds2431(owPage localpage) {
+    return BASE_ADDRESS + ((localpage - Page1) * BYTES_PER_PAGE); // Page Numbering (1-17)
+}
+
+/******************************************************************************
+** Name               : @fn ow_row_data_ds2431
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function returns the page content of a row of the parameter pages.
+** InputValues        : @param uint8_t row - 0..NUM_PARAM_ROWS-1
+**
+** OutputValues       : @retval pointer to the 8 bytes of the row in the page content structure.
+******************************************************************************/
+static uint8_t *ow_row_data_ds2431(uint8_t row) {
+    return ow_page_data_ds2431((owPage)(Page1 + (row / ROWS_PER_PAGE))) + ((row % ROWS_PER_PAGE) * BYTES_PER_ROW);
+}
+
+/******************************************************************************
+** Name               : @fn ow_shadow_store_ds2431
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function takes over bytes read from or written to the EEPROM into the RAM
+**                             shadow. Addresses behind the parameter pages are ignored, rows which are not
+**                             completely known are marked as unknown.
+** InputValues        : @param uint16_t MemAddress which is the start address
+**                             const uint8_t *p_bytes which are the bytes, NULL if the content is unknown
+**                             uint16_t Size which is the number of bytes
+**
+** OutputValues       : @retval none
+******************************************************************************/
+static void ow_shadow_store_ds2431(uint16_t MemAddress, const uint8_t *p_bytes, uint16_t Size) {
+    uint16_t rows = 0;
+
+    for (uint16_t i = 0; (i < Size) && ((MemAddress + i) < sizeof(ow_shadow)); i++) {
+        rows |= OW_ROW_MASK(MemAddress + i);
+        if (p_bytes != NULL)
+            ow_shadow[MemAddress + i] = p_bytes[i];
+    }
+    if ((p_bytes == NULL) || (MemAddress % BYTES_PER_ROW) || (Size % BYTES_PER_ROW))
+        ow_shadow_unknown |= rows;
+    else
+        ow_shadow_unknown &= ~rows;
+}
 
+/******************************************************************************
+** Name               : @fn owParamPage_dirty_ds2431
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function compares the page content structures with the RAM shadow.
+** InputValues        : @param Nil
+**
+** OutputValues       : @retval rows to be written, bit n = row n of the parameter pages.
+******************************************************************************/
+uint16_t owParamPage_dirty_ds2431(void) {
+    uint16_t rows = ow_shadow_unknown;
+
+    for (uint8_t row = 0; row < NUM_PARAM_ROWS; row++) {
+        if (memcmp(ow_row_data_ds2431(row), &ow_shadow[row * BYTES_PER_ROW], BYTES_PER_ROW) != 0)
+            rows |= OW_ROW_MASK(row * BYTES_PER_ROW);
+    }
+    return rows;
+}
+
+/******************************************************************************
+** Name               : @fn owParamPage_flush_ds2431
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function writes the dirty rows of the page content structures. Each row is
+**                             verified by the CRC16 of the scratchpad and the copy status, the pages are not read
+**                             back.
+** InputValues        : @param uint16_t rows - rows to be written if dirty, e.g. OW_PAGE_ROWS(Page3)
+**
+** OutputValues       : @retval I2C_Return HAL_StatusTypeDef.
+******************************************************************************/
+HAL_StatusTypeDef owParamPage_flush_ds2431(uint16_t rows) {
+    HAL_StatusTypeDef I2C_Return = HAL_OK;
+    uint64_t Value;
+
+    rows &= owParamPage_dirty_ds2431();
+    for (uint8_t row = 0; (row < NUM_PARAM_ROWS) && (I2C_Return == HAL_OK); row++) {
+        if (rows & OW_ROW_MASK(row * BYTES_PER_ROW)) {
+            memcpy(&Value, ow_row_data_ds2431(row), BYTES_PER_ROW);
+            I2C_Return = ow_write_memory_address_ds2431(BASE_ADDRESS + (row * BYTES_PER_ROW), Value);
+        }
+    }
     return I2C_Return;
 }
 
@@ -652,40 +750,18 @@ HAL_StatusTypeDef owParamPage_init_ds2431(void) {
 ** Created from /on   : @spa / @23.02.2024
 **
 ** Description        : @brief This function writes the page - 32 bytes(4 rows)
-**                             Each row is 8 byte in size.
+**                             Each row is 8 byte in size, only the rows changed since the
+**                             last read or write are written.
 ** InputValues        : @param uint8_t page - page no: 1 or 2 or 3 or 4
-**                             read the entire page
 **
 ** OutputValues       : @retval I2C_Return HAL_StatusTypeDef.
 ******************************************************************************/
 
 HAL_StatusTypeDef owParamPage_write_ds2431(owPage localpage) {
-    HAL_StatusTypeDef I2C_Return = HAL_OK;
-    uint8_t *ptrDataWrite, i, ii, offset, localarr[8];
-    uint64_t sentdata1, sentdata2;
-    uint64_t sentdata;
-
-    if (localpage == Page1)
-        ptrDataWrite = (uint8_t *)&st_OwParamPage1;
-    else if (localpage == Page2)
-        ptrDataWrite = (uint8_t *)&st_OwParamPage2;
-    else if (localpage == Page3)
-        ptrDataWrite = (uint8_t *)&st_OwParamPage3;
-    else if (localpage == Page4)
-        ptrDataWrite = (uint8_t *)&st_OwParamPage4;
-
-    for (i = 0; i < 4; i++) {
-        for (ii = 0; ii < 8; ii++)
-            localarr[ii] = *ptrDataWrite++;
-        sentdata1 = localarr[0] | localarr[1] << 8 | localarr[2] << 16 | localarr[3] << 24;
-        sentdata2 = localarr[4] | localarr[5] << 8 | localarr[6] << 16 | localarr[7] << 24;
-        sentdata = sentdata2 << 32;
-        sentdata |= sentdata1;
-        offset = (i * 8);
-        I2C_Return = ow_write_mem_row_ds2431_offset(localpage, sentdata, offset);
-    }
+    if (ow_page_data_ds2431(localpage) == NULL)
+        return HAL_ERROR;
 
-    return I2C_Return;
+    return owParamPage_flush_ds2431(OW_PAGE_ROWS(localpage));
 }
 
 /******************************************************************************
@@ -695,19 +771,17 @@ HAL_StatusTypeDef owParamPage_write_ds2431(owPage localpage) {
 **
 ** Description        : @brief This function verifies the eeprom full memory.
 **                             total eeprom = 128 bytes( 4 pages )
-**                              write known values to eeprom, read back
-**                              and verify the content.
+**                              write known values to eeprom, each row
+**                              is verified by the CRC16 of the scratchpad.
 ** InputValues        : @param Nil
 **
 ** OutputValues       : @retval I2C_Return HAL_StatusTypeDef.
 ******************************************************************************/
 HAL_StatusTypeDef ow_param_Verify_ds2431(void) {
-    uint8_t ii;
     HAL_StatusTypeDef I2C_Return = HAL_OK;
 
-    I2C_Return = ow_clear_memory_ds2431(PageAll);
-    if (I2C_Return != HAL_OK)
-        return I2C_Return;
+    if (ow_clear_memory_ds2431(PageAll) != CMD_BKCTEST_PASS)
+        return HAL_ERROR;
 
     st_OwParamPage1.TEST = 0x1234;       // for Testing of BKC
     st_OwParamPage1.OwnVERSION = 0x5678; // assinging dummy variables
@@ -747,86 +821,13 @@ HAL_StatusTypeDef ow_param_Verify_ds2431(void) {
     st_OwParamPage4.Reserved4[6] = 0x4496;
     st_OwParamPage4.Reserved4[7] = 0x4497;
 
-    I2C_Return = owParamPage_write_ds2431(Page1);
-    if (I2C_Return != HAL_OK)
-        return I2C_Return;
-    I2C_Return = owParamPage_write_ds2431(Page2);
-    if (I2C_Return != HAL_OK)
-        return I2C_Return;
-    I2C_Return = owParamPage_write_ds2431(Page3);
-    if (I2C_Return != HAL_OK)
-        return I2C_Return;
-    I2C_Return = owParamPage_write_ds2431(Page4);
-    if (I2C_Return != HAL_OK)
-        return I2C_Return;
-
-    HAL_Delay(DS2484_DELAY * 100);
-
-    st_OwParamPage1.TEST = 0x0000;
-    st_OwParamPage1.OwnVERSION = 0x0000;
-    st_OwParamPage1.dummy1 = 0x0000;
-    st_OwParamPage1.dummy2 = 0x0000;
-    for (ii = 0; ii < 6; ii++)
-        st_OwParamPage1.Reserved1[ii] = 0x0000;
-
-    st_OwParamPage2.Weldtime[0] = 0x00000000;
-    st_OwParamPage2.Weldtime[1] = 0x00000000;
-    for (ii = 0; ii < 6; ii++)
-        st_OwParamPage2.Reserved2[ii] = 0x0000;
-
-    st_OwParamPage3.Writterflag = 0x00000000;
-    st_OwParamPage3.TorchType = 0x00000000;
-    for (ii = 0; ii < 6; ii++)
-        st_OwParamPage3.Reserved3[ii] = 0x0000;
-
-    for (ii = 0; ii < 8; ii++)
-        st_OwParamPage4.Reserved4[ii] = 0x0000;
-
-    // I2C_Return = owParamPage_int_ds2431();
-
-    I2C_Return = owParamPage_read_ds2431(Page1);
-    if (I2C_Return != HAL_OK)
-        return I2C_Return;
-    I2C_Return = owParamPage_read_ds2431(Page2);
-    if (I2C_Return != HAL_OK)
-        return I2C_Return;
-    I2C_Return = owParamPage_read_ds2431(Page3);
+    // each row is verified by the CRC16 of the scratchpad and the copy status
+    I2C_Return = owParamPage_flush_ds2431(OW_ROWS_ALL);
     if (I2C_Return != HAL_OK)
         return I2C_Return;
-    I2C_Return = owParamPage_read_ds2431(Page4);
-    if (I2C_Return != HAL_OK)
-        return I2C_Return;
-
-    if (st_OwParamPage1.TEST != 0x1234 || st_OwParamPage1.Reserved1[0] != 0x1190 ||
-        st_OwParamPage1.OwnVERSION != 0x5678 || st_OwParamPage1.Reserved1[1] != 0x1191 ||
-        st_OwParamPage1.dummy1 != 0x5a5a || st_OwParamPage1.Reserved1[2] != 0x1192 ||
-        st_OwParamPage1.dummy2 != 0x1122 || st_OwParamPage1.Reserved1[3] != 0x1193 ||
-        st_OwParamPage1.Reserved1[4] != 0x1194 || st_OwParamPage1.Reserved1[5] != 0x1195) {
-        I2C_Return = HAL_ERROR;
-        return I2C_Return;
-    }
-    if (st_OwParamPage2.Weldtime[0] != 0x27654321 || st_OwParamPage2.Reserved2[0] != 0x2290 ||
-        st_OwParamPage2.Weldtime[1] != 0x37373737 || st_OwParamPage2.Reserved2[1] != 0x2291 ||
-        st_OwParamPage2.Reserved2[2] != 0x2292 || st_OwParamPage2.Reserved2[3] != 0x2293 ||
-        st_OwParamPage2.Reserved2[4] != 0x2294 || st_OwParamPage2.Reserved2[5] != 0x2295) {
-        I2C_Return = HAL_ERROR;
-        return I2C_Return;
-    }
-    if (st_OwParamPage3.Writterflag != 0x33443344 || st_OwParamPage3.Reserved3[0] != 0x3390 ||
-        st_OwParamPage3.TorchType != 0x55667788 || st_OwParamPage3.Reserved3[1] != 0x3391 ||
-        st_OwParamPage3.Reserved3[2] != 0x3392 || st_OwParamPage3.Reserved3[3] != 0x3393 ||
-        st_OwParamPage3.Reserved3[4] != 0x3394 || st_OwParamPage3.Reserved3[5] != 0x3395) {
-        I2C_Return = HAL_ERROR;
-        return I2C_Return;
-    }
 
-    if (st_OwParamPage4.Reserved4[0] != 0x4490 || st_OwParamPage4.Reserved4[1] != 0x4491 ||
-        st_OwParamPage4.Reserved4[2] != 0x4492 || st_OwParamPage4.Reserved4[3] != 0x4493 ||
-        st_OwParamPage4.Reserved4[4] != 0x4494 || st_OwParamPage4.Reserved4[5] != 0x4495 ||
-        st_OwParamPage4.Reserved4[6] != 0x4496 || st_OwParamPage4.Reserved4[7] != 0x4497) {
+    if (owParamPage_dirty_ds2431() != 0)
         I2C_Return = HAL_ERROR;
-        return I2C_Return;
-    }
     return I2C_Return;
 }
 
@@ -873,7 +874,7 @@ uint8_t ow_Write_TorchType(uint32_t enumTorchType) {
 ** Created from /on   : @spa / @23.02.2024
 **
 ** Description        : @brief This function read the torch type parameter
-**                             from eeprom
+**                             from eeprom, if the page is not known yet
 ** InputValues        : @param TorchType enumTorchType
 **
 ** OutputValues       : @retval I2C_Return HAL_StatusTypeDef.
@@ -886,7 +887,8 @@ uint8_t ow_read_TorchType(uint32_t *enumTorchType) {
         returntype = CMD_BKCTEST_FAIL;
         return returntype;
     }
-    I2C_Return = owParamPage_read_ds2431(Page3);
+    if (ow_shadow_unknown & OW_PAGE_ROWS(Page3)) // otherwise taken from the RAM shadow
+        I2C_Return = owParamPage_read_ds2431(Page3);
     *enumTorchType = st_OwParamPage3.TorchType;
 
     if (I2C_Return == HAL_OK)
@@ -925,7 +927,6 @@ uint8_t ow_BKCTest(void) {
         returntype = CMD_BKCTEST_FAIL;
         return returntype;
     }
-    HAL_Delay(DS2484_DELAY * 10);
 
     st_OwParamPage4.Reserved4[0] = 0x4400;
     st_OwParamPage4.Reserved4[1] = 0x4401;
@@ -941,7 +942,6 @@ uint8_t ow_BKCTest(void) {
         returntype = CMD_BKCTEST_FAIL;
         return returntype;
     }
-    HAL_Delay(DS2484_DELAY * 10);
 
     for (ii = 0; ii < 8; ii++)
         st_OwParamPage4.Reserved4[ii] = 0x0000;
@@ -958,3 +958,660 @@ uint8_t ow_BKCTest(void) {
     }
     return returntype;
 }
+
+/******************************************************************************
+** Name               : @fn ow_select_ds2431
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function selects the ds2431 for the following command. The reset pulse is always
+**                             sent at standard speed, which brings the ds2431 back to standard speed. With
+**                             overdrive the "Overdrive Skip ROM" command follows and the DS2484 is switched to
+**                             overdrive for the rest of the transaction, otherwise the "Skip ROM" command.
+**                             If ow_search_rom_ds2431() found more devices, the ds2431 is addressed by its ROM ID.
+** InputValues        : @param Nil
+**
+** OutputValues       : @retval I2C_Return HAL_StatusTypeDef.
+******************************************************************************/
+HAL_StatusTypeDef ow_select_ds2431(void) {
+    HAL_StatusTypeDef I2C_Return = HAL_OK;
+
+    if (ow_rom_count > 1)
+        return ow_select_rom_ds2431(ow_rom_target); // more devices on the bus
+
+    I2C_Return = ow_set_speed_ds2484(0);
+    if (I2C_Return != HAL_OK)
+        return I2C_Return;
+    I2C_Return = ow_one_wire_reset_ds2484(); // Reset pulse
+    if (I2C_Return != HAL_OK)
+        return I2C_Return;
+
+    if (!b_ow_overdrive)
+        return ow_write_byte_ds2484(DS2431_SKIPROM); // Issue "Skip ROM" command
+
+    I2C_Return = ow_write_byte_ds2484(DS2431_OVERDRIVESKIP); // Issue "Overdrive Skip ROM" command
+    if (I2C_Return == HAL_OK)
+        I2C_Return = ow_set_speed_ds2484(1);
+    return I2C_Return;
+}
+
+/******************************************************************************
+** Name               : @fn ow_overdrive_fallback_ds2431
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function falls back to standard speed for the rest of the power cycle, called on
+**                             a CRC failure. The next ow_select_ds2431() switches the bus back to standard speed and
+**                             addresses the ds2431 by MATCH ROM instead of RESUME.
+** InputValues        : @param Nil
+**
+** OutputValues       : @retval 1 if overdrive was used before, 0 if the bus was at standard speed already.
+******************************************************************************/
+uint8_t ow_overdrive_fallback_ds2431(void) {
+    uint8_t b_overdrive = b_ow_overdrive;
+
+    b_ow_overdrive = 0;
+    ow_rom_resume = OW_ROM_MAX; // the failed transaction may have lost the RESUME flag
+    return b_overdrive;
+}
+
+/******************************************************************************
+** Name               : @fn ow_crc16_ds2431
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function calculates the CRC16 (polynomial 0x8005, reflected) as used by the
+**                             ds2431. The ds2431 sends the inverted CRC16.
+** InputValues        : @param uint16_t crc which is the CRC16 of the data before, 0 for the start
+**                             const uint8_t *p_data which is the data
+**                             uint16_t length which is the number of bytes
+**
+** OutputValues       : @retval uint16_t CRC16.
+******************************************************************************/
+uint16_t ow_crc16_ds2431(uint16_t crc, const uint8_t *p_data, uint16_t length) {
+    while (length--) {
+        crc ^= *p_data++;
+        for (uint8_t i = 0; i < 8; i++)
+            crc = (crc & 1) ? ((crc >> 1) ^ 0xA001) : (crc >> 1);
+    }
+    return crc;
+}
+
+/******************************************************************************
+** Name               : @fn ow_scratchpad_valid_ds2431
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function checks the scratchpad read back before it is copied into the EEPROM:
+**                             CRC16, target address, complete row without partial flag and data.
+** InputValues        : @param const uint8_t *p_scratch which is the read scratchpad (TA1, TA2, E/S, data, CRC16)
+**                             uint16_t MemAddress which is the address written
+**                             const uint8_t *p_bytes which is the 8-byte data written
+**
+** OutputValues       : @retval 1 if valid, 0 if not.
+******************************************************************************/
+static uint8_t ow_scratchpad_valid_ds2431(const uint8_t *p_scratch, uint16_t MemAddress, const uint8_t *p_bytes) {
+    uint8_t command = DS2431_READSCRATCH;
+    uint16_t crc;
+
+    crc = ow_crc16_ds2431(0, &command, 1);
+    crc = ow_crc16_ds2431(crc, p_scratch, Read_Scratchpad_BYTES - Read_CRC_BYTES);
+    if ((uint16_t)~crc != (p_scratch[Read_Scratchpad_BYTES - 2] | (p_scratch[Read_Scratchpad_BYTES - 1] << 8)))
+        return 0;
+    if ((p_scratch[0] != (uint8_t)MemAddress) || (p_scratch[1] != (uint8_t)(MemAddress >> 8)))
+        return 0;
+    if ((p_scratch[2] & 0x27) != 0x07) // E/S: PF clear, ending offset 7
+        return 0;
+    return (memcmp(&p_scratch[Authorization_Code_BYTES], p_bytes, BYTES_PER_ROW) == 0);
+}
+
+/******************************************************************************
+** Name               : @fn ow_async_select
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function adds the operations of ow_select_ds2431() to a script, at most 5.
+** InputValues        : @param ow_op_t *p_ops which is the script
+**
+** OutputValues       : @retval number of operations added.
+******************************************************************************/
+static uint8_t ow_async_select(ow_op_t *p_ops) {
+    uint8_t num_ops = 0;
+
+    if ((ow_rom_count > 1) && (ow_rom_target < ow_rom_count)) {
+        // more devices on the bus, MATCH ROM or RESUME as in ow_select_rom_ds2431()
+        p_ops[num_ops++] = (ow_op_t){OW_OP_SPEED, NULL, 0};
+        p_ops[num_ops++] = (ow_op_t){OW_OP_RESET, NULL, 0};
+        if (!b_ow_overdrive && (ow_rom_resume == ow_rom_target)) {
+            ow_async_skip_cmd = DS2431_RESUME;
+            p_ops[num_ops++] = (ow_op_t){OW_OP_WRITE, &ow_async_skip_cmd, 1};
+            return num_ops;
+        }
+        ow_async_match[0] = b_ow_overdrive ? DS2431_OVERDRIVEMATCH : DS2431_MATCHROM;
+        memcpy(&ow_async_match[1], ow_rom_ids[ow_rom_target], OW_ROM_BYTES);
+        if (b_ow_overdrive) {
+            // ROM ID of the "Overdrive Match ROM" is sent at overdrive speed
+            p_ops[num_ops++] = (ow_op_t){OW_OP_WRITE, ow_async_match, 1};
+            p_ops[num_ops++] = (ow_op_t){OW_OP_SPEED, NULL, 1};
+            p_ops[num_ops++] = (ow_op_t){OW_OP_WRITE, &ow_async_match[1], OW_ROM_BYTES};
+            ow_rom_resume = OW_ROM_MAX;
+        } else {
+            p_ops[num_ops++] = (ow_op_t){OW_OP_WRITE, ow_async_match, sizeof(ow_async_match)};
+            ow_rom_resume = ow_rom_target; // forgotten again if the transaction fails
+        }
+        return num_ops;
+    }
+
+    ow_async_skip_cmd = b_ow_overdrive ? DS2431_OVERDRIVESKIP : DS2431_SKIPROM;
+    p_ops[num_ops++] = (ow_op_t){OW_OP_SPEED, NULL, 0};
+    p_ops[num_ops++] = (ow_op_t){OW_OP_RESET, NULL, 0};
+    p_ops[num_ops++] = (ow_op_t){OW_OP_WRITE, &ow_async_skip_cmd, 1};
+    if (b_ow_overdrive)
+        p_ops[num_ops++] = (ow_op_t){OW_OP_SPEED, NULL, 1};
+    return num_ops;
+}
+
+/******************************************************************************
+** Name               : @fn ow_read_ROMID_async_ds2431
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function starts reading the ROMID without blocking. The connect status is
+**                             updated when the transaction is done.
+** InputValues        : @param ow_async_cb_t *p_cb which is called when the transaction is done, may be NULL
+**
+** OutputValues       : @retval HAL_OK if started, HAL_BUSY if a transaction is already running.
+******************************************************************************/
+HAL_StatusTypeDef ow_read_ROMID_async_ds2431(ow_async_cb_t *p_cb) {
+    HAL_StatusTypeDef I2C_Return;
+
+    if (ow_async_busy())
+        return HAL_BUSY;
+
+    for (int ii = 0; ii < 8; ii++)
+        ow_async_data[ii] = 0;
+    ow_async_cmd[0] = DS2431_READROM;
+
+    ow_async_ops[0] = (ow_op_t){OW_OP_SPEED, NULL, 0}; // ROM ID is read at standard speed
+    ow_async_ops[1] = (ow_op_t){OW_OP_RESET, NULL, 0};
+    ow_async_ops[2] = (ow_op_t){OW_OP_WRITE, ow_async_cmd, 1};
+    ow_async_ops[3] = (ow_op_t){OW_OP_READ, ow_async_data, 8};
+
+    p_ow_async_cb = p_cb;
+    I2C_Return = ow_async_start(ow_async_ops, 4, ow_read_ROMID_async_done);
+    return I2C_Return;
+}
+
+/******************************************************************************
+** Name               : @fn ow_read_ROMID_async_done
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function takes over the ROMID read by ow_read_ROMID_async_ds2431.
+** InputValues        : @param HAL_StatusTypeDef status of the transaction
+**
+** OutputValues       : @retval none
+******************************************************************************/
+static void ow_read_ROMID_async_done(HAL_StatusTypeDef status) {
+    uint64_t sentdata1, sentdata2;
+
+    if (status == HAL_OK) {
+        sentdata1 = ow_async_data[0] | ow_async_data[1] << 8 | ow_async_data[2] << 16 | ow_async_data[3] << 24;
+        sentdata2 = ow_async_data[4] | ow_async_data[5] << 8 | ow_async_data[6] << 16 | ow_async_data[7] << 24;
+        ds2431ROMid = sentdata2 << 32;
+        ds2431ROMid += sentdata1;
+    }
+
+    // a single device answers READ ROM, with more devices the ROM IDs collide and the CRC8 fails
+    if ((status == HAL_OK) && !ow_rom_valid_ds2431(ow_async_data))
+        status = HAL_ERROR;
+    if (status == HAL_OK) {
+        memcpy(ow_rom_ids[0], ow_async_data, OW_ROM_BYTES);
+        ow_rom_count = 1;
+        ow_rom_set_target_ds2431(0);
+    }
+
+    update_chipstatus(status);
+    if (p_ow_async_cb)
+        p_ow_async_cb(status);
+}
+
+/******************************************************************************
+** Name               : @fn owParamPage_read_all_async_ds2431
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function starts reading all pages without blocking, one "Read Memory" command
+**                             streams the whole parameter area. The page content structures are initialized when
+**                             the transaction is done.
+** InputValues        : @param ow_async_cb_t *p_cb which is called when the transaction is done, may be NULL
+**
+** OutputValues       : @retval HAL_OK if started, HAL_BUSY if a transaction is already running.
+******************************************************************************/
+HAL_StatusTypeDef owParamPage_read_all_async_ds2431(ow_async_cb_t *p_cb) {
+    HAL_StatusTypeDef I2C_Return;
+    uint8_t num_ops;
+
+    if (ow_async_busy())
+        return HAL_BUSY;
+
+    ow_async_cmd[0] = DS2431_READMEM;
+    ow_async_cmd[1] = (uint8_t)BASE_ADDRESS;        // TA1
+    ow_async_cmd[2] = (uint8_t)(BASE_ADDRESS >> 8); // TA2
+
+    num_ops = ow_async_select(ow_async_ops);
+    ow_async_ops[num_ops++] = (ow_op_t){OW_OP_WRITE, ow_async_cmd, 1 + ADDRESS_SIZE_BYTES};
+    ow_async_ops[num_ops++] = (ow_op_t){OW_OP_READ, ow_async_image, sizeof(ow_async_image)};
+
+    p_ow_async_cb = p_cb;
+    I2C_Return = ow_async_start(ow_async_ops, num_ops, owParamPage_read_all_async_done);
+    return I2C_Return;
+}
+
+/******************************************************************************
+** Name               : @fn owParamPage_read_all_async_done
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function initializes the pages read by owParamPage_read_all_async_ds2431.
+** InputValues        : @param HAL_StatusTypeDef status of the transaction
+**
+** OutputValues       : @retval none
+******************************************************************************/
+static void owParamPage_read_all_async_done(HAL_StatusTypeDef status) {
+    if (status == HAL_OK)
+        owParamPage_set_ds2431(ow_async_image);
+    else
+        ow_rom_resume = OW_ROM_MAX;
+
+    if (p_ow_async_cb)
+        p_ow_async_cb(status);
+}
+
+/******************************************************************************
+** Name               : @fn ow_read_memory_async_ds2431
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function starts reading a memory range without blocking, one "Read Memory"
+**                             command streams the range into the buffer of the caller. As with
+**                             ow_read_memory_address_ds2431 the RAM shadow is not updated.
+** InputValues        : @param uint16_t MemAddress which is the start address
+**                             uint8_t *ReadMemory which is the buffer, has to stay valid until the callback
+**                             uint16_t Size which is the number of bytes to be read
+**                             ow_async_cb_t *p_cb which is called when the transaction is done, may be NULL
+**
+** OutputValues       : @retval HAL_OK if started, HAL_BUSY if a transaction is already running.
+******************************************************************************/
+HAL_StatusTypeDef ow_read_memory_async_ds2431(uint16_t MemAddress, uint8_t *ReadMemory, uint16_t Size,
+                                              ow_async_cb_t *p_cb) {
+    HAL_StatusTypeDef I2C_Return;
+    uint8_t num_ops;
+
+    if (ow_async_busy())
+        return HAL_BUSY;
+    if ((MemAddress + Size) > Num_BYTES)
+        return HAL_ERROR;
+
+    ow_async_cmd[0] = DS2431_READMEM;
+    ow_async_cmd[1] = (uint8_t)MemAddress;        // TA1
+    ow_async_cmd[2] = (uint8_t)(MemAddress >> 8); // TA2
+
+    num_ops = ow_async_select(ow_async_ops);
+    ow_async_ops[num_ops++] = (ow_op_t){OW_OP_WRITE, ow_async_cmd, 1 + ADDRESS_SIZE_BYTES};
+    ow_async_ops[num_ops++] = (ow_op_t){OW_OP_READ, ReadMemory, Size};
+
+    p_ow_async_cb = p_cb;
+    I2C_Return = ow_async_start(ow_async_ops, num_ops, ow_read_memory_async_done);
+    return I2C_Return;
+}
+
+/******************************************************************************
+** Name               : @fn ow_read_memory_async_done
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function finishes a read of ow_read_memory_async_ds2431.
+** InputValues        : @param HAL_StatusTypeDef status of the transaction
+**
+** OutputValues       : @retval none
+******************************************************************************/
+static void ow_read_memory_async_done(HAL_StatusTypeDef status) {
+    if (status != HAL_OK)
+        ow_rom_resume = OW_ROM_MAX;
+
+    if (p_ow_async_cb)
+        p_ow_async_cb(status);
+}
+
+/******************************************************************************
+** Name               : @fn ow_write_mem_row_async_ds2431
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function starts writing 8-byte data to a page with offset indexing without
+**                             blocking. The first transaction writes and reads back the scratchpad, the second
+**                             one copies it into the EEPROM if the read back scratchpad is valid. Only the RAM
+**                             shadow is updated, rows of the page content are written by
+**                             owParamPage_flush_row_async_ds2431.
+** InputValues        : @param uint8_t page - page no: 1 or 2 or 3 or 4
+**                             uint64_t Value which is 8-byte value to be written.
+**                             uint8_t offset - each page has 4 rows, which row to write
+**                             ow_async_cb_t *p_cb which is called when the transaction is done, may be NULL
+**
+** OutputValues       : @retval HAL_OK if started, HAL_BUSY if a transaction is already running.
+******************************************************************************/
+HAL_StatusTypeDef ow_write_mem_row_async_ds2431(owPage localpage, uint64_t Value, uint8_t offset, ow_async_cb_t *p_cb) {
+    HAL_StatusTypeDef I2C_Return;
+    uint16_t MemAddress = (0x0020 * (localpage - Page1)) + offset; // Page Numbering (1-17)
+    uint8_t num_ops;
+
+    if (ow_async_busy())
+        return HAL_BUSY;
+    if ((localpage < Page1) || (localpage > Page4))
+        return HAL_ERROR;
+
+    ow_async_cmd[0] = DS2431_WRITESCRATCH;
+    ow_async_cmd[1] = (uint8_t)MemAddress;        // TA1
+    ow_async_cmd[2] = (uint8_t)(MemAddress >> 8); // TA2
+    for (int i = 0; i < BYTES_PER_ROW; i++)       // Convert from uint64_t to uint8_t
+        ow_async_cmd[1 + ADDRESS_SIZE_BYTES + i] = *((uint8_t *)&(Value) + i);
+    ow_async_scratch_cmd = DS2431_READSCRATCH;
+    ow_async_address = MemAddress;
+
+    num_ops = ow_async_select(ow_async_ops);
+    ow_async_ops[num_ops++] = (ow_op_t){OW_OP_WRITE, ow_async_cmd, sizeof(ow_async_cmd)};
+    ow_async_ops[num_ops++] = (ow_op_t){OW_OP_READ, ow_async_crc, Read_CRC_BYTES};
+    num_ops += ow_async_select(&ow_async_ops[num_ops]);
+    ow_async_ops[num_ops++] = (ow_op_t){OW_OP_WRITE, &ow_async_scratch_cmd, 1};
+    ow_async_ops[num_ops++] = (ow_op_t){OW_OP_READ, ow_async_data, Read_Scratchpad_BYTES};
+
+    p_ow_async_cb = p_cb;
+    I2C_Return = ow_async_start(ow_async_ops, num_ops, ow_write_mem_row_async_scratch_done);
+    return I2C_Return;
+}
+
+/******************************************************************************
+** Name               : @fn ow_write_mem_row_async_scratch_done
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function checks the scratchpad written by ow_write_mem_row_async_ds2431 and
+**                             starts copying it into the EEPROM, the authorization code is taken from the
+**                             scratchpad read back.
+** InputValues        : @param HAL_StatusTypeDef status of the transaction
+**
+** OutputValues       : @retval none
+******************************************************************************/
+static void ow_write_mem_row_async_scratch_done(HAL_StatusTypeDef status) {
+    uint8_t num_ops;
+
+    if ((status == HAL_OK) &&
+        !ow_scratchpad_valid_ds2431(ow_async_data, ow_async_address, &ow_async_cmd[1 + ADDRESS_SIZE_BYTES]))
+        status = HAL_ERROR;
+
+    if (status == HAL_OK) {
+        ow_async_copy_cmd = DS2431_COPYSCRATCH;
+        ow_async_copy_status = 0;
+
+        num_ops = ow_async_select(ow_async_ops);
+        ow_async_ops[num_ops++] = (ow_op_t){OW_OP_WRITE, &ow_async_copy_cmd, 1};
+        ow_async_ops[num_ops++] = (ow_op_t){OW_OP_WRITE, ow_async_data, Authorization_Code_BYTES}; // TA1, TA2, E/S
+        ow_async_ops[num_ops++] = (ow_op_t){OW_OP_DELAY, NULL, ds2431_tPROG};
+        ow_async_ops[num_ops++] = (ow_op_t){OW_OP_READ, &ow_async_copy_status, Copy_Scratchpad_BYTES};
+        status = ow_async_start(ow_async_ops, num_ops, ow_write_mem_row_async_done);
+        if (status == HAL_OK)
+            return;
+    }
+
+    /* the caller retries the write, at standard speed after an overdrive failure */
+    ow_overdrive_fallback_ds2431();
+    if (p_ow_async_cb)
+        p_ow_async_cb(status);
+}
+
+/******************************************************************************
+** Name               : @fn ow_write_mem_row_async_done
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function checks the copy status of ow_write_mem_row_async_ds2431 and updates
+**                             the RAM shadow.
+** InputValues        : @param HAL_StatusTypeDef status of the transaction
+**
+** OutputValues       : @retval none
+******************************************************************************/
+static void ow_write_mem_row_async_done(HAL_StatusTypeDef status) {
+    if ((status == HAL_OK) && (ow_async_copy_status != 0xAA)) // AAh = success
+        status = HAL_ERROR;
+    if (status != HAL_OK)
+        ow_rom_resume = OW_ROM_MAX;
+
+    // the page content may have changed meanwhile, only the RAM shadow is updated
+    ow_shadow_store_ds2431(ow_async_address, (status == HAL_OK) ? &ow_async_cmd[1 + ADDRESS_SIZE_BYTES] : NULL,
+                           BYTES_PER_ROW);
+
+    if (p_ow_async_cb)
+        p_ow_async_cb(status);
+}
+
+/******************************************************************************
+** Name               : @fn owParamPage_flush_row_async_ds2431
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function starts writing the first dirty row of the page content structures
+**                             without blocking, see ow_write_mem_row_async_ds2431. The caller repeats it until
+**                             owParamPage_dirty_ds2431() has no more of the rows set.
+** InputValues        : @param uint16_t rows - rows to be written if dirty
+**                             ow_async_cb_t *p_cb which is called when the transaction is done, may be NULL
+**
+** OutputValues       : @retval HAL_OK if started, HAL_BUSY if a transaction is already running, HAL_ERROR if no
+**                              row is dirty.
+******************************************************************************/
+HAL_StatusTypeDef owParamPage_flush_row_async_ds2431(uint16_t rows, ow_async_cb_t *p_cb) {
+    uint64_t Value;
+    uint8_t row = 0;
+
+    rows &= owParamPage_dirty_ds2431();
+    while ((row < NUM_PARAM_ROWS) && !(rows & OW_ROW_MASK(row * BYTES_PER_ROW)))
+        row++;
+    if (row >= NUM_PARAM_ROWS)
+        return HAL_ERROR;
+
+    memcpy(&Value, ow_row_data_ds2431(row), BYTES_PER_ROW);
+    return ow_write_mem_row_async_ds2431((owPage)(Page1 + (row / ROWS_PER_PAGE)), Value,
+                                         (row % ROWS_PER_PAGE) * BYTES_PER_ROW, p_cb);
+}
+
+/******************************************************************************
+** Name               : @fn ow_select_rom_ds2431
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function selects a device found by ow_search_rom_ds2431() for the following
+**                             command. The reset pulse is followed by "Match ROM" and the ROM ID, or by "Resume" if
+**                             the device was the last one matched. The torch EEPROM is matched with "Overdrive Match
+**                             ROM" if overdrive is used.
+** InputValues        : @param uint8_t index of the device
+**
+** OutputValues       : @retval I2C_Return HAL_StatusTypeDef.
+******************************************************************************/
+HAL_StatusTypeDef ow_select_rom_ds2431(uint8_t index) {
+    HAL_StatusTypeDef I2C_Return = HAL_OK;
+    uint8_t b_overdrive = b_ow_overdrive && (index == ow_rom_target);
+
+    if (index >= ow_rom_count)
+        return HAL_ERROR;
+
+    I2C_Return = ow_set_speed_ds2484(0);
+    if (I2C_Return == HAL_OK)
+        I2C_Return = ow_one_wire_reset_ds2484(); // Reset pulse
+    if (I2C_Return != HAL_OK) {
+        ow_rom_resume = OW_ROM_MAX;
+        return I2C_Return;
+    }
+
+    if (!b_overdrive && (ow_rom_resume == index))
+        return ow_write_byte_ds2484(DS2431_RESUME); // Issue "Resume" command
+
+    ow_rom_resume = OW_ROM_MAX;
+    I2C_Return = ow_write_byte_ds2484(b_overdrive ? DS2431_OVERDRIVEMATCH : DS2431_MATCHROM);
+    if ((I2C_Return == HAL_OK) && b_overdrive)
+        I2C_Return = ow_set_speed_ds2484(1); // ROM ID is sent at overdrive speed
+    for (uint8_t i = 0; (i < OW_ROM_BYTES) && (I2C_Return == HAL_OK); i++)
+        I2C_Return = ow_write_byte_ds2484(ow_rom_ids[index][i]);
+    if ((I2C_Return == HAL_OK) && !b_overdrive)
+        ow_rom_resume = index;
+    return I2C_Return;
+}
+
+/******************************************************************************
+** Name               : @fn ow_search_rom_ds2431
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function enumerates the devices on the 1-Wire bus by "Search ROM", one DS2484
+**                             triplet per ROM bit. The ROM IDs are validated by CRC8 and cached, the first ds2431
+**                             becomes the torch EEPROM (ds2431ROMid).
+** InputValues        : @param Nil
+**
+** OutputValues       : @retval HAL_OK if a ds2431 was found.
+******************************************************************************/
+HAL_StatusTypeDef ow_search_rom_ds2431(void) {
+    HAL_StatusTypeDef I2C_Return = HAL_OK;
+    uint8_t rom[OW_ROM_BYTES] = {0};
+    uint8_t last_discrepancy = 0, last_zero, status, b_dir, mask;
+
+    ow_rom_count = 0;
+    ow_rom_target = OW_ROM_MAX;
+    ow_rom_resume = OW_ROM_MAX;
+
+    I2C_Return = ow_set_speed_ds2484(0); // search at standard speed
+    do {
+        if (I2C_Return == HAL_OK)
+            I2C_Return = ow_one_wire_reset_ds2484(); // Reset pulse
+        if (I2C_Return == HAL_OK)
+            I2C_Return = ow_write_byte_ds2484(DS2431_SEARCHROM); // Issue "Search ROM" command
+
+        last_zero = 0;
+        for (uint8_t bit = 1; (bit <= (OW_ROM_BYTES * 8)) && (I2C_Return == HAL_OK); bit++) {
+            mask = 1 << ((bit - 1) % 8);
+            // below the last discrepancy the path of the previous ROM ID, at it the 1 branch, above it the 0 branch
+            if (bit < last_discrepancy)
+                b_dir = (rom[(bit - 1) / 8] & mask) ? 1 : 0;
+            else
+                b_dir = (bit == last_discrepancy);
+
+            I2C_Return = ow_triplet_ds2484(b_dir, &status);
+            if ((I2C_Return == HAL_OK) && (status & DS2484_REG_STS_SBR) && (status & DS2484_REG_STS_TSB))
+                I2C_Return = HAL_ERROR; // no device answered
+            if (I2C_Return != HAL_OK)
+                break;
+
+            b_dir = (status & DS2484_REG_STS_DIR) ? 1 : 0;
+            if (!(status & DS2484_REG_STS_SBR) && !(status & DS2484_REG_STS_TSB) && !b_dir)
+                last_zero = bit; // discrepancy, the 1 branch follows with the next pass
+            if (b_dir)
+                rom[(bit - 1) / 8] |= mask;
+            else
+                rom[(bit - 1) / 8] &= ~mask;
+        }
+        if ((I2C_Return == HAL_OK) && !ow_rom_valid_ds2431(rom))
+            I2C_Return = HAL_ERROR;
+        if (I2C_Return != HAL_OK)
+            break;
+
+        memcpy(ow_rom_ids[ow_rom_count], rom, OW_ROM_BYTES);
+        if ((ow_rom_target == OW_ROM_MAX) && (rom[0] == DS2431_FAMILY_CODE))
+            ow_rom_set_target_ds2431(ow_rom_count);
+        ow_rom_count++;
+        last_discrepancy = last_zero;
+    } while ((last_discrepancy != 0) && (ow_rom_count < OW_ROM_MAX));
+
+    return (ow_rom_target < OW_ROM_MAX) ? HAL_OK : HAL_ERROR;
+}
+
+/******************************************************************************
+** Name               : @fn ow_rom_count_ds2431
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function returns the number of devices found on the 1-Wire bus.
+** InputValues        : @param Nil
+**
+** OutputValues       : @retval number of cached ROM IDs.
+******************************************************************************/
+uint8_t ow_rom_count_ds2431(void) {
+    return ow_rom_count;
+}
+
+/******************************************************************************
+** Name               : @fn ow_rom_id_ds2431
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function returns a cached ROM ID.
+** InputValues        : @param uint8_t index of the device
+**                             uint8_t *p_rom which receives the OW_ROM_BYTES bytes of the ROM ID
+**
+** OutputValues       : @retval HAL_OK, HAL_ERROR for an invalid index.
+******************************************************************************/
+HAL_StatusTypeDef ow_rom_id_ds2431(uint8_t index, uint8_t *p_rom) {
+    if (index >= ow_rom_count)
+        return HAL_ERROR;
+
+    memcpy(p_rom, ow_rom_ids[index], OW_ROM_BYTES);
+    return HAL_OK;
+}
+
+/******************************************************************************
+** Name               : @fn ow_crc8_ds2431
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function calculates the 1-Wire CRC8 (polynomial 0x31, reflected) of the ROM ID.
+** InputValues        : @param uint8_t crc which is the CRC8 of the data before, 0 for the start
+**                             const uint8_t *p_data which is the data
+**                             uint16_t length which is the number of bytes
+**
+** OutputValues       : @retval uint8_t CRC8, 0 over a complete ROM ID including its CRC8.
+******************************************************************************/
+uint8_t ow_crc8_ds2431(uint8_t crc, const uint8_t *p_data, uint16_t length) {
+    while (length--) {
+        crc ^= *p_data++;
+        for (uint8_t i = 0; i < 8; i++)
+            crc = (crc & 1) ? ((crc >> 1) ^ 0x8C) : (crc >> 1);
+    }
+    return crc;
+}
+
+/******************************************************************************
+** Name               : @fn ow_rom_valid_ds2431
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function checks a ROM ID by its CRC8. A ROM ID of 0x00 bytes, which passes the
+**                             CRC8, has no family code and is invalid as well.
+** InputValues        : @param const uint8_t *p_rom which is the ROM ID
+**
+** OutputValues       : @retval 1 if valid, 0 if not.
+******************************************************************************/
+static uint8_t ow_rom_valid_ds2431(const uint8_t *p_rom) {
+    return (p_rom[0] != 0x00) && (ow_crc8_ds2431(0, p_rom, OW_ROM_BYTES) == 0);
+}
+
+/******************************************************************************
+** Name               : @fn ow_rom_set_target_ds2431
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function takes a cached ROM ID as ROM ID of the torch EEPROM.
+** InputValues        : @param uint8_t index of the device
+**
+** OutputValues       : @retval none
+******************************************************************************/
+static void ow_rom_set_target_ds2431(uint8_t index) {
+    ow_rom_target = index;
+    memcpy(&ds2431ROMid, ow_rom_ids[index], OW_ROM_BYTES);
+}
@@ -11,6 +11,7 @@
 #include "stdint.h"
 #include "stm32g4xx_hal.h"
 #include "stm32g4xx_hal_i2c.h"
+#include "DS2484.h"
 
 typedef enum { Page1 = 2, Page2 = 3, Page3 = 4, Page4 = 5, PageAll = 1 } owPage;
 
@@ -24,7 +25,7 @@ HAL_StatusTypeDef ow_write_scratchpad_ds2431(uint16_t Address, uint8_t bytes[],
 HAL_StatusTypeDef ow_read_scratchpad_ds2431(uint8_t *Read_Scratchpad);
 HAL_StatusTypeDef ow_copy_scratchpad_ds2431(uint8_t Authorization_Code[], uint8_t *Copy_Status);
 
-HAL_StatusTypeDef ow_read_memory_address_ds2431(uint16_t MemAddress, uint8_t *ReadMemory, uint8_t Size);
+HAL_StatusTypeDef ow_read_memory_address_ds2431(uint16_t MemAddress, uint8_t *ReadMemory, uint16_t Size);
 HAL_StatusTypeDef ow_write_memory_address_ds2431(uint16_t MemAddress, uint64_t Value);
 
 HAL_StatusTypeDef ow_write_memory_row_ds2431(uint8_t row, uint64_t Value);
@@ -46,6 +47,15 @@ HAL_StatusTypeDef ow_read_all_memory_ds2431(uint64_t *ReadAllMemory);
 #define DS2431_RESUME         0xA5
 #define DS2431_OVERDRIVESKIP  0x3C
 #define DS2431_OVERDRIVEMATCH 0x69
+#define DS2431_FAMILY_CODE    0x2D // first byte of the ROM ID
+
+#define OW_ROM_BYTES 8 // family code, 48-bit serial number, CRC8
+#define OW_ROM_MAX   4 // devices on the 1-Wire bus, the torch EEPROM and accessories
+
+/* 1: EEPROM is accessed at overdrive speed, falls back to standard speed on the first CRC failure */
+#ifndef DS2431_OVERDRIVE
+#define DS2431_OVERDRIVE 0
+#endif
 
 // #############  DS2431 EPPROM Architecture  ###################
 #define SEG_SIZE_BITS      8
@@ -57,6 +67,10 @@ HAL_StatusTypeDef ow_read_all_memory_ds2431(uint64_t *ReadAllMemory);
 #define ADDRESS_SIZE_BYTES 2 // 16-bit address
 #define CLEAR_BYTE         0x00
 #define Num_BYTES          144 // Can not Write last 2 Bytes
+#define BYTES_PER_PAGE     32
+#define NUM_PARAM_PAGES    4 // Page1..Page4
+#define ROWS_PER_PAGE      4
+#define NUM_PARAM_ROWS     (NUM_PARAM_PAGES * ROWS_PER_PAGE)
 #define ds2431_tPROG       16
 
 // #############  DS2431 Operations Output  ###################
@@ -65,16 +79,22 @@ HAL_StatusTypeDef ow_read_all_memory_ds2431(uint64_t *ReadAllMemory);
 #define Copy_Scratchpad_BYTES    1  // Read copy status, AAh = success
 #define Authorization_Code_BYTES 3  // Read TA1, TA2, E/S
 
+// #############  DS2431 RAM shadow  ###################
+// rows of the parameter pages, bit n = row n (address n * BYTES_PER_ROW)
+#define OW_ROWS_ALL       0xFFFF
+#define OW_PAGE_ROWS(pg)  ((uint16_t)(0x000F << (((pg) - Page1) * ROWS_PER_PAGE)))
+#define OW_ROW_MASK(addr) ((uint16_t)(1 << ((addr) / BYTES_PER_ROW)))
+
 typedef struct {
     uint16_t TEST;       // for Testing of BKC
     uint16_t OwnVERSION; // Version of the following struct
     uint16_t dummy1;
     uint16_t dummy2;
-    uint32_t Reserved1[6];
+    uint32_t Reserved1[6]; // used for the last known parameter, see param_cache.c
 } owParamPage1;
 
 typedef struct {
-    uint32_t Weldtime[2]; // Weldtime of this torch in s, two Values for Failsave
+    uint32_t Weldtime[2]; // Weldtime of this torch in s, log of records in all rows of the page, see weld_time.c
     uint32_t Reserved2[6];
 } owParamPage2;
 
@@ -124,7 +144,24 @@ HAL_StatusTypeDef ow_read_mem_row_ds2431_offset(owPage localpage, uint8_t *ReadM
 HAL_StatusTypeDef owParamPage_init_ds2431(void);
 HAL_StatusTypeDef owParamPage_write_ds2431(owPage localpage);
 HAL_StatusTypeDef owParamPage_read_ds2431(owPage localpage);
+void owParamPage_set_ds2431(const uint8_t *p_image);
+uint16_t owParamPage_dirty_ds2431(void);
+HAL_StatusTypeDef owParamPage_flush_ds2431(uint16_t rows);
+HAL_StatusTypeDef owParamPage_flush_row_async_ds2431(uint16_t rows, ow_async_cb_t *p_cb);
 uint8_t ow_Write_TorchType(uint32_t enumTorchType);
 uint8_t ow_read_TorchType(uint32_t *enumTorchType);
 uint8_t ow_BKCTest(void);
-void ow_split_ROMID_ds2431(uint8_t *idslitbufer);
\ No newline at end of file
+void ow_split_ROMID_ds2431(uint8_t *idslitbufer);
+HAL_StatusTypeDef ow_select_ds2431(void);
+HAL_StatusTypeDef ow_select_rom_ds2431(uint8_t index);
+HAL_StatusTypeDef ow_search_rom_ds2431(void);
+uint8_t ow_rom_count_ds2431(void);
+HAL_StatusTypeDef ow_rom_id_ds2431(uint8_t index, uint8_t *p_rom);
+uint8_t ow_crc8_ds2431(uint8_t crc, const uint8_t *p_data, uint16_t length);
+uint8_t ow_overdrive_fallback_ds2431(void);
+uint16_t ow_crc16_ds2431(uint16_t crc, const uint8_t *p_data, uint16_t length);
+HAL_StatusTypeDef ow_read_ROMID_async_ds2431(ow_async_cb_t *p_cb);
+HAL_StatusTypeDef owParamPage_read_all_async_ds2431(ow_async_cb_t *p_cb);
+HAL_StatusTypeDef ow_read_memory_async_ds2431(uint16_t MemAddress, uint8_t *ReadMemory, uint16_t Size,
+                                              ow_async_cb_t *p_cb);
+HAL_StatusTypeDef ow_write_mem_row_async_ds2431(owPage localpage, uint64_t Value, uint8_t offset, ow_async_cb_t *p_cb);
\ No newline at end of file
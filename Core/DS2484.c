@@ -9,10 +9,43 @@
  */
 
 #include "DS2484.h"
+#include "trace.h"
 #include <stdio.h>
+#include <string.h>
 
 extern I2C_HandleTypeDef hi2cOneWire; /*I2C peripheral handeller*/
 #define DS2484_I2C &hi2cOneWire
+
+/* states of the asynchronous transaction engine */
+typedef enum {
+    OW_STATE_IDLE,  // no transaction running
+    OW_STATE_CMD,   // 1-Wire command is transmitted
+    OW_STATE_POLL,  // status register is read until the 1-Wire line is idle
+    OW_STATE_DATA,  // read pointer is set to the read data register and the byte is read
+    OW_STATE_DELAY, // waiting for the delay of an OW_OP_DELAY
+    OW_STATE_CFG    // device configuration of an OW_OP_SPEED is transmitted
+} ow_state_t;
+
+static const ow_op_t *p_ow_ops;      // script of the running transaction
+static uint8_t ow_num_ops;           // number of operations of the script
+static uint8_t ow_op_idx;            // actual operation
+static uint8_t ow_byte_idx;          // actual byte of the operation
+static uint8_t ow_tx[2];             // command transmitted to the DS2484
+static uint8_t ow_sts;               // status register read from the DS2484
+static uint16_t ow_polls;            // number of status reads of the actual byte
+static uint32_t ow_delay_tick;       // start of an OW_OP_DELAY
+static uint32_t ow_start_tick;       // start of the transaction
+static uint32_t ow_timeout;          // ms from the start to the deadline of the transaction
+static ow_async_cb_t *p_ow_cb;       // completion callback
+static volatile ow_state_t ow_state = OW_STATE_IDLE;
+static volatile HAL_StatusTypeDef ow_status = HAL_OK;
+static uint8_t ow_overdrive = 0; // 1-Wire speed of the DS2484, 1=overdrive
+static ow_stats_t ow_stats;      // bus statistics
+
+static void ow_async_op(void);
+static void ow_async_next(void);
+static void ow_async_finish(HAL_StatusTypeDef status);
+static void ow_async_abort(void);
 /******************************************************************************
 ** Name               : @fn ow_setup_ds2484
 **
@@ -30,6 +63,7 @@ extern I2C_HandleTypeDef hi2cOneWire; /*I2C peripheral handeller*/
 HAL_StatusTypeDef ow_setup_ds2484(void) {
     HAL_StatusTypeDef I2C_Return = HAL_OK;
     I2C_Return = ow_reset_ds2484(); // Reset Device
+    ow_overdrive = 0;               // device reset selects standard speed
     I2C_Return =
         ow_write_device_configuration_ds2484(DS2484_REG_CFG_APU); // Configure device with Active Pullup (APU) feature.
     I2C_Return = ow_adjust_one_wire_port_ds2484();                // Adjust port configuration register
@@ -54,6 +88,7 @@ HAL_StatusTypeDef ow_reset_ds2484(void) {
     uint8_t Device_Reset[1] = {
         DS2484_CMD_RESET, // Device Reset
     };
+    ow_stats.i2c_transfers++;
     I2C_Return = HAL_I2C_Master_Transmit(DS2484_I2C, DS2484_ADDRESS, Device_Reset, 1, Time_OUT); // reset device
     //	I2C_Return = ow_set_read_pointer_ds2484(DS2484_PTR_CODE_STATUS); //Optional after Device Reset CMD
     I2C_Return = ow_read_register_ds2484(1); // read Status register in after reset
@@ -75,12 +110,15 @@ HAL_StatusTypeDef ow_reset_ds2484(void) {
 ** OutputValues       : @retval I2C_Return which is return stauts for I2C read/write operation.
 ******************************************************************************/
 HAL_StatusTypeDef ow_set_read_pointer_ds2484(uint8_t Register_Code) {
+    if (ow_status == HAL_BUSY)
+        return HAL_BUSY; // asynchronous transaction running
     HAL_StatusTypeDef I2C_Return = HAL_OK;
 
     uint8_t Set_Read_Pointer[2];
     Set_Read_Pointer[0] = DS2484_CMD_SET_READ_PTR;
     Set_Read_Pointer[1] = Register_Code; // set read pointer for configuration register
 
+    ow_stats.i2c_transfers++;
     I2C_Return = HAL_I2C_Master_Transmit(DS2484_I2C, DS2484_ADDRESS, Set_Read_Pointer, 2,
                                          Time_OUT); // Set pointer to configuration register
     return I2C_Return;
@@ -114,6 +152,7 @@ HAL_StatusTypeDef ow_read_register_ds2484(uint8_t Size) {
             0x00, // byte for reading data
         };
     HAL_StatusTypeDef I2C_Return = HAL_OK;
+    ow_stats.i2c_transfers++;
     I2C_Return = HAL_I2C_Master_Receive(DS2484_I2C, DS2484_ADDRESS_READ, Read_Byte, Size,
                                         Time_OUT); // read current pointed register
     return I2C_Return;
@@ -139,6 +178,7 @@ HAL_StatusTypeDef ow_write_device_configuration_ds2484(uint8_t Config_Feature) {
 
     HAL_StatusTypeDef I2C_Return = HAL_OK;
 
+    ow_stats.i2c_transfers++;
     I2C_Return = HAL_I2C_Master_Transmit(DS2484_I2C, DS2484_ADDRESS, Device_Config, 2, Time_OUT); // configure devide
     // I2C_Return = ow_set_read_pointer_ds2484(DS2484_PTR_CODE_CONFIG); //Optional after Device Config CMD
     I2C_Return = ow_read_register_ds2484(1); // Read Device Configuration register (for debuging)
@@ -173,6 +213,7 @@ HAL_StatusTypeDef ow_adjust_one_wire_port_ds2484(void) {
     Adjust_Port[5] = 0x86; /* Data 5 */ // selects RWPU
 
     HAL_StatusTypeDef I2C_Return = HAL_OK;
+    ow_stats.i2c_transfers++;
     I2C_Return = HAL_I2C_Master_Transmit(DS2484_I2C, DS2484_ADDRESS, Adjust_Port, 6, Time_OUT);
     //  I2C_Return = ow_set_read_pointer_ds2484(DS2484_PTR_CODE_PORT_CONFIG); //Optional after Adjust port CMD
     I2C_Return = ow_read_register_ds2484(8); // Read Port Configuration Register (for debuging)
@@ -193,16 +234,23 @@ HAL_StatusTypeDef ow_adjust_one_wire_port_ds2484(void) {
 ** OutputValues       : @retval I2C_Return which is return stauts for I2C read/write operation.
 ******************************************************************************/
 HAL_StatusTypeDef ow_one_wire_reset_ds2484(void) {
+    if (ow_status == HAL_BUSY)
+        return HAL_BUSY; // asynchronous transaction running
     uint8_t OneWire_Reset[1] = {
         DS2484_CMD_1WIRE_RESET, // 1WRS
     };
 
     HAL_StatusTypeDef I2C_Return = HAL_OK;
+    uint8_t Status = 0;
+    ow_stats.i2c_transfers++;
+    ow_stats.ow_resets++;
     I2C_Return =
         HAL_I2C_Master_Transmit(DS2484_I2C, DS2484_ADDRESS, OneWire_Reset, 1, Time_OUT); // reset 1-Wire mbv 1WRS byte
-    //	I2C_Return = ow_set_read_pointer_ds2484(DS2484_PTR_CODE_STATUS); //Optional after Device Reset CMD
-    I2C_Return = ow_read_register_ds2484(1); // Read Status register in after reset (for debuging)
-    HAL_Delay(DS2484_DELAY);
+    if (I2C_Return != HAL_OK)
+        return I2C_Return;
+    I2C_Return = ow_wait_idle_ds2484(&Status); // wait for the end of the reset and the presence pulse
+    if ((I2C_Return == HAL_OK) && (!(Status & DS2484_REG_STS_PPD) || (Status & DS2484_REG_STS_SD)))
+        I2C_Return = HAL_ERROR; // no device or short on the 1-Wire line
     return I2C_Return;
 }
 /******************************************************************************
@@ -225,6 +273,7 @@ HAL_StatusTypeDef ow_single_bit_ds2484(void) {
     OneWire_SingleBit[1] = 0x10; /* Data 1 */                        // V value (1 of 0)
 
     HAL_StatusTypeDef I2C_Return = HAL_OK;
+    ow_stats.i2c_transfers++;
     I2C_Return = HAL_I2C_Master_Transmit(DS2484_I2C, DS2484_ADDRESS, OneWire_SingleBit, 2, Time_OUT);
     return I2C_Return;
 }
@@ -243,12 +292,18 @@ HAL_StatusTypeDef ow_single_bit_ds2484(void) {
 ** OutputValues       : @retval I2C_Return which is return stauts for I2C read/write operation.
 ******************************************************************************/
 HAL_StatusTypeDef ow_write_byte_ds2484(uint8_t Byte_Data) {
+    if (ow_status == HAL_BUSY)
+        return HAL_BUSY; // asynchronous transaction running
     uint8_t OneWire_WriteByte[2];
     OneWire_WriteByte[0] = DS2484_CMD_1WIRE_WRITE_BYTE; /* Data 0 */ // send 1WBS
     OneWire_WriteByte[1] = Byte_Data; /* Data 1 */                   // V value
     HAL_StatusTypeDef I2C_Return = HAL_OK;
+    ow_stats.i2c_transfers++;
+    ow_stats.ow_bytes++;
     I2C_Return = HAL_I2C_Master_Transmit(DS2484_I2C, DS2484_ADDRESS, OneWire_WriteByte, 2, Time_OUT); // Write Byte data
-    HAL_Delay(DS2484_DELAY);
+    if (I2C_Return != HAL_OK)
+        return I2C_Return;
+    I2C_Return = ow_wait_idle_ds2484(NULL); // wait until the byte is sent
     return I2C_Return;
 }
 /******************************************************************************
@@ -265,11 +320,592 @@ HAL_StatusTypeDef ow_write_byte_ds2484(uint8_t Byte_Data) {
 ** OutputValues       : @retval I2C_Return which is return stauts for I2C read/write operation.
 ******************************************************************************/
 HAL_StatusTypeDef ow_read_byte_ds2484(void) {
+    if (ow_status == HAL_BUSY)
+        return HAL_BUSY; // asynchronous transaction running
     uint8_t OneWire_ReadByte[1] = {
         DS2484_CMD_1WIRE_READ_BYTE, // 1WRB
     };
     HAL_StatusTypeDef I2C_Return = HAL_OK;
+    ow_stats.i2c_transfers++;
+    ow_stats.ow_bytes++;
     I2C_Return = HAL_I2C_Master_Transmit(DS2484_I2C, DS2484_ADDRESS, OneWire_ReadByte, 1, Time_OUT); // read byte
-    // HAL_Delay(DS2484_DELAY);
+    if (I2C_Return != HAL_OK)
+        return I2C_Return;
+    I2C_Return = ow_wait_idle_ds2484(NULL); // wait until the byte is received
+    return I2C_Return;
+}
+/******************************************************************************
+** Name               : @fn ow_triplet_ds2484
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function writes a "1-Wire Triplet" command, one bit of a SEARCH ROM: two read time
+**                       slots and one write time slot with the direction chosen by the DS2484.
+**
+** Calling            : @Aus DS2431.c
+**
+** InputValues        : @param uint8_t b_dir which is the direction written if both bits read are 0 (discrepancy)
+**                             uint8_t *p_status which receives the status register with SBR, TSB and DIR
+**
+** OutputValues       : @retval I2C_Return which is return stauts for I2C read/write operation.
+******************************************************************************/
+HAL_StatusTypeDef ow_triplet_ds2484(uint8_t b_dir, uint8_t *p_status) {
+    if (ow_status == HAL_BUSY)
+        return HAL_BUSY; // asynchronous transaction running
+    uint8_t OneWire_Triplet[2];
+    OneWire_Triplet[0] = DS2484_CMD_1WIRE_TRIPLET; // 1WT
+    OneWire_Triplet[1] = b_dir ? 0x80 : 0x00;      // direction byte (bit7)
+    HAL_StatusTypeDef I2C_Return = HAL_OK;
+    ow_stats.i2c_transfers++;
+    I2C_Return = HAL_I2C_Master_Transmit(DS2484_I2C, DS2484_ADDRESS, OneWire_Triplet, 2, Time_OUT);
+    if (I2C_Return != HAL_OK)
+        return I2C_Return;
+    I2C_Return = ow_wait_idle_ds2484(p_status); // wait for the three time slots
+    return I2C_Return;
+}
+/******************************************************************************
+** Name               : @fn ow_wait_idle_ds2484
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function waits for the end of a 1-Wire command by polling the 1WB bit of the status
+**                       register. After a 1-Wire command the read pointer of the DS2484 is at the status register, so
+**                       each poll is a single byte read.
+**
+** Calling            : @remark after 1-Wire Reset, Write Byte and Read Byte
+**
+** InputValues        : @param uint8_t *p_status which receives the last status register value, may be NULL
+**
+** OutputValues       : @retval I2C_Return which is return stauts for I2C read operation, HAL_TIMEOUT if the 1-Wire
+**                       line stays busy for DS2484_POLL_MAX reads.
+******************************************************************************/
+HAL_StatusTypeDef ow_wait_idle_ds2484(uint8_t *p_status) {
+    HAL_StatusTypeDef I2C_Return = HAL_OK;
+    uint8_t Status = DS2484_REG_STS_1WB;
+
+    for (uint16_t polls = 0; polls < DS2484_POLL_MAX; polls++) {
+        ow_stats.i2c_transfers++;
+        I2C_Return = HAL_I2C_Master_Receive(DS2484_I2C, DS2484_ADDRESS_READ, &Status, 1, Time_OUT); // read status
+        if ((I2C_Return != HAL_OK) || !(Status & DS2484_REG_STS_1WB))
+            break;
+        ow_stats.busy_polls++;
+    }
+    if (p_status)
+        *p_status = Status;
+    if ((I2C_Return == HAL_OK) && (Status & DS2484_REG_STS_1WB))
+        I2C_Return = HAL_TIMEOUT;
+    return I2C_Return;
+}
+/******************************************************************************
+** Name               : @fn ow_read_data_ds2484
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function reads a byte from the 1-Wire line: "1-Wire Read Byte" command, wait for
+**                       its end, then set the read pointer and read the byte from the read data register in one
+**                       I2C transfer.
+**
+** Calling            : @Aus DS2431.c
+**
+** InputValues        : @param uint8_t *p_data which receives the byte read
+**
+** OutputValues       : @retval I2C_Return which is return stauts for I2C read/write operation.
+******************************************************************************/
+HAL_StatusTypeDef ow_read_data_ds2484(uint8_t *p_data) {
+    HAL_StatusTypeDef I2C_Return = HAL_OK;
+
+    I2C_Return = ow_read_byte_ds2484();
+    if (I2C_Return != HAL_OK)
+        return I2C_Return;
+    ow_stats.i2c_transfers++;
+    I2C_Return = HAL_I2C_Mem_Read(DS2484_I2C, DS2484_ADDRESS, DS2484_MEMADD_DATA, I2C_MEMADD_SIZE_16BIT, p_data, 1,
+                                  Time_OUT); // set read pointer and read databyte
+    return I2C_Return;
+}
+/******************************************************************************
+** Name               : @fn ow_read_block_ds2484
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function reads a block of bytes from the 1-Wire line, e.g. after a "Read Memory"
+**                       command of the ds2431, which sends its data until the next reset.
+**
+** Calling            : @Aus DS2431.c
+**
+** InputValues        : @param uint8_t *p_data which receives the bytes read
+**                             uint16_t Size which is the number of bytes to be read
+**
+** OutputValues       : @retval I2C_Return which is return stauts for I2C read/write operation, stops at the first
+**                       error.
+******************************************************************************/
+HAL_StatusTypeDef ow_read_block_ds2484(uint8_t *p_data, uint16_t Size) {
+    HAL_StatusTypeDef I2C_Return = HAL_OK;
+
+    for (uint16_t i = 0; (i < Size) && (I2C_Return == HAL_OK); i++)
+        I2C_Return = ow_read_data_ds2484(&p_data[i]);
+    return I2C_Return;
+}
+
+/******************************************************************************
+** Name               : @fn ow_set_speed_ds2484
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function selects the 1-Wire speed of the DS2484 by the 1WS bit of the device
+**                       configuration, the active pullup stays on. The configuration is written only if the speed
+**                       changes.
+**
+** Calling            : @Aus DS2431.c
+**
+** InputValues        : @param uint8_t b_overdrive which is 1 for overdrive and 0 for standard speed
+**
+** OutputValues       : @retval I2C_Return which is return stauts for I2C write operation.
+******************************************************************************/
+HAL_StatusTypeDef ow_set_speed_ds2484(uint8_t b_overdrive) {
+    if (ow_status == HAL_BUSY)
+        return HAL_BUSY; // asynchronous transaction running
+    uint8_t Device_Config[2];
+    HAL_StatusTypeDef I2C_Return = HAL_OK;
+
+    b_overdrive = b_overdrive ? 1 : 0;
+    if (b_overdrive == ow_overdrive)
+        return I2C_Return;
+
+    Device_Config[0] = DS2484_CMD_WRITE_CONFIG;
+    Device_Config[1] = DS2484_REG_CFG((DS2484_REG_CFG_APU & 0x0F) | (b_overdrive ? (DS2484_REG_CFG_1WS & 0x0F) : 0));
+    ow_stats.i2c_transfers++;
+    I2C_Return = HAL_I2C_Master_Transmit(DS2484_I2C, DS2484_ADDRESS, Device_Config, 2, Time_OUT); // configure devide
+    if (I2C_Return == HAL_OK)
+        ow_overdrive = b_overdrive;
     return I2C_Return;
 }
+/******************************************************************************
+** Name               : @fn ow_get_speed_ds2484
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function returns the selected 1-Wire speed of the DS2484.
+**
+** Calling            : @Aus DS2431.c
+**
+** InputValues        : @param none
+**
+** OutputValues       : @retval 1 for overdrive, 0 for standard speed.
+******************************************************************************/
+uint8_t ow_get_speed_ds2484(void) {
+    return ow_overdrive;
+}
+
+/******************************************************************************
+** Name               : @fn ow_async_start
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function starts a 1-Wire transaction without blocking. The transaction is given
+**                       as script of operations which is run by the I2C interrupts, each 1-Wire byte is finished by
+**                       polling the 1WB bit of the status register instead of a fixed delay. The script and its
+**                       buffers have to stay valid until the transaction is done. The deadline of the transaction
+**                       follows from its bytes and delays, it is checked by ow_async_process().
+**
+** Calling            : @Aus DS2431.c
+**
+** InputValues        : @param const ow_op_t *p_ops which is the script of the transaction
+**                             uint8_t num_ops which is the number of operations of the script
+**                             ow_async_cb_t *p_cb which is called when the transaction is done, may be NULL
+**
+** OutputValues       : @retval HAL_OK if the transaction started, HAL_BUSY if a transaction is already running.
+******************************************************************************/
+HAL_StatusTypeDef ow_async_start(const ow_op_t *p_ops, uint8_t num_ops, ow_async_cb_t *p_cb) {
+    if ((ow_state != OW_STATE_IDLE) || (ow_status == HAL_BUSY))
+        return HAL_BUSY;
+
+    p_ow_ops = p_ops;
+    ow_num_ops = num_ops;
+    ow_op_idx = 0;
+    ow_byte_idx = 0;
+    p_ow_cb = p_cb;
+    ow_timeout = DS2484_ASYNC_TIMEOUT;
+    for (uint8_t i = 0; i < num_ops; i++) {
+        if (p_ops[i].type == OW_OP_DELAY)
+            ow_timeout += p_ops[i].len;
+        else if ((p_ops[i].type == OW_OP_WRITE) || (p_ops[i].type == OW_OP_READ))
+            ow_timeout += (uint32_t)p_ops[i].len * DS2484_ASYNC_TIMEOUT_BYTE;
+    }
+    ow_start_tick = HAL_GetTick();
+    ow_status = HAL_BUSY;
+    TRACE1(TRACE_OW_START, num_ops);
+    ow_async_op();
+    return HAL_OK;
+}
+
+/******************************************************************************
+** Name               : @fn ow_async_busy
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function checks if an asynchronous 1-Wire transaction is running.
+**
+** Calling            : @remark general use
+**
+** InputValues        : @param none
+**
+** OutputValues       : @retval 1 if a transaction is running, 0 if not.
+******************************************************************************/
+uint8_t ow_async_busy(void) {
+    return (ow_status == HAL_BUSY);
+}
+
+/******************************************************************************
+** Name               : @fn ow_async_status
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function returns the result of the last asynchronous 1-Wire transaction.
+**
+** Calling            : @remark general use
+**
+** InputValues        : @param none
+**
+** OutputValues       : @retval HAL_BUSY while running, otherwise the result of the transaction.
+******************************************************************************/
+HAL_StatusTypeDef ow_async_status(void) {
+    return ow_status;
+}
+
+/******************************************************************************
+** Name               : @fn ow_async_process
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function continues a transaction after the delay of an OW_OP_DELAY and aborts
+**                       it when its deadline has passed, e.g. when an I2C interrupt never came.
+**
+** Calling            : @Aus main loop
+**
+** InputValues        : @param none
+**
+** OutputValues       : @retval none
+******************************************************************************/
+void ow_async_process(void) {
+    if ((ow_state != OW_STATE_IDLE) && ((HAL_GetTick() - ow_start_tick) >= ow_timeout)) {
+        ow_async_abort();
+        return;
+    }
+    if ((ow_state == OW_STATE_DELAY) && ((HAL_GetTick() - ow_delay_tick) >= p_ow_ops[ow_op_idx].len))
+        ow_async_next();
+}
+
+/******************************************************************************
+** Name               : @fn ow_async_abort
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function aborts a transaction which missed its deadline. The I2C peripheral is
+**                       initialized again, which stops the running transfer, and the DS2484 is reset and set up,
+**                       which ends the 1-Wire activity and selects standard speed. The transaction finishes with
+**                       HAL_TIMEOUT.
+**
+** Calling            : @remark ow_async_process
+**
+** InputValues        : @param none
+**
+** OutputValues       : @retval none
+******************************************************************************/
+static void ow_async_abort(void) {
+    uint32_t primask = __get_PRIMASK();
+
+    /* the I2C callbacks ignore the transfer from now on */
+    __disable_irq();
+    if (ow_state == OW_STATE_IDLE) {
+        __set_PRIMASK(primask); // finished meanwhile
+        return;
+    }
+    ow_state = OW_STATE_IDLE;
+    ow_status = HAL_TIMEOUT; // allows the blocking setup below
+    __set_PRIMASK(primask);
+
+    ow_stats.timeouts++;
+    HAL_I2C_DeInit(DS2484_I2C);
+    HAL_I2C_Init(DS2484_I2C);
+    ow_setup_ds2484();
+    ow_async_finish(HAL_TIMEOUT);
+}
+
+/******************************************************************************
+** Name               : @fn ow_async_op
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function starts the actual byte of the actual operation of the script.
+**
+** Calling            : @remark asynchronous transaction engine
+**
+** InputValues        : @param none
+**
+** OutputValues       : @retval none
+******************************************************************************/
+static void ow_async_op(void) {
+    const ow_op_t *p_op;
+    uint16_t size = 1;
+
+    if (ow_op_idx >= ow_num_ops) {
+        ow_async_finish(HAL_OK);
+        return;
+    }
+
+    p_op = &p_ow_ops[ow_op_idx];
+    switch (p_op->type) {
+    case OW_OP_RESET:
+        ow_tx[0] = DS2484_CMD_1WIRE_RESET;
+        ow_stats.ow_resets++;
+        break;
+    case OW_OP_WRITE:
+        if (ow_byte_idx >= p_op->len) {
+            ow_async_next();
+            return;
+        }
+        ow_tx[0] = DS2484_CMD_1WIRE_WRITE_BYTE;
+        ow_tx[1] = p_op->p_data[ow_byte_idx];
+        ow_stats.ow_bytes++;
+        size = 2;
+        break;
+    case OW_OP_READ:
+        if (ow_byte_idx >= p_op->len) {
+            ow_async_next();
+            return;
+        }
+        ow_tx[0] = DS2484_CMD_1WIRE_READ_BYTE;
+        ow_stats.ow_bytes++;
+        break;
+    case OW_OP_DELAY:
+        ow_delay_tick = HAL_GetTick();
+        ow_state = OW_STATE_DELAY;
+        return;
+    case OW_OP_SPEED:
+        ow_tx[0] = DS2484_CMD_WRITE_CONFIG;
+        ow_tx[1] = DS2484_REG_CFG((DS2484_REG_CFG_APU & 0x0F) | (p_op->len ? (DS2484_REG_CFG_1WS & 0x0F) : 0));
+        ow_state = OW_STATE_CFG;
+        ow_stats.i2c_transfers++;
+        if (HAL_I2C_Master_Transmit_IT(DS2484_I2C, DS2484_ADDRESS, ow_tx, 2) != HAL_OK)
+            ow_async_finish(HAL_ERROR);
+        return;
+    default:
+        ow_async_finish(HAL_ERROR);
+        return;
+    }
+
+    ow_state = OW_STATE_CMD;
+    ow_stats.i2c_transfers++;
+    if (HAL_I2C_Master_Transmit_IT(DS2484_I2C, DS2484_ADDRESS, ow_tx, size) != HAL_OK)
+        ow_async_finish(HAL_ERROR);
+}
+
+/******************************************************************************
+** Name               : @fn ow_async_next
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function starts the next operation of the script.
+**
+** Calling            : @remark asynchronous transaction engine
+**
+** InputValues        : @param none
+**
+** OutputValues       : @retval none
+******************************************************************************/
+static void ow_async_next(void) {
+    ow_op_idx++;
+    ow_byte_idx = 0;
+    ow_async_op();
+}
+
+/******************************************************************************
+** Name               : @fn ow_async_finish
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function finishes the transaction and calls the completion callback.
+**
+** Calling            : @remark asynchronous transaction engine
+**
+** InputValues        : @param HAL_StatusTypeDef status which is the result of the transaction
+**
+** OutputValues       : @retval none
+******************************************************************************/
+static void ow_async_finish(HAL_StatusTypeDef status) {
+    ow_async_cb_t *p_cb = p_ow_cb;
+
+    p_ow_cb = NULL;
+    ow_state = OW_STATE_IDLE;
+    ow_status = status;
+    TRACE1(TRACE_OW_DONE, status);
+    if (p_cb)
+        p_cb(status);
+}
+
+/******************************************************************************
+** Name               : @fn HAL_I2C_MasterTxCpltCallback
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function continues the transaction after a command was transmitted.
+**
+** Calling            : @remark I2C event interrupt
+**
+** InputValues        : @param I2C_HandleTypeDef *hi2c
+**
+** OutputValues       : @retval none
+******************************************************************************/
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c) {
+    HAL_StatusTypeDef I2C_Return = HAL_OK;
+
+    if (hi2c != DS2484_I2C)
+        return;
+
+    if (ow_state == OW_STATE_CMD) {
+        /* the read pointer is at the status register after a 1-Wire command */
+        ow_polls = 0;
+        ow_state = OW_STATE_POLL;
+        ow_stats.i2c_transfers++;
+        I2C_Return = HAL_I2C_Master_Receive_IT(DS2484_I2C, DS2484_ADDRESS_READ, &ow_sts, 1);
+    } else if (ow_state == OW_STATE_CFG) {
+        ow_overdrive = p_ow_ops[ow_op_idx].len ? 1 : 0;
+        ow_async_next();
+        return;
+    }
+
+    if (I2C_Return != HAL_OK)
+        ow_async_finish(HAL_ERROR);
+}
+
+/******************************************************************************
+** Name               : @fn HAL_I2C_MasterRxCpltCallback
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function continues the transaction after a register was read.
+**
+** Calling            : @remark I2C event interrupt
+**
+** InputValues        : @param I2C_HandleTypeDef *hi2c
+**
+** OutputValues       : @retval none
+******************************************************************************/
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c) {
+    HAL_StatusTypeDef I2C_Return = HAL_OK;
+
+    if (hi2c != DS2484_I2C)
+        return;
+
+    if (ow_state == OW_STATE_POLL) {
+        if (ow_sts & DS2484_REG_STS_1WB) {
+            /* 1-Wire line still busy, read the status again */
+            if (++ow_polls > DS2484_POLL_MAX) {
+                ow_async_finish(HAL_TIMEOUT);
+                return;
+            }
+            ow_stats.i2c_transfers++;
+            ow_stats.busy_polls++;
+            I2C_Return = HAL_I2C_Master_Receive_IT(DS2484_I2C, DS2484_ADDRESS_READ, &ow_sts, 1);
+        } else {
+            switch (p_ow_ops[ow_op_idx].type) {
+            case OW_OP_RESET:
+                if (!(ow_sts & DS2484_REG_STS_PPD) || (ow_sts & DS2484_REG_STS_SD)) {
+                    ow_async_finish(HAL_ERROR); // no device
+                    return;
+                }
+                ow_async_next();
+                return;
+            case OW_OP_READ:
+                ow_state = OW_STATE_DATA;
+                ow_stats.i2c_transfers++;
+                I2C_Return = HAL_I2C_Mem_Read_IT(DS2484_I2C, DS2484_ADDRESS, DS2484_MEMADD_DATA, I2C_MEMADD_SIZE_16BIT,
+                                                 &p_ow_ops[ow_op_idx].p_data[ow_byte_idx], 1);
+                break;
+            default:
+                ow_byte_idx++;
+                ow_async_op();
+                return;
+            }
+        }
+    }
+
+    if (I2C_Return != HAL_OK)
+        ow_async_finish(HAL_ERROR);
+}
+
+/******************************************************************************
+** Name               : @fn HAL_I2C_MemRxCpltCallback
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function continues the transaction after a byte was read from the read data
+**                       register.
+**
+** Calling            : @remark I2C event interrupt
+**
+** InputValues        : @param I2C_HandleTypeDef *hi2c
+**
+** OutputValues       : @retval none
+******************************************************************************/
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c) {
+    if ((hi2c != DS2484_I2C) || (ow_state != OW_STATE_DATA))
+        return;
+
+    ow_byte_idx++;
+    ow_async_op();
+}
+
+/******************************************************************************
+** Name               : @fn HAL_I2C_ErrorCallback
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function aborts the transaction on an I2C error, e.g. a NACK of the DS2484.
+**
+** Calling            : @remark I2C error interrupt
+**
+** InputValues        : @param I2C_HandleTypeDef *hi2c
+**
+** OutputValues       : @retval none
+******************************************************************************/
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) {
+    if ((hi2c == DS2484_I2C) && (ow_state != OW_STATE_IDLE))
+        ow_async_finish(HAL_ERROR);
+}
+
+/******************************************************************************
+** Name               : @fn ow_get_stats_ds2484
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function returns the bus statistics since reset or the last
+**                       ow_clear_stats_ds2484(), of blocking and asynchronous transactions. They allow to compare
+**                       driver changes on the target, e.g. the transfers needed for the boot read of the EEPROM.
+**
+** Calling            : @Aus boot.c
+**
+** InputValues        : @param ow_stats_t *p_stats which receives the statistics
+**
+** OutputValues       : @retval none
+******************************************************************************/
+void ow_get_stats_ds2484(ow_stats_t *p_stats) {
+    *p_stats = ow_stats;
+}
+
+/******************************************************************************
+** Name               : @fn ow_clear_stats_ds2484
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function clears the bus statistics.
+**
+** Calling            : @remark general use
+**
+** InputValues        : @param none
+**
+** OutputValues       : @retval none
+******************************************************************************/
+void ow_clear_stats_ds2484(void) {
+    memset(&ow_stats, 0, sizeof(ow_stats));
+}
@@ -8,6 +8,9 @@
  ******************************************************************************
  */
 
+#ifndef _DS2484_H
+#define _DS2484_H
+
 #include "stdint.h"
 #include "stm32g4xx_hal.h"
 #include "stm32g4xx_hal_i2c.h"
@@ -24,16 +27,24 @@ HAL_StatusTypeDef ow_single_bit_ds2484(void);
 HAL_StatusTypeDef ow_write_byte_ds2484(uint8_t Byte_Data);
 HAL_StatusTypeDef ow_read_byte_ds2484(void);
 HAL_StatusTypeDef ow_set_read_pointer_read_data_register(void);
-HAL_StatusTypeDef ow_triplet_ds2431(void);
+HAL_StatusTypeDef ow_triplet_ds2484(uint8_t b_dir, uint8_t *p_status);
 HAL_StatusTypeDef ow_set_read_pointer_ds2484(uint8_t Register_Code);
 HAL_StatusTypeDef ow_read_register_ds2484(uint8_t Size);
 HAL_StatusTypeDef ow_setup_ds2484(void);
+HAL_StatusTypeDef ow_wait_idle_ds2484(uint8_t *p_status);
+HAL_StatusTypeDef ow_read_data_ds2484(uint8_t *p_data);
+HAL_StatusTypeDef ow_read_block_ds2484(uint8_t *p_data, uint16_t Size);
+HAL_StatusTypeDef ow_set_speed_ds2484(uint8_t b_overdrive);
+uint8_t ow_get_speed_ds2484(void);
 
 #define BKC_EN_DS2484       GPIO_PIN_12
 #define DS2484_ADDRESS      ((uint8_t)0X30) /* Device  Address */
 #define DS2484_ADDRESS_READ ((uint8_t)0X31) /* Device  Address */
 #define Time_OUT            1000
-#define DS2484_DELAY        1
+#define DS2484_POLL_MAX     500 /* maximum number of status reads while the 1-Wire line is busy */
+/* deadline of an asynchronous transaction: base time, time per 1-Wire byte and the OW_OP_DELAY times */
+#define DS2484_ASYNC_TIMEOUT      20 /* ms */
+#define DS2484_ASYNC_TIMEOUT_BYTE 2  /* ms, a byte at standard speed with its I2C transfers takes below 1 ms */
 
 #define DS2484_CMD_RESET            0xF0 /* No param */
 #define DS2484_CMD_SET_READ_PTR     0xE1 /* Param: DS2484_PTR_CODE_xxx */
@@ -51,6 +62,9 @@ HAL_StatusTypeDef ow_setup_ds2484(void);
 #define DS2484_PTR_CODE_DATA        0xE1
 #define DS2484_PTR_CODE_PORT_CONFIG 0xB4
 #define DS2484_PTR_CODE_CONFIG      0xC3
+/* Set Read Pointer to the read data register sent as 16-bit memory address of a memory read, so setting the
+ * pointer and reading the byte is one I2C transfer */
+#define DS2484_MEMADD_DATA ((uint16_t)((DS2484_CMD_SET_READ_PTR << 8) | DS2484_PTR_CODE_DATA))
 
 /*
  * Configure Register bit definitions
@@ -61,3 +75,55 @@ HAL_StatusTypeDef ow_setup_ds2484(void);
 #define DS2484_REG_CFG_SPU 0xB4 /* strong pull-up */
 #define DS2484_REG_CFG_PDN 0xD2 /*1-Wire Power-Down */
 #define DS2484_REG_CFG_APU 0xE1 /* active pull-up */
+/* configuration byte from the bits of the low nibbles, e.g. APU and 1WS for overdrive with active pull-up */
+#define DS2484_REG_CFG(bits) ((uint8_t)(((bits) & 0x0F) | ((~(bits) & 0x0F) << 4)))
+
+/* Status register bit definitions */
+#define DS2484_REG_STS_1WB 0x01 /* 1-Wire busy */
+#define DS2484_REG_STS_PPD 0x02 /* presence pulse detected */
+#define DS2484_REG_STS_SD  0x04 /* short detected */
+#define DS2484_REG_STS_SBR 0x20 /* single bit result of the triplet */
+#define DS2484_REG_STS_TSB 0x40 /* triplet second bit */
+#define DS2484_REG_STS_DIR 0x80 /* branch direction taken by the triplet */
+
+// #############  Asynchronous 1-Wire transactions  ###################
+
+/* operations of a 1-Wire transaction script */
+typedef enum {
+    OW_OP_RESET, // 1-Wire reset, fails without presence pulse
+    OW_OP_WRITE, // write len bytes from p_data
+    OW_OP_READ,  // read len bytes into p_data
+    OW_OP_DELAY, // wait len ms, e.g. for tPROG of the EEPROM
+    OW_OP_SPEED  // switch the DS2484 to overdrive (len=1) or standard speed (len=0)
+} ow_op_type_t;
+
+typedef struct {
+    ow_op_type_t type;
+    uint8_t *p_data;
+    uint8_t len;
+} ow_op_t;
+
+/* completion callback, called in interrupt context or from ow_async_process(), e.g. with HAL_TIMEOUT when the
+ * transaction missed its deadline */
+typedef void(ow_async_cb_t)(HAL_StatusTypeDef status);
+
+HAL_StatusTypeDef ow_async_start(const ow_op_t *p_ops, uint8_t num_ops, ow_async_cb_t *p_cb);
+uint8_t ow_async_busy(void);
+HAL_StatusTypeDef ow_async_status(void);
+void ow_async_process(void);
+
+// #############  Bus statistics  ###################
+
+/* counters of blocking and asynchronous transactions */
+typedef struct {
+    uint32_t i2c_transfers; // I2C transfers to and from the DS2484
+    uint32_t ow_resets;     // 1-Wire resets
+    uint32_t ow_bytes;      // 1-Wire bytes written and read
+    uint32_t busy_polls;    // status reads with the 1-Wire line still busy
+    uint32_t timeouts;      // asynchronous transactions aborted at their deadline
+} ow_stats_t;
+
+void ow_get_stats_ds2484(ow_stats_t *p_stats);
+void ow_clear_stats_ds2484(void);
+
+#endif // _DS2484_H
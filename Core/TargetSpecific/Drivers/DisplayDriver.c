@@ -10,6 +10,15 @@ extern DMA_HandleTypeDef DisplayDmaHandle;
 
 volatile uint8_t TransmissionActive;
 
+// Display reset, the reset pulse runs while the other peripherals are initialized
+#define DISPLAY_RESET_TIME     100  // ms, duration of the reset pulse and wait time after the reset
+#define DISPLAY_RESET_IDLE     0
+#define DISPLAY_RESET_ACTIVE   1
+#define DISPLAY_RESET_RELEASED 2
+
+static uint32_t ResetTick;
+static uint8_t  ResetState = DISPLAY_RESET_IDLE;
+
 
 // SSD1331
 static void DisplayDriver_SsdSendCommand(uint8_t command);
@@ -35,12 +44,36 @@ void DisplayDriver_DisplayOff(void)
   HAL_Delay(100);
 }
 
-void DisplayDriver_DisplayReset(void)
+void DisplayDriver_DisplayResetStart(void)
 {
   HAL_GPIO_WritePin(DISPLAY_RESET_GPIO_Port, DISPLAY_RESET_Pin, GPIO_PIN_RESET);
-  HAL_Delay(100);
-  HAL_GPIO_WritePin(DISPLAY_RESET_GPIO_Port, DISPLAY_RESET_Pin, GPIO_PIN_SET);
-  HAL_Delay(100);
+  ResetTick = HAL_GetTick();
+  ResetState = DISPLAY_RESET_ACTIVE;
+}
+
+void DisplayDriver_DisplayResetPoll(void)
+{
+  /* release the reset as soon as the reset pulse is long enough */
+  if ((ResetState == DISPLAY_RESET_ACTIVE) && ((HAL_GetTick() - ResetTick) >= DISPLAY_RESET_TIME))
+  {
+    HAL_GPIO_WritePin(DISPLAY_RESET_GPIO_Port, DISPLAY_RESET_Pin, GPIO_PIN_SET);
+    ResetTick = HAL_GetTick();
+    ResetState = DISPLAY_RESET_RELEASED;
+  }
+}
+
+void DisplayDriver_DisplayReset(void)
+{
+  /* wait only for the remaining time of a reset started by DisplayDriver_DisplayResetStart() */
+  if (ResetState == DISPLAY_RESET_IDLE)
+    DisplayDriver_DisplayResetStart();
+
+  while (ResetState == DISPLAY_RESET_ACTIVE)
+    DisplayDriver_DisplayResetPoll();
+
+  while ((HAL_GetTick() - ResetTick) < DISPLAY_RESET_TIME);
+
+  ResetState = DISPLAY_RESET_IDLE;
 }
 
 void DisplayDriver_DisplayInit(void)
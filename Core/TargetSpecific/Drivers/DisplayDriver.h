@@ -65,6 +65,8 @@ void DisplayDriver_PeripherieInit(void);
 void DisplayDriver_DisplayOn(void);
 void DisplayDriver_DisplayOff(void);
 void DisplayDriver_DisplayReset(void);
+void DisplayDriver_DisplayResetStart(void);
+void DisplayDriver_DisplayResetPoll(void);
 void DisplayDriver_DisplayInit(void);
 void DisplayDriver_TransmitRectangle(const uint16_t *bitmap, uint16_t posx, uint16_t posy, uint16_t sizex, uint16_t sizey);
 int  DisplayDriver_TransmitActive(void);
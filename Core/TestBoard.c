@@ -47,6 +47,7 @@
 // ...
 #include "DS2484.h"
 #include "DS2431.h"
+#include "led.h"
 
 #include <string.h>
 #include "stm32g4xx_it.h"
@@ -54,9 +55,12 @@
 // END of project specific includes
 
 /* NO MORE DEFINITIONS */
+#define TEST_TICK_MS     10     // ms, unit of the timeouts in TestBoard.h
+#define TEST_BKC_ADDRESS 0x0000 // row written and read back by the BKC test, TEST of page 1
+#define TEST_BKC_PATTERN 0xAAAA
+#define TEST_REPORT_LEN  48 // length of a line of the timing report
 /*** Definition of variables *************************************************/
 /* Private variables ---------------------------------------------------------*/
-extern param_info_to_gui mapro_to_gui_update_param;
 extern uint8_t rx_buff[8]; // used for CAN receive message
 test_result_status_t TestResult;
 test_state_status_t TestState;
@@ -66,15 +70,54 @@ uint32_t Test_State_for_display;
 uint8_t KeyTestCompletflag = 0;
 uint8_t TestMode = 0;
 uint8_t PassFailflg = 0;
-LED_Blink_on_off_t LEDResultDisplay = InitOnOff; // 0
-uint16_t TestModeTimeout = 0;
-uint16_t TestModeLEDTimeout = 0;
 uint8_t Test_Tx_Buff[8];
 uint16_t KeyPressDetect = 0;
-HAL_StatusTypeDef TestBKCstatus;
-uint64_t test_temp = 0x0;
 test_stage_t e_TestStage = NoState;
 
+/* step of the test sequence, all steps run concurrently and each call does bounded work */
+typedef struct {
+    test_stage_t stage;                       // first stage covered by the step
+    const char *p_name;                       // name in the progress output and the timing report
+    void (*p_begin)(void);                    // starts the step
+    test_state_t (*p_run)(uint8_t b_timeout); // continues the step, Completed when the result is known
+    uint32_t timeout;                         // ms, the step fails after this time
+} test_step_t;
+
+/* states of the BKC test */
+typedef enum {
+    TEST_BKC_SETUP,      // setup of the DS2484
+    TEST_BKC_WRITE,      // start of the row write
+    TEST_BKC_WRITE_WAIT, // row write running
+    TEST_BKC_READ,       // start of the read back
+    TEST_BKC_READ_WAIT   // read back running
+} test_bkc_state_t;
+
+static void TestCAN_begin(void);
+static test_state_t TestCAN_run(uint8_t b_timeout);
+static void TestBKC_begin(void);
+static test_state_t TestBKC_run(uint8_t b_timeout);
+static void TestBKC_ow_done(HAL_StatusTypeDef status);
+static void TestKey_begin(void);
+static test_state_t TestKey_run(uint8_t b_timeout);
+static void TestResult_step_done(test_stage_t stage);
+
+static const test_step_t test_steps[TEST_STEP_N] = {
+    {CANTest, "CAN", TestCAN_begin, TestCAN_run, CANTEST_TIMEOUT * TEST_TICK_MS},
+    {BKCTest, "BKC", TestBKC_begin, TestBKC_run, BKC_TIMEOUT * TEST_TICK_MS},
+    {UPKeyTest, "Key", TestKey_begin, TestKey_run, KEY_TIMEOUT * TEST_TICK_MS},
+};
+
+/* state, begin and duration in ms of each step */
+static test_state_t test_step_state[TEST_STEP_N];
+static uint32_t test_step_tick[TEST_STEP_N];
+static uint32_t test_step_time[TEST_STEP_N];
+static uint32_t test_begin_tick;
+static uint32_t test_total_time;
+
+static test_bkc_state_t test_bkc_state;
+static volatile HAL_StatusTypeDef test_bkc_ow_status; // result of the running 1-Wire transaction
+static uint8_t test_bkc_row[BYTES_PER_ROW];
+
 /******************************************************************************
 ** Name               : @fn TestmodeStart
 **
@@ -91,205 +134,318 @@ void TestmodeStart(void) {
 
     TestMode = 1;
     // reusing mapro_to_gui_update_param by GUI to enter into test mode
-    mapro_to_gui_update_param.ID = rx_buff[0];
-    mapro_to_gui_update_param.unit_id = rx_buff[1];
-    mapro_to_gui_update_param.type = rx_buff[2];
-    mapro_to_gui_update_param.image = rx_buff[3];
-    mapro_to_gui_update_param.flag = MSG_0x110_setID;
+    param_set_test_mode(rx_buff[0], rx_buff[1], rx_buff[2], rx_buff[3]);
+    for (uint8_t i = 0; i < TEST_STEP_N; i++) {
+        test_step_state[i] = NotDone;
+    }
+    test_begin_tick = HAL_GetTick();
     e_TestStage = CANTest;
-    TestModeLEDTimeout = LED_NORMAL_TIMEOUT; // 100; // 1s toggle LED
-    TestModeTimeout = CANTEST_TIMEOUT;       // 100 - 1sec, 5 sec
-    TestState.CANTestState = InProgress;
+    /* torch LEDs blink during the test, status and error LED blink three times */
+    led_set_pattern(E_LED_EXT, &led_pattern_blink);
+    led_set_pattern(E_LED_RH1, &led_pattern_blink);
+    led_set_pattern(E_LED_RH2, &led_pattern_blink);
+    led_set_pattern(E_LED_STAT, &led_pattern_blink_3);
+    led_set_pattern(E_LED_ERR, &led_pattern_blink_3);
     Serial_COM_PutString("\r\nEntering Test Mode ");
-    Serial_COM_PutString("\r\nCAN TEST in Progress");
-    rx_buff[0] = 'C'; //
-    rx_buff[1] = 'A';
-    rx_buff[2] = 'N';
-    rx_buff[3] = 'T';
-    rx_buff[4] = 'E';
-    rx_buff[5] = 'S';
-    rx_buff[6] = 'T';
-    rx_buff[7] = 0;
-    fdcan2_send(MSG_0x200, rx_buff);
 }
 
 /******************************************************************************
-** Name               : @fn TIM15_interrupt_handler
+** Name               : @fn BoardTest
 **
-** Created from /on   : @author SPA / @date 17.01.2024
+** Created from /on   : @author SPA / @date 30.10.2023
 **
-** Description        : @brief Test start
+** Description        : @brief Runs the test sequence. The steps of test_steps are independent and run
+**                             concurrently, each call continues every running step by a bounded amount of
+**                             work. The duration of each step is recorded for the timing report.
 **
-** Calling            : @remark called in fdcand2
+** Calling            : @remark called in while(1)
 **
 ** InputValues        : @param  none
 ** OutputValues       : @retval none
 ******************************************************************************/
-void TIM15_interrupt_handler(void) {
-    static uint8_t toggleLedCount = 0;
-    static uint16_t toggleLEDtime = 0;
-
-    if (TestModeTimeout > 0)
-        TestModeTimeout--;
-    if (TestModeLEDTimeout > 0) {
-        TestModeLEDTimeout--;
-    }
-    if (toggleLEDtime > 0) {
-        toggleLEDtime--;
+void BoardTest(void) {
+    uint32_t tick = HAL_GetTick();
+    test_stage_t stage = TestOver;
+
+    if (TestMode != 1 || e_TestStage == NoState || e_TestStage == TestOver) {
+        return;
     }
-    if (TestMode == 1) { //&& e_TestStage != TestOver && e_TestStage != NoState) {
-        if (toggleLEDtime == 0) {
-            toggleLEDtime = LED_NORMAL_TIMEOUT; // 1sec
-            Toggle_LED(LED_1_GPIO_Port, LED_1_Pin);
-            Toggle_LED(LED_2_GPIO_Port, LED_2_Pin);
-            Toggle_LED(LED_EXT_GPIO_Port, LED_EXT_Pin);
+
+    for (uint8_t i = 0; i < TEST_STEP_N; i++) {
+        const test_step_t *p_step = &test_steps[i];
+
+        if (test_step_state[i] == NotDone) {
+            Serial_COM_PutString("\r\n");
+            Serial_COM_PutString((char *)p_step->p_name);
+            Serial_COM_PutString(" Test in Progress ");
+            test_step_tick[i] = tick;
+            test_step_state[i] = InProgress;
+            p_step->p_begin();
         }
-        if (TestModeLEDTimeout == 0 && LEDResultDisplay == InitOnOff) { // 0
-            TestModeLEDTimeout = LED_NORMAL_TIMEOUT;                    // 1sec
-            Toggle_LED(LED_STAT_GPIO_Port, LED_STAT_Pin);
-            Toggle_LED(LED_ERR_GPIO_Port, LED_ERR_Pin);
-            toggleLedCount++;
-            if (toggleLedCount > 5) {
-                LEDResultDisplay = Off; // 2;
-                toggleLedCount = 0;
-                TestModeLEDTimeout = 0;
-                Reset_LED(LED_STAT_GPIO_Port, LED_STAT_Pin);
-                Reset_LED(LED_ERR_GPIO_Port, LED_ERR_Pin);
-            }
-        } else if (LEDResultDisplay == OnOff) { // 1
-            if (TestModeLEDTimeout == 0) {
-                LEDResultDisplay = Off; // 2;
-                PassFailflg = 0;
-                Reset_LED(LED_STAT_GPIO_Port, LED_STAT_Pin);
-                Reset_LED(LED_ERR_GPIO_Port, LED_ERR_Pin);
+        if (test_step_state[i] == InProgress) {
+            if (p_step->p_run((tick - test_step_tick[i]) >= p_step->timeout) == Completed) {
+                test_step_time[i] = HAL_GetTick() - test_step_tick[i];
+                test_step_state[i] = Completed;
+                TestResult_step_done(p_step->stage);
+            } else if (p_step->stage < stage) {
+                stage = p_step->stage;
             }
         }
     }
+
+    e_TestStage = stage;
+    if (e_TestStage == TestOver) {
+        test_total_time = HAL_GetTick() - test_begin_tick;
+        TestResult_CAN_Message_Send();
+        TestResult_summary();
+    }
 }
+
 /******************************************************************************
-** Name               : @fn BoardTest
+** Name               : @fn TestCAN_begin
 **
-** Created from /on   : @author SPA / @date 30.10.2023
+** Created from /on   : @author / @date 18.10.2026
 **
-** Description        : @brief Test the Board Test
+** Description        : @brief Starts the CAN test, the test message is acknowledged by the partner with 0x200
 **
-** Calling            : @remark called in while(1)
+** Calling            : @remark BoardTest, by test_steps
 **
 ** InputValues        : @param  none
 ** OutputValues       : @retval none
 ******************************************************************************/
-void BoardTest(void) {
+static void TestCAN_begin(void) {
+    uint8_t data[8] = {'C', 'A', 'N', 'T', 'E', 'S', 'T', 0};
 
-    uint16_t sentdata, recvdata;
+    TestState.CANTestState = InProgress;
+    fdcan2_send(MSG_0x200, data);
+}
 
-    if (TestMode == 1 && e_TestStage != TestOver) {
-        switch (e_TestStage) {
-        case NoState:
-            break;
-        case CANTest: {
-            TestMode_KeyDetect();
-            if (TestState.CANTestState == Completed && TestResult.CANTestResult == Pass) {
-                e_TestStage = BKCTest;
-            }
-            if (TestModeTimeout == 0 && TestState.CANTestState == InProgress) {
-                TestResult.CANTestResult = Fail;
-                TestState.CANTestState = Completed;
-                e_TestStage = BKCTest;
-                // Serial_COM_PutString("\r\nCAN Test Completed, FAIL ");
-            }
+/******************************************************************************
+** Name               : @fn TestCAN_run
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief Waits for the acknowledge, which is taken over by the FDCAN2 interrupt
+**
+** Calling            : @remark BoardTest, by test_steps
+**
+** InputValues        : @param  uint8_t b_timeout. 1 = step timed out
+** OutputValues       : @retval test_state_t. Completed when the result is known
+******************************************************************************/
+static test_state_t TestCAN_run(uint8_t b_timeout) {
+    if (TestState.CANTestState == Completed) {
+        return Completed;
+    }
+    if (b_timeout) {
+        TestResult.CANTestResult = Fail;
+        TestState.CANTestState = Completed;
+        return Completed;
+    }
+    return InProgress;
+}
 
-            if (e_TestStage == BKCTest) {
-                // BKC Test
-                TestResult_LEDToggle(CANTest);
-                if (PassFailflg == FAIL_BLINK_COUNT) {
-                    LEDResultDisplay = OnOff;                    // 1;
-                    TestModeLEDTimeout = LED_NORMAL_TIMEOUT * 5; // 5sec ON
-                    Reset_LED(LED_STAT_GPIO_Port, LED_STAT_Pin);
-                    Set_LED(LED_ERR_GPIO_Port, LED_ERR_Pin);
-                }
-                TestResult_CAN_Message_Send();
-                Serial_COM_PutString("\r\nBKC TEST in Progress ");
-                TestModeTimeout = BKC_TIMEOUT; // 1 sec  = 100, 60 = 1min 3 = 3 min
-                TestState.BKCTestState = InProgress;
-                TestBKCstatus = HAL_OK;
-                ow_setup_ds2484();
-            }
-        } break;
-        case BKCTest: {
-            TestMode_KeyDetect();
-            sentdata = (uint16_t)0xAAAAAAAAAAAAAAAA;
-            TestBKCstatus = ow_write_memory_row_ds2431(1, sentdata);
-            // HAL_Delay(2000);
-            TestMode_KeyDetect();
-            if (TestBKCstatus != HAL_OK) {
-                TestResult.BKCTestResult = Fail;
-                TestState.BKCTestState = Completed;
-                e_TestStage = UPKeyTest;
-                // Serial_COM_PutString("\r\nBKC Test Completed, FAIL ");
-            } else {
-                TestBKCstatus = HAL_OK;
-                test_temp = 0;
-                TestBKCstatus = ow_read_memory_row_ds2431(1, &test_temp);
-                // HAL_Delay(10000);
-                TestMode_KeyDetect();
-                if (TestBKCstatus != HAL_OK) {
-                    TestResult.BKCTestResult = Fail;
-                    TestState.BKCTestState = Completed;
-                    // Serial_COM_PutString("\r\nBKC Test Completed, FAIL ");
-                    e_TestStage = UPKeyTest;
-                }
-                recvdata = (uint16_t)test_temp;
-                if (recvdata != sentdata) {
-                    TestResult.BKCTestResult = Fail;
-                    TestState.BKCTestState = Completed;
-                    // Serial_COM_PutString("\r\nBKC Test Completed, FAIL ");
-                    e_TestStage = UPKeyTest;
-                } else {
-                    TestResult.BKCTestResult = Pass;
-                    TestState.BKCTestState = Completed;
-                    e_TestStage = UPKeyTest;
-                }
-            } // else
+/******************************************************************************
+** Name               : @fn TestBKC_begin
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief Starts the BKC test
+**
+** Calling            : @remark BoardTest, by test_steps
+**
+** InputValues        : @param  none
+** OutputValues       : @retval none
+******************************************************************************/
+static void TestBKC_begin(void) {
+    TestState.BKCTestState = InProgress;
+    test_bkc_state = TEST_BKC_SETUP;
+}
+
+/******************************************************************************
+** Name               : @fn TestBKC_run
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief Continues the BKC test. The test pattern is written into a row of the EEPROM and
+**                             read back by asynchronous 1-Wire transactions, so the key detection and the GUI
+**                             keep running meanwhile.
+**
+** Calling            : @remark BoardTest, by test_steps
+**
+** InputValues        : @param  uint8_t b_timeout. 1 = step timed out
+** OutputValues       : @retval test_state_t. Completed when the result is known
+******************************************************************************/
+static test_state_t TestBKC_run(uint8_t b_timeout) {
+    test_result_t result = Fail;
+
+    if (b_timeout) {
+        TestResult.BKCTestResult = Fail;
+        TestState.BKCTestState = Completed;
+        return Completed;
+    }
+
+    switch (test_bkc_state) {
+    case TEST_BKC_SETUP:
+        if (ow_async_busy()) {
+            break;
         }
-            if (e_TestStage == UPKeyTest) {
-
-                TestResult_LEDToggle(BKCTest);
-                if (PassFailflg == FAIL_BLINK_COUNT) {
-                    LEDResultDisplay = OnOff;                    // 1;
-                    TestModeLEDTimeout = LED_NORMAL_TIMEOUT * 5; // 5sec ON
-                    Reset_LED(LED_STAT_GPIO_Port, LED_STAT_Pin);
-                    Set_LED(LED_ERR_GPIO_Port, LED_ERR_Pin);
-                }
-                TestResult_CAN_Message_Send();
-                // UPKey Test
-                Serial_COM_PutString("\r\nKey Test in Progress ");
-                if (KeyTestCompletflag == 0) // Keytest completed flag
-                {
-                    TestModeTimeout = KEY_TIMEOUT; // 1 sec  = 100, 60 = 1min 2=2 min
-                    TestState.UPKeyTestState = InProgress;
-                    TestState.DOWNKeyTestState = InProgress;
-                    TestState.LEFTKeyTestState = InProgress;
-                    TestState.RIGHTKeyTestState = InProgress;
-                    TestState.StartWeldKeyTestState = InProgress;
-                }
-            }
+        ow_setup_ds2484();
+        test_bkc_state = TEST_BKC_WRITE;
+        break;
+
+    case TEST_BKC_WRITE:
+        test_bkc_ow_status = HAL_BUSY;
+        if (ow_write_mem_row_async_ds2431(Page1, TEST_BKC_PATTERN, TEST_BKC_ADDRESS, TestBKC_ow_done) == HAL_OK) {
+            test_bkc_state = TEST_BKC_WRITE_WAIT;
+        }
+        break;
+
+    case TEST_BKC_WRITE_WAIT:
+        if (test_bkc_ow_status == HAL_BUSY) {
             break;
-        case UPKeyTest:
-        case DOWNKeyTest:
-        case LEFTKeyTest:
-        case RIGHTKeyTest:
-        case STARTWELDKeyTest: {
-            TestMode_KeyDetect();
-            if (e_TestStage == TestOver) {
-                TestResult_CAN_Message_Send();
-                TestResult_summary();
-            }
-        } break;
+        }
+        if (test_bkc_ow_status != HAL_OK) {
+            TestResult.BKCTestResult = Fail;
+            TestState.BKCTestState = Completed;
+            return Completed;
+        }
+        test_bkc_state = TEST_BKC_READ;
+        break;
+
+    case TEST_BKC_READ:
+        memset(test_bkc_row, 0, sizeof(test_bkc_row));
+        test_bkc_ow_status = HAL_BUSY;
+        if (ow_read_memory_async_ds2431(TEST_BKC_ADDRESS, test_bkc_row, sizeof(test_bkc_row), TestBKC_ow_done) ==
+            HAL_OK) {
+            test_bkc_state = TEST_BKC_READ_WAIT;
+        }
+        break;
 
-        default:
+    case TEST_BKC_READ_WAIT:
+        if (test_bkc_ow_status == HAL_BUSY) {
             break;
-        } // switch
-    }     // Test Mode
+        }
+        if ((test_bkc_ow_status == HAL_OK) && ((test_bkc_row[0] | (test_bkc_row[1] << 8)) == TEST_BKC_PATTERN)) {
+            result = Pass;
+        }
+        TestResult.BKCTestResult = result;
+        TestState.BKCTestState = Completed;
+        return Completed;
+
+    default:
+        break;
+    }
+    return InProgress;
+}
+
+/******************************************************************************
+** Name               : @fn TestBKC_ow_done
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief Takes over the result of a 1-Wire transaction of the BKC test
+**
+** Calling            : @remark I2C interrupt
+**
+** InputValues        : @param  HAL_StatusTypeDef status
+** OutputValues       : @retval none
+******************************************************************************/
+static void TestBKC_ow_done(HAL_StatusTypeDef status) {
+    test_bkc_ow_status = status;
+}
+
+/******************************************************************************
+** Name               : @fn TestKey_begin
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief Starts the key test
+**
+** Calling            : @remark BoardTest, by test_steps
+**
+** InputValues        : @param  none
+** OutputValues       : @retval none
+******************************************************************************/
+static void TestKey_begin(void) {
+    TestState.UPKeyTestState = InProgress;
+    TestState.DOWNKeyTestState = InProgress;
+    TestState.LEFTKeyTestState = InProgress;
+    TestState.RIGHTKeyTestState = InProgress;
+    TestState.StartWeldKeyTestState = InProgress;
+}
+
+/******************************************************************************
+** Name               : @fn TestKey_run
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief Continues the key test, the keys not pressed until the timeout fail
+**
+** Calling            : @remark BoardTest, by test_steps
+**
+** InputValues        : @param  uint8_t b_timeout. 1 = step timed out
+** OutputValues       : @retval test_state_t. Completed when the result is known
+******************************************************************************/
+static test_state_t TestKey_run(uint8_t b_timeout) {
+    TestMode_KeyDetect();
+    if (b_timeout) {
+        if (TestState.UPKeyTestState == InProgress) {
+            TestResult.UPKeyTestResult = Fail;
+            TestState.UPKeyTestState = Completed;
+            TestResult_LEDToggle(UPKeyTest);
+            Serial_COM_PutString("\r\nUp Key Test Completed, FAIL ");
+        }
+        if (TestState.DOWNKeyTestState == InProgress) {
+            TestResult.DOWNKeyTestResult = Fail;
+            TestState.DOWNKeyTestState = Completed;
+            TestResult_LEDToggle(DOWNKeyTest);
+            Serial_COM_PutString("\r\nDown Key Test Completed, FAIL ");
+        }
+        if (TestState.LEFTKeyTestState == InProgress) {
+            TestResult.LEFTKeyTestResult = Fail;
+            TestState.LEFTKeyTestState = Completed;
+            TestResult_LEDToggle(LEFTKeyTest);
+            Serial_COM_PutString("\r\nLeft Key Test Completed, FAIL ");
+        }
+        if (TestState.RIGHTKeyTestState == InProgress) {
+            TestResult.RIGHTKeyTestResult = Fail;
+            TestState.RIGHTKeyTestState = Completed;
+            TestResult_LEDToggle(RIGHTKeyTest);
+            Serial_COM_PutString("\r\nRight Key Test Completed, FAIL ");
+        }
+        if (TestState.StartWeldKeyTestState == InProgress) {
+            TestResult.StartWeldKeyTestResult = Fail;
+            TestState.StartWeldKeyTestState = Completed;
+            TestResult_LEDToggle(STARTWELDKeyTest);
+            Serial_COM_PutString("\r\nTrigger Key Test Completed, FAIL ");
+        }
+        KeyTestCompletflag = 1;
+    }
+    return KeyTestCompletflag ? Completed : InProgress;
+}
+
+/******************************************************************************
+** Name               : @fn TestResult_step_done
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief Shows the result of a finished step by the LEDs and sends the test results
+**
+** Calling            : @remark BoardTest
+**
+** InputValues        : @param  test_stage_t stage of the step
+** OutputValues       : @retval none
+******************************************************************************/
+static void TestResult_step_done(test_stage_t stage) {
+    /* the keys are shown one by one when pressed */
+    if (stage == CANTest || stage == BKCTest) {
+        TestResult_LEDToggle(stage);
+    }
+    if (PassFailflg == FAIL_BLINK_COUNT) {
+        led_set_pattern(E_LED_STAT, &led_pattern_off);
+        led_set_pattern(E_LED_ERR, &led_pattern_fail); // 5sec ON
+    }
+    TestResult_CAN_Message_Send();
 }
 
 /******************************************************************************
@@ -323,11 +479,7 @@ void TestMode_Init(void) {
     TestState.StartWeldKeyTestState = NotDone;
 
     e_TestStage = NoState;
-    TestModeTimeout = 0;
-    TestModeLEDTimeout = 0;
     TestMode = 0;
-    MX_TIM15_Init();
-    HAL_TIM_Base_Start_IT(&htim15);
 }
 
 /******************************************************************************
@@ -384,56 +536,10 @@ void TestMode_KeyDetect(void) {
             TestResult_CAN_Message_Send();
         }
     }
-    if ((TestModeTimeout == 0 || KeyTestCompletflag == 1) &&
-        (TestState.CANTestState == Completed && TestState.BKCTestState == Completed)) {
-        if (TestState.UPKeyTestState == InProgress) {
-            TestResult.UPKeyTestResult = Fail;
-            TestState.UPKeyTestState = Completed;
-            TestResult_LEDToggle(UPKeyTest);
-            Serial_COM_PutString("\r\nUp Key Test Completed, FAIL ");
-            TestResult_CAN_Message_Send();
-        }
-        if (TestState.DOWNKeyTestState == InProgress) {
-            TestResult.DOWNKeyTestResult = Fail;
-            TestState.DOWNKeyTestState = Completed;
-            TestResult_LEDToggle(DOWNKeyTest);
-            Serial_COM_PutString("\r\nDown Key Test Completed, FAIL ");
-            TestResult_CAN_Message_Send();
-        }
-        if (TestState.LEFTKeyTestState == InProgress) {
-            TestResult.LEFTKeyTestResult = Fail;
-            TestState.LEFTKeyTestState = Completed;
-            TestResult_LEDToggle(LEFTKeyTest);
-            Serial_COM_PutString("\r\nLeft Key Test Completed, FAIL ");
-            TestResult_CAN_Message_Send();
-        }
-        if (TestState.RIGHTKeyTestState == InProgress) {
-            TestResult.RIGHTKeyTestResult = Fail;
-            TestState.RIGHTKeyTestState = Completed;
-            TestResult_LEDToggle(RIGHTKeyTest);
-            Serial_COM_PutString("\r\nRight Key Test Completed, FAIL ");
-            TestResult_CAN_Message_Send();
-        }
-        if (TestState.StartWeldKeyTestState == InProgress) {
-            TestResult.StartWeldKeyTestResult = Fail;
-            TestState.StartWeldKeyTestState = Completed;
-            TestResult_LEDToggle(STARTWELDKeyTest);
-            Serial_COM_PutString("\r\nTrigger Key Test Completed, FAIL ");
-            TestResult_CAN_Message_Send();
-        }
-        if (PassFailflg == FAIL_BLINK_COUNT) {
-            LEDResultDisplay = OnOff;                    // 1;
-            TestModeLEDTimeout = LED_NORMAL_TIMEOUT * 5; // 5sec ON
-            Reset_LED(LED_STAT_GPIO_Port, LED_STAT_Pin);
-            Set_LED(LED_ERR_GPIO_Port, LED_ERR_Pin);
-        }
-    }
     if (TestState.StartWeldKeyTestState == Completed && TestState.RIGHTKeyTestState == Completed &&
         TestState.LEFTKeyTestState == Completed && TestState.DOWNKeyTestState == Completed &&
         TestState.UPKeyTestState == Completed)
         KeyTestCompletflag = 1;
-    if (KeyTestCompletflag == 1 && TestState.CANTestState == Completed && TestState.BKCTestState == Completed)
-        e_TestStage = TestOver;
 }
 
 /******************************************************************************
@@ -503,10 +609,8 @@ void TestResult_LEDToggle(test_stage_t stageresult) {
     else if (stageresult == STARTWELDKeyTest && TestResult.StartWeldKeyTestResult == Fail)
         PassFailflg = FAIL_BLINK_COUNT;
     if (PassFailflg == PASS_BLINK_COUNT) {
-        LEDResultDisplay = OnOff;                // 1;
-        TestModeLEDTimeout = LED_NORMAL_TIMEOUT; // 1sec ON
-        Set_LED(LED_STAT_GPIO_Port, LED_STAT_Pin);
-        Reset_LED(LED_ERR_GPIO_Port, LED_ERR_Pin);
+        led_set_pattern(E_LED_STAT, &led_pattern_pass); // 1sec ON
+        led_set_pattern(E_LED_ERR, &led_pattern_off);
     }
 }
 
@@ -515,7 +619,7 @@ void TestResult_LEDToggle(test_stage_t stageresult) {
 **
 ** Created from /on   : @author SPA / @date 6.11.2023
 **
-** Description        : @brief Summary the result through serial
+** Description        : @brief Summary the result and the duration of the test steps through serial
 **
 ** Calling            : @remark in BoardTest() function
 **
@@ -523,6 +627,7 @@ void TestResult_LEDToggle(test_stage_t stageresult) {
 ** OutputValues       : @retval none
 ******************************************************************************/
 void TestResult_summary(void) {
+    char line[TEST_REPORT_LEN];
 
     Serial_COM_PutString("\r\n\t");
     Serial_COM_PutString("\r\nTest Summary: ");
@@ -557,6 +662,14 @@ void TestResult_summary(void) {
     else
         Serial_COM_PutString("\r\nTrigger Key - Fail ");
 
+    Serial_COM_PutString("\r\nTest time [ms]");
+    for (uint8_t i = 0; i < TEST_STEP_N; i++) {
+        snprintf(line, sizeof(line), "\r\n  %-8s %6lu", test_steps[i].p_name, (unsigned long)test_step_time[i]);
+        Serial_COM_PutString(line);
+    }
+    snprintf(line, sizeof(line), "\r\n  %-8s %6lu", "Total", (unsigned long)test_total_time);
+    Serial_COM_PutString(line);
+
     Serial_COM_PutString("\r\n -------End-----------");
 }
 
@@ -637,3 +750,35 @@ uint32_t Get_TestState(void) {
 
     return Test_State_for_display;
 }
+
+/******************************************************************************
+** Name               : @fn Get_TestTime
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief Returns the duration of a test step, the time elapsed so far while the step is
+**                             running. The entry TEST_STEP_N is the total test time.
+**
+** Calling            : @remark fdcan2 (CO_GET_TESTTIME)
+**
+** InputValues        : @param uint8_t index. Step in the order CAN, BKC, keys or TEST_STEP_N
+** OutputValues       : @retval uint32_t. Time in ms, 0 if not available
+******************************************************************************/
+uint32_t Get_TestTime(uint8_t index) {
+    uint32_t time = 0;
+
+    if (index < TEST_STEP_N) {
+        if (test_step_state[index] == Completed) {
+            time = test_step_time[index];
+        } else if (test_step_state[index] == InProgress) {
+            time = HAL_GetTick() - test_step_tick[index];
+        }
+    } else if (index == TEST_STEP_N) {
+        if (e_TestStage == TestOver) {
+            time = test_total_time;
+        } else if (e_TestStage != NoState) {
+            time = HAL_GetTick() - test_begin_tick;
+        }
+    }
+    return time;
+}
@@ -53,16 +53,14 @@ extern "C" {
     #define BKC_TIMEOUT        100 * 60 * 1 // 1 sec  = 100, 60 = 1min 1 = 3 min
     #define PASS_BLINK_COUNT   10
     #define FAIL_BLINK_COUNT   20
-    #define LED_TIMEOUT        50   // 500 ms
-    #define LED_NORMAL_TIMEOUT 100  // 1 sec
     #define TEST_MODE_T        0x54 // 0x54 correponds  to 'T',
     #define TEST_MODE_C        0x43 // 0x43 correspons to 'C'.
     #define TEST_MODE_2        0x32 // 0x32 correspons to '2'.
+    #define TEST_STEP_N        3    // steps of the test sequence: CAN, BKC, keys
 
 /* Exported types ------------------------------------------------------------*/
 /* USER CODE BEGIN ET */
 extern FDCAN_HandleTypeDef hfdcan2;
-extern TIM_HandleTypeDef htim15;
 
 /* USER CODE BEGIN EFP */
 
@@ -72,12 +70,6 @@ typedef enum {
     Fail     ///< "UP keyTest Flag"
 } test_result_t;
 
-typedef enum {
-    InitOnOff = 0, ///< "Led test Init on/off all led during Board Test"
-    OnOff,         ///< "After completion of test red/green blink based on test result"
-    Off            ///< "greeen/red led off"
-} LED_Blink_on_off_t;
-
 typedef enum {
     NoState,          ///< "No State "
     CANTest,          ///< "CAN Test"
@@ -134,8 +126,8 @@ void TestResult_summary(void);
 uint8_t Get_TestMode(void);
 uint32_t Get_Testresults(void);
 uint32_t Get_TestState(void);
+uint32_t Get_TestTime(uint8_t index);
 void TestmodeStart(void);
-void TIM15_interrupt_handler(void);
 
     #ifdef __cplusplus
 }
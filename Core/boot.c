@@ -0,0 +1,277 @@
+/*
+******************************************************************************
+* @file: boot.c
+* @author:
+* @brief: Boot sequence and boot time report.
+*         The fast phases run in main() before the main loop, the slow
+*         EEPROM phases run step by step in the main loop after the first
+*         frame was shown. The duration of each phase is recorded and
+*         reported over UART and on request over CAN.
+******************************************************************************
+*
+******************************************************************************
+*/
+
+/*** Include *****************************************************************/
+#include <stdio.h>
+
+#include "boot.h"
+#include "main.h"
+#include "DS2484.h"
+#include "DS2431.h"
+#include "weld_time.h"
+/* NO MORE DEFINITIONS */
+
+/*** Preprocessor definitions ************************************************/
+#define BOOT_REPORT_LEN 48 // length of a line of the boot time report
+
+/*** Definition of variables *************************************************/
+
+/* states of the boot sequence within the main loop */
+typedef enum {
+    E_BOOT_SM_FIRST_FRAME,
+    E_BOOT_SM_ROMID,
+    E_BOOT_SM_ROMID_WAIT,
+    E_BOOT_SM_SEARCH,
+    E_BOOT_SM_EEPROM,
+    E_BOOT_SM_EEPROM_WAIT,
+    E_BOOT_SM_REPORT,
+    E_BOOT_SM_DONE
+} boot_sm_t;
+
+static const char *p_boot_phase_names[E_BOOT_PHASE_N] = {"peripherals", "1-wire setup", "parameter cache", "GUI init",
+                                                         "first frame", "ROM ID",       "EEPROM pages"};
+
+static boot_sm_t boot_sm_state = E_BOOT_SM_FIRST_FRAME;
+static volatile HAL_StatusTypeDef boot_ow_status; // result of the running 1-Wire transaction
+
+/* begin and duration of the phases in ms */
+static uint32_t boot_phase_tick[E_BOOT_PHASE_N];
+static uint32_t boot_time[BOOT_TIME_N];
+
+/*** Prototypes of functions *************************************************/
+static void boot_report(void);
+static void boot_ow_done(HAL_StatusTypeDef status);
+
+/*** Definitions of functions ************************************************/
+
+/**********************************************************
+ ** Name            : boot_phase_begin
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Records the begin of a boot phase
+ **
+ ** Calling         : main, boot_process
+ **
+ ** InputValues     : boot_phase_t phase
+ ** OutputValues    : none
+ **********************************************************/
+void boot_phase_begin(boot_phase_t phase) {
+    boot_phase_tick[phase] = HAL_GetTick();
+}
+
+/**********************************************************
+ ** Name            : boot_phase_end
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Records the duration of a boot phase
+ **
+ ** Calling         : main, boot_process
+ **
+ ** InputValues     : boot_phase_t phase
+ ** OutputValues    : none
+ **********************************************************/
+void boot_phase_end(boot_phase_t phase) {
+    boot_time[phase] = HAL_GetTick() - boot_phase_tick[phase];
+}
+
+/**********************************************************
+ ** Name            : boot_process
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Runs the next step of the boot sequence. The ROM ID
+ **                   and the EEPROM pages are read by asynchronous 1-Wire
+ **                   transactions, so the GUI and the CAN handling keep
+ **                   running while the transfers are in progress. If
+ **                   READ ROM fails, the bus is enumerated by SEARCH ROM.
+ **
+ ** Calling         : main loop, after EwProcess()
+ **
+ ** InputValues     : none
+ ** OutputValues    : int. 1=Boot sequence running. 0=Done
+ **********************************************************/
+int boot_process(void) {
+    switch (boot_sm_state) {
+    case E_BOOT_SM_FIRST_FRAME:
+        /* first EwProcess() is done */
+        boot_phase_end(E_BOOT_FIRST_FRAME);
+        boot_time[BOOT_TIME_FIRST_FRAME] = HAL_GetTick();
+        boot_sm_state = E_BOOT_SM_ROMID;
+        break;
+
+    case E_BOOT_SM_ROMID:
+        /* the chip status is updated when the ROM ID was read */
+        boot_phase_begin(E_BOOT_ROMID);
+        boot_ow_status = HAL_BUSY;
+        if (ow_read_ROMID_async_ds2431(boot_ow_done) == HAL_OK) {
+            boot_sm_state = E_BOOT_SM_ROMID_WAIT;
+        }
+        break;
+
+    case E_BOOT_SM_ROMID_WAIT:
+        if (boot_ow_status == HAL_BUSY) {
+            break;
+        }
+        if (boot_ow_status != HAL_OK) {
+            /* no answer or colliding ROM IDs of several devices */
+            boot_sm_state = E_BOOT_SM_SEARCH;
+            break;
+        }
+        boot_phase_end(E_BOOT_ROMID);
+        boot_phase_begin(E_BOOT_EEPROM);
+        boot_sm_state = E_BOOT_SM_EEPROM;
+        break;
+
+    case E_BOOT_SM_SEARCH:
+        /* blocking, only needed with more than one device on the bus */
+        update_chipstatus(ow_search_rom_ds2431());
+        boot_phase_end(E_BOOT_ROMID);
+        boot_phase_begin(E_BOOT_EEPROM);
+        boot_sm_state = E_BOOT_SM_EEPROM;
+        break;
+
+    case E_BOOT_SM_EEPROM:
+        /* all pages are read by one transaction */
+        boot_ow_status = HAL_BUSY;
+        if (owParamPage_read_all_async_ds2431(boot_ow_done) == HAL_OK) {
+            boot_sm_state = E_BOOT_SM_EEPROM_WAIT;
+        }
+        break;
+
+    case E_BOOT_SM_EEPROM_WAIT:
+        if (boot_ow_status != HAL_BUSY) {
+            if (boot_ow_status == HAL_OK) {
+                weld_time_restore();
+            }
+            boot_phase_end(E_BOOT_EEPROM);
+            boot_sm_state = E_BOOT_SM_REPORT;
+        }
+        break;
+
+    case E_BOOT_SM_REPORT:
+        boot_time[BOOT_TIME_FIRST_INPUTS] = msg_get_first_inputs_tick();
+        boot_time[BOOT_TIME_DONE] = HAL_GetTick();
+        boot_report();
+        boot_sm_state = E_BOOT_SM_DONE;
+        break;
+
+    default:
+        return 0;
+    }
+
+    return 1;
+}
+
+/**********************************************************
+ ** Name            : boot_done
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Tells whether the boot sequence is finished. Until
+ **                   then the RAM copy of the EEPROM pages is not loaded,
+ **                   so nothing may read or write the EEPROM content.
+ **
+ ** Calling         : eeprom_job_process, param_cache_process
+ **
+ ** InputValues     : none
+ ** OutputValues    : int. 1=Done. 0=Boot sequence running
+ **********************************************************/
+int boot_done(void) {
+    return (boot_sm_state == E_BOOT_SM_DONE) ? 1 : 0;
+}
+
+/**********************************************************
+ ** Name            : boot_ow_done
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Takes over the result of a 1-Wire transaction of
+ **                   the boot sequence
+ **
+ ** Calling         : I2C interrupt
+ **
+ ** InputValues     : HAL_StatusTypeDef status
+ ** OutputValues    : none
+ **********************************************************/
+static void boot_ow_done(HAL_StatusTypeDef status) {
+    boot_ow_status = status;
+}
+
+/**********************************************************
+ ** Name            : boot_get_time
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Gets an entry of the boot time report, the
+ **                   durations of the phases (boot_phase_t) followed by
+ **                   the BOOT_TIME_xxx times since reset
+ **
+ ** Calling         : fdcan2 (CO_GET_BOOTTIME)
+ **
+ ** InputValues     : uint8_t index
+ ** OutputValues    : uint16_t. Time in ms, 0 if not available
+ **********************************************************/
+uint16_t boot_get_time(uint8_t index) {
+    if (index >= BOOT_TIME_N) {
+        return 0;
+    }
+    return (boot_time[index] > UINT16_MAX) ? UINT16_MAX : (uint16_t)boot_time[index];
+}
+
+/**********************************************************
+ ** Name            : boot_report
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Prints the boot time report and the 1-Wire bus
+ **                   statistics of the boot sequence over UART
+ **
+ ** Calling         : boot_process
+ **
+ ** InputValues     : none
+ ** OutputValues    : none
+ **********************************************************/
+static void boot_report(void) {
+    char line[BOOT_REPORT_LEN];
+    ow_stats_t stats;
+
+    Serial_COM_PutString("\r\nBoot time [ms]");
+    for (uint8_t i = 0; i < E_BOOT_PHASE_N; i++) {
+        snprintf(line, sizeof(line), "\r\n  %-16s %5lu", p_boot_phase_names[i], (unsigned long)boot_time[i]);
+        Serial_COM_PutString(line);
+    }
+    snprintf(line, sizeof(line), "\r\n  %-16s %5lu", "to first frame", (unsigned long)boot_time[BOOT_TIME_FIRST_FRAME]);
+    Serial_COM_PutString(line);
+    snprintf(line, sizeof(line), "\r\n  %-16s %5lu", "to first inputs",
+             (unsigned long)boot_time[BOOT_TIME_FIRST_INPUTS]);
+    Serial_COM_PutString(line);
+    snprintf(line, sizeof(line), "\r\n  %-16s %5lu", "to boot done", (unsigned long)boot_time[BOOT_TIME_DONE]);
+    Serial_COM_PutString(line);
+
+    /* 1-Wire traffic of the whole boot sequence */
+    ow_get_stats_ds2484(&stats);
+    Serial_COM_PutString("\r\n1-Wire bus");
+    snprintf(line, sizeof(line), "\r\n  %-16s %5lu", "I2C transfers", (unsigned long)stats.i2c_transfers);
+    Serial_COM_PutString(line);
+    snprintf(line, sizeof(line), "\r\n  %-16s %5lu", "1-Wire resets", (unsigned long)stats.ow_resets);
+    Serial_COM_PutString(line);
+    snprintf(line, sizeof(line), "\r\n  %-16s %5lu", "1-Wire bytes", (unsigned long)stats.ow_bytes);
+    Serial_COM_PutString(line);
+    snprintf(line, sizeof(line), "\r\n  %-16s %5lu", "busy polls", (unsigned long)stats.busy_polls);
+    Serial_COM_PutString(line);
+    snprintf(line, sizeof(line), "\r\n  %-16s %5lu", "timeouts", (unsigned long)stats.timeouts);
+    Serial_COM_PutString(line);
+}
@@ -0,0 +1,56 @@
+/*
+******************************************************************************
+* @file: boot.h
+* @author:
+* @brief: Boot sequence and boot time report
+******************************************************************************
+*
+******************************************************************************
+*/
+
+#ifndef _BOOT_H
+#define _BOOT_H
+
+/*** Include *****************************************************************/
+#include "types.h"
+
+/* NO MORE DEFINITIONS */
+
+/*** Preprocessor definitions ************************************************/
+
+/* boot phases, the duration of each phase is reported */
+typedef enum {
+    E_BOOT_PERIPHERALS, // initialization of the peripherals
+    E_BOOT_ONEWIRE,     // setup of the DS2484
+    E_BOOT_CACHE,       // restore of the last known parameter
+    E_BOOT_GUI,         // EwInit()
+    E_BOOT_FIRST_FRAME, // first EwProcess()
+    E_BOOT_ROMID,       // reading the ROM ID of the DS2431
+    E_BOOT_EEPROM,      // reading the pages of the DS2431
+    E_BOOT_PHASE_N
+} boot_phase_t;
+
+/* further entries of the boot time report after the phases */
+#define BOOT_TIME_FIRST_FRAME  (E_BOOT_PHASE_N + 0) // time from reset to the first frame
+#define BOOT_TIME_FIRST_INPUTS (E_BOOT_PHASE_N + 1) // time from reset to the first inputs message
+#define BOOT_TIME_DONE         (E_BOOT_PHASE_N + 2) // time from reset to the end of the boot sequence
+#define BOOT_TIME_N            (E_BOOT_PHASE_N + 3)
+
+/* NO MORE DEFINITIONS */
+
+/*** Definition of variables *************************************************/
+/* NO MORE DEFINITIONS */
+
+/*** Prototypes of functions *************************************************/
+void boot_phase_begin(boot_phase_t phase);
+void boot_phase_end(boot_phase_t phase);
+int boot_process(void);
+int boot_done(void);
+uint16_t boot_get_time(uint8_t index);
+
+/* NO MORE DEFINITIONS */
+
+/*** Definitions of functions ************************************************/
+/* NO MORE DEFINITIONS */
+
+#endif //_BOOT_H
@@ -0,0 +1,473 @@
+/*
+******************************************************************************
+* @file: cpu_load.c
+* @author:
+* @brief: CPU load, main loop period and interrupt timing by the DWT cycle
+*         counter.
+*         The main loop has no idle task, so the idle time is estimated: a
+*         main loop pass as short as the shortest pass seen only polls, the
+*         load is the time above passes * shortest pass. The measured
+*         interrupts count their own time, the time of nested interrupts of
+*         higher priority is excluded. The entry latency of a periodic
+*         interrupt is its entry time behind the estimated time of its
+*         timer event.
+******************************************************************************
+*
+******************************************************************************
+*/
+
+/*** Include *****************************************************************/
+#include <stdio.h>
+#include <string.h>
+
+#include "cpu_load.h"
+#include "main.h"
+#include "serial.h"
+#include "fdcan2.h"
+/* NO MORE DEFINITIONS */
+
+/*** Preprocessor definitions ************************************************/
+#define CPU_LOAD_REPORT_LEN 64 // length of a line of the UART report
+
+/*** Definition of variables *************************************************/
+
+/* timing of an interrupt, maximum values in cycles */
+typedef struct {
+    cpu_isr_stats_t stats;
+    uint32_t period;   // cycles of a periodic interrupt, 0 = not periodic
+    uint32_t expected; // cycle counter of the next timer event
+    uint8_t b_expected;
+} cpu_isr_data_t;
+
+static cpu_isr_data_t cpu_isr_data[E_CPU_ISR_N];
+
+/* own cycles of all measured interrupts since the start */
+static volatile uint32_t cpu_isr_cycles = 0;
+
+static uint32_t cpu_cycles_us = 1;
+static uint32_t cpu_window_cycles = 0;
+
+/* current window */
+static uint8_t cpu_b_started = 0;
+static uint32_t cpu_loop_last;
+static uint32_t cpu_pass_min_all = UINT32_MAX;
+static uint32_t cpu_window_start;
+static uint32_t cpu_window_isr;
+static uint32_t cpu_window_gui;
+static uint32_t cpu_window_passes;
+static uint32_t cpu_window_pass_min;
+static uint32_t cpu_window_pass_max;
+static uint32_t cpu_windows = 0;
+
+/* last window */
+static cpu_load_report_t cpu_load_report;
+
+static const char *const p_cpu_isr_names[E_CPU_ISR_N] = {"FDCAN2", "TIM16", "EXTI", "I2C", "display DMA", "UART"};
+
+/*** Prototypes of functions *************************************************/
+static uint8_t cpu_load_bin(uint32_t cycles);
+static void cpu_load_publish(uint32_t now);
+static void cpu_load_print(void);
+
+/*** Definitions of functions ************************************************/
+
+/**********************************************************
+ ** Name            : cpu_load_init
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Starts the DWT cycle counter and takes the cycles of
+ **                   a µs and of a window from the CPU clock. The only
+ **                   start of the counter, the trace time stamps and the
+ **                   key latency use it too.
+ **
+ ** Calling         : main, after SystemClock_Config
+ **
+ ** InputValues     : none
+ ** OutputValues    : none
+ **********************************************************/
+void cpu_load_init(void) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    cpu_cycles_us = SystemCoreClock / 1000000U;
+    cpu_window_cycles = (SystemCoreClock / 1000U) * CPU_LOAD_WINDOW_MS;
+}
+
+/**********************************************************
+ ** Name            : cpu_load_set_period
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Sets the period of a timer interrupt, its entry
+ **                   latency is measured from then on
+ **
+ ** Calling         : main, before the interrupt is enabled
+ **
+ ** InputValues     : cpu_isr_t isr, period in CPU cycles
+ ** OutputValues    : none
+ **********************************************************/
+void cpu_load_set_period(cpu_isr_t isr, uint32_t cycles) {
+    if (isr >= E_CPU_ISR_N) {
+        return;
+    }
+    cpu_isr_data[isr].period = cycles;
+    cpu_isr_data[isr].b_expected = 0;
+}
+
+/**********************************************************
+ ** Name            : cpu_load_loop
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Measures the main loop pass and closes the window
+ **                   after CPU_LOAD_WINDOW_MS. Prints the UART report every
+ **                   CPU_LOAD_REPORT_S.
+ **
+ ** Calling         : main loop, once per pass
+ **
+ ** InputValues     : none
+ ** OutputValues    : none
+ **********************************************************/
+void cpu_load_loop(void) {
+    uint32_t now = DWT->CYCCNT;
+    uint32_t pass = now - cpu_loop_last;
+
+    cpu_loop_last = now;
+    if (!cpu_b_started) {
+        cpu_b_started = 1;
+        cpu_window_start = now;
+        cpu_window_isr = cpu_isr_cycles;
+        cpu_window_pass_min = UINT32_MAX;
+        return;
+    }
+
+    if (pass < cpu_pass_min_all) {
+        cpu_pass_min_all = pass;
+    }
+    if (pass < cpu_window_pass_min) {
+        cpu_window_pass_min = pass;
+    }
+    if (pass > cpu_window_pass_max) {
+        cpu_window_pass_max = pass;
+    }
+    cpu_window_passes++;
+
+    if ((now - cpu_window_start) >= cpu_window_cycles) {
+        cpu_load_publish(now);
+        if (CPU_LOAD_REPORT_S && (++cpu_windows >= (CPU_LOAD_REPORT_S * 1000U / CPU_LOAD_WINDOW_MS))) {
+            cpu_windows = 0;
+            cpu_load_print();
+        }
+    }
+}
+
+/**********************************************************
+ ** Name            : cpu_load_gui
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Adds the cycles of an EwProcess() to the window
+ **
+ ** Calling         : main loop, after EwProcess()
+ **
+ ** InputValues     : cycles
+ ** OutputValues    : none
+ **********************************************************/
+void cpu_load_gui(uint32_t cycles) {
+    cpu_window_gui += cycles;
+}
+
+/**********************************************************
+ ** Name            : cpu_load_isr_enter
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Takes the entry time of an interrupt. The cycle
+ **                   counter is read before the cycles of the nested
+ **                   interrupts, so a nested interrupt between both reads
+ **                   is counted to this one and the own time never becomes
+ **                   negative.
+ **                   For a periodic interrupt the latency is the entry time
+ **                   behind the estimated timer event. The estimate follows
+ **                   the period from the entry with the lowest latency, so
+ **                   the latency is measured relative to the fastest entry
+ **                   seen. Timer events without entry, e.g. while the
+ **                   interrupt is disabled, are counted as missed.
+ **
+ ** Calling         : interrupt handlers, first
+ **
+ ** InputValues     : cpu_isr_t isr, frame kept by the handler
+ ** OutputValues    : none
+ **********************************************************/
+void cpu_load_isr_enter(cpu_isr_t isr, cpu_isr_frame_t *p_frame) {
+    cpu_isr_data_t *p_data = &cpu_isr_data[isr];
+    int32_t late;
+    uint32_t periods;
+
+    p_frame->start = DWT->CYCCNT;
+    p_frame->nested = cpu_isr_cycles;
+
+    if (p_data->period == 0) {
+        return;
+    }
+    late = (int32_t)(p_frame->start - p_data->expected);
+    if (!p_data->b_expected || (late < 0)) {
+        /* first entry or an entry before the estimated event: the event is taken from this entry */
+        late = 0;
+        p_data->expected = p_frame->start;
+        p_data->b_expected = 1;
+    }
+    periods = (uint32_t)late / p_data->period;
+    if (periods) {
+        p_data->stats.missed += periods;
+        p_data->expected += periods * p_data->period;
+        late -= (int32_t)(periods * p_data->period);
+    }
+    if ((uint32_t)late > p_data->stats.latency_max) {
+        p_data->stats.latency_max = (uint32_t)late;
+    }
+    p_data->stats.latency_hist[cpu_load_bin((uint32_t)late)]++;
+    p_data->expected += p_data->period;
+}
+
+/**********************************************************
+ ** Name            : cpu_load_isr_exit
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Counts the own time of an interrupt, the time of
+ **                   the nested interrupts since its entry is excluded
+ **
+ ** Calling         : interrupt handlers, last
+ **
+ ** InputValues     : cpu_isr_t isr, frame of cpu_load_isr_enter()
+ ** OutputValues    : none
+ **********************************************************/
+void cpu_load_isr_exit(cpu_isr_t isr, const cpu_isr_frame_t *p_frame) {
+    cpu_isr_data_t *p_data = &cpu_isr_data[isr];
+    uint32_t primask = __get_PRIMASK();
+    uint32_t cycles;
+
+    __disable_irq();
+    cycles = (DWT->CYCCNT - p_frame->start) - (cpu_isr_cycles - p_frame->nested);
+    cpu_isr_cycles += cycles;
+    __set_PRIMASK(primask);
+
+    p_data->stats.count++;
+    if (cycles > p_data->stats.time_max) {
+        p_data->stats.time_max = cycles;
+    }
+    p_data->stats.time_hist[cpu_load_bin(cycles)]++;
+}
+
+/**********************************************************
+ ** Name            : cpu_load_get_report
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Gets the load of the last window
+ **
+ ** Calling         : application, interrupts too
+ **
+ ** InputValues     : report
+ ** OutputValues    : none
+ **********************************************************/
+void cpu_load_get_report(cpu_load_report_t *p_report) {
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    *p_report = cpu_load_report;
+    __set_PRIMASK(primask);
+}
+
+/**********************************************************
+ ** Name            : cpu_load_get_isr
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Gets the timing of an interrupt since the start
+ **
+ ** Calling         : application, interrupts too
+ **
+ ** InputValues     : cpu_isr_t isr, statistics
+ ** OutputValues    : none
+ **********************************************************/
+void cpu_load_get_isr(cpu_isr_t isr, cpu_isr_stats_t *p_stats) {
+    uint32_t primask = __get_PRIMASK();
+
+    if (isr >= E_CPU_ISR_N) {
+        memset(p_stats, 0, sizeof(*p_stats));
+        return;
+    }
+    __disable_irq();
+    *p_stats = cpu_isr_data[isr].stats;
+    __set_PRIMASK(primask);
+    p_stats->time_max /= cpu_cycles_us;
+    p_stats->latency_max /= cpu_cycles_us;
+}
+
+/**********************************************************
+ ** Name            : cpu_load_get_can
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Gets the answer of CO_GET_CPULOAD, 4 bytes selected by
+ **                   the CPU_LOAD_SEL_.. of the request. Values are little
+ **                   endian and saturated, an unknown selection is answered
+ **                   with zeros.
+ **
+ ** Calling         : FDCAN2 interrupt
+ **
+ ** InputValues     : uint8_t select, 4 bytes, data[0] is the bin of a
+ **                   histogram
+ ** OutputValues    : none
+ **********************************************************/
+void cpu_load_get_can(uint8_t select, uint8_t data[4]) {
+    cpu_load_report_t report;
+    cpu_isr_stats_t stats;
+    cpu_isr_t isr = (cpu_isr_t)(select & 0x0F);
+    uint8_t bin = data[0];
+    uint32_t count = 0;
+
+    memset(data, 0, 4);
+    cpu_load_get_report(&report);
+    switch (select) {
+    case CPU_LOAD_SEL_LOAD:
+        fdcan2_put_u16(&data[0], report.load);
+        fdcan2_put_u16(&data[2], report.isr_load);
+        return;
+    case CPU_LOAD_SEL_GUI:
+        fdcan2_put_u16(&data[0], report.gui_load);
+        fdcan2_put_u16(&data[2], report.period_avg);
+        return;
+    case CPU_LOAD_SEL_PERIOD:
+        fdcan2_put_u16(&data[0], report.period_min);
+        fdcan2_put_u16(&data[2], report.period_max);
+        return;
+    default:
+        break;
+    }
+
+    if (isr >= E_CPU_ISR_N) {
+        return;
+    }
+    cpu_load_get_isr(isr, &stats);
+    switch (select & 0xF0) {
+    case CPU_LOAD_SEL_ISR:
+        fdcan2_put_u16(&data[0], stats.time_max);
+        fdcan2_put_u16(&data[2], stats.latency_max);
+        return;
+    case CPU_LOAD_SEL_TIME:
+        count = (bin < CPU_LOAD_HIST_N) ? stats.time_hist[bin] : 0;
+        break;
+    case CPU_LOAD_SEL_LATENCY:
+        count = (bin < CPU_LOAD_HIST_N) ? stats.latency_hist[bin] : 0;
+        break;
+    default:
+        return;
+    }
+    count = (count > 0xFFFFFFU) ? 0xFFFFFFU : count;
+    data[0] = bin;
+    data[1] = (uint8_t)(count & 0xff);
+    data[2] = (uint8_t)((count & 0xff00) >> 8);
+    data[3] = (uint8_t)((count & 0xff0000) >> 16);
+}
+
+/**********************************************************
+ ** Name            : cpu_load_bin
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Gets the histogram bin of a duration, the bins are
+ **                   doubling µs: < 1, < 2, < 4 .. and the rest
+ **
+ ** Calling         : cpu_load_isr_enter, cpu_load_isr_exit
+ **
+ ** InputValues     : cycles
+ ** OutputValues    : uint8_t bin
+ **********************************************************/
+static uint8_t cpu_load_bin(uint32_t cycles) {
+    uint32_t us = cycles / cpu_cycles_us;
+    uint8_t bin = 0;
+
+    while (us && (bin < (CPU_LOAD_HIST_N - 1))) {
+        us >>= 1;
+        bin++;
+    }
+    return bin;
+}
+
+/**********************************************************
+ ** Name            : cpu_load_publish
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Closes the window and starts the next one
+ **
+ ** Calling         : cpu_load_loop
+ **
+ ** InputValues     : cycle counter
+ ** OutputValues    : none
+ **********************************************************/
+static void cpu_load_publish(uint32_t now) {
+    uint32_t window = now - cpu_window_start;
+    uint32_t isr = cpu_isr_cycles;
+    uint64_t idle = (uint64_t)cpu_window_passes * cpu_pass_min_all;
+    cpu_load_report_t report;
+    uint32_t primask;
+
+    report.load = (idle >= window) ? 0 : (uint16_t)(1000U - (idle * 1000U) / window);
+    report.isr_load = (uint16_t)(((uint64_t)(isr - cpu_window_isr) * 1000U) / window);
+    report.gui_load = (uint16_t)(((uint64_t)cpu_window_gui * 1000U) / window);
+    report.passes = cpu_window_passes;
+    report.period_min = cpu_window_pass_min / cpu_cycles_us;
+    report.period_avg = (window / cpu_window_passes) / cpu_cycles_us;
+    report.period_max = cpu_window_pass_max / cpu_cycles_us;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    cpu_load_report = report;
+    __set_PRIMASK(primask);
+
+    cpu_window_start = now;
+    cpu_window_isr = isr;
+    cpu_window_gui = 0;
+    cpu_window_passes = 0;
+    cpu_window_pass_min = UINT32_MAX;
+    cpu_window_pass_max = 0;
+}
+
+/**********************************************************
+ ** Name            : cpu_load_print
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Prints the load of the last window and the timing
+ **                   of the interrupts over UART
+ **
+ ** Calling         : cpu_load_loop
+ **
+ ** InputValues     : none
+ ** OutputValues    : none
+ **********************************************************/
+static void cpu_load_print(void) {
+    char line[CPU_LOAD_REPORT_LEN];
+    cpu_isr_stats_t stats;
+
+    snprintf(line, sizeof(line), "\r\nCPU load [permille] %4u, ISR %4u, GUI %4u", cpu_load_report.load,
+             cpu_load_report.isr_load, cpu_load_report.gui_load);
+    Serial_COM_PutString(line);
+    snprintf(line, sizeof(line), "\r\n  %-16s %5s %5s %5s", "main loop [us]", "min", "avg", "max");
+    Serial_COM_PutString(line);
+    snprintf(line, sizeof(line), "\r\n  %-16s %5lu %5lu %5lu", "", (unsigned long)cpu_load_report.period_min,
+             (unsigned long)cpu_load_report.period_avg, (unsigned long)cpu_load_report.period_max);
+    Serial_COM_PutString(line);
+    snprintf(line, sizeof(line), "\r\n  %-16s %5s %5s %5s", "interrupt [us]", "count", "max", "lat");
+    Serial_COM_PutString(line);
+    for (uint8_t i = 0; i < E_CPU_ISR_N; i++) {
+        cpu_load_get_isr((cpu_isr_t)i, &stats);
+        snprintf(line, sizeof(line), "\r\n  %-16s %5lu %5lu %5lu", p_cpu_isr_names[i], (unsigned long)stats.count,
+                 (unsigned long)stats.time_max, (unsigned long)stats.latency_max);
+        Serial_COM_PutString(line);
+    }
+}
@@ -0,0 +1,89 @@
+/*
+******************************************************************************
+* @file: cpu_load.h
+* @author:
+* @brief: CPU load, main loop period and interrupt timing by the DWT cycle
+*         counter
+******************************************************************************
+*
+******************************************************************************
+*/
+
+#ifndef _CPU_LOAD_H
+#define _CPU_LOAD_H
+
+/*** Include *****************************************************************/
+#include "types.h"
+
+/* NO MORE DEFINITIONS */
+
+/*** Preprocessor definitions ************************************************/
+#define CPU_LOAD_WINDOW_MS 1000 // measuring window of the load and the main loop period
+#define CPU_LOAD_REPORT_S  10   // UART report every n seconds, 0 = off
+#define CPU_LOAD_HIST_N    8    // histogram bins: < 1, 2, 4, 8, 16, 32, 64 µs and above
+
+/* CO_GET_CPULOAD selectors, data[2] of the request */
+#define CPU_LOAD_SEL_LOAD    0x00 // CPU load and interrupt load [permille]
+#define CPU_LOAD_SEL_GUI     0x01 // EwProcess() load [permille] and average main loop period [µs]
+#define CPU_LOAD_SEL_PERIOD  0x02 // minimum and maximum main loop period [µs]
+#define CPU_LOAD_SEL_ISR     0x10 // | cpu_isr_t: maximum duration and entry latency [µs]
+#define CPU_LOAD_SEL_TIME    0x20 // | cpu_isr_t: duration histogram, data[3] selects the bin
+#define CPU_LOAD_SEL_LATENCY 0x30 // | cpu_isr_t: entry latency histogram, data[3] selects the bin
+
+/*** Definition of variables *************************************************/
+
+/* measured interrupts */
+typedef enum {
+    E_CPU_ISR_FDCAN2,  // FDCAN2 line 0
+    E_CPU_ISR_TIM16,   // 10 ms timer
+    E_CPU_ISR_EXTI,    // key edges and the TIM17 compare of the keys
+    E_CPU_ISR_I2C,     // DS2484 1-Wire bridge
+    E_CPU_ISR_DISPLAY, // display DMA
+    E_CPU_ISR_UART,    // UART log DMA and USART1
+    E_CPU_ISR_N
+} cpu_isr_t;
+
+/* state of an interrupt entry, kept by the interrupt handler. Handlers sharing an entry have the same priority. */
+typedef struct {
+    uint32_t start;  // cycle counter at the entry
+    uint32_t nested; // cycles of all interrupts at the entry
+} cpu_isr_frame_t;
+
+/* load of the last window */
+typedef struct {
+    uint16_t load;       // permille busy, the rest are main loop passes as short as the shortest pass
+    uint16_t isr_load;   // permille in the measured interrupts
+    uint16_t gui_load;   // permille in EwProcess(), interrupts included
+    uint32_t passes;     // main loop passes
+    uint32_t period_min; // µs
+    uint32_t period_avg; // µs
+    uint32_t period_max; // µs
+} cpu_load_report_t;
+
+/* timing of an interrupt since the start */
+typedef struct {
+    uint32_t count;                         // entries
+    uint32_t time_max;                      // µs of the longest entry, nested interrupts excluded
+    uint32_t latency_max;                   // µs, periodic interrupts only
+    uint32_t missed;                        // periods without entry, periodic interrupts only
+    uint32_t time_hist[CPU_LOAD_HIST_N];    // entries by duration
+    uint32_t latency_hist[CPU_LOAD_HIST_N]; // entries by latency, periodic interrupts only
+} cpu_isr_stats_t;
+
+/*** Prototypes of functions *************************************************/
+void cpu_load_init(void);
+void cpu_load_set_period(cpu_isr_t isr, uint32_t cycles);
+void cpu_load_loop(void);
+void cpu_load_gui(uint32_t cycles);
+void cpu_load_isr_enter(cpu_isr_t isr, cpu_isr_frame_t *p_frame);
+void cpu_load_isr_exit(cpu_isr_t isr, const cpu_isr_frame_t *p_frame);
+void cpu_load_get_report(cpu_load_report_t *p_report);
+void cpu_load_get_isr(cpu_isr_t isr, cpu_isr_stats_t *p_stats);
+void cpu_load_get_can(uint8_t select, uint8_t data[4]);
+
+/* NO MORE DEFINITIONS */
+
+/*** Definitions of functions ************************************************/
+/* NO MORE DEFINITIONS */
+
+#endif //_CPU_LOAD_H
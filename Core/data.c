@@ -11,28 +11,58 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "Parameter/ParaEnums.h"
 #include "datatypes.h"
 
 #define DATA_PARAM_NUM_MAX (32 + 1) // maximum number of parameters
 #define DATA_QA_NUM_MAX    32       // maximum number of quick accesses
 
+#define DATA_PARAM_ID_NUM JS_PAR_N            // number of parameter IDs, taken from ParaDef.json
+#define DATA_QA_ID_NUM    (DATA_QA_NUM_MAX + 1) // number of quick access IDs (1..DATA_QA_NUM_MAX)
+
 #define DATA_PARAM_ID_LAST 0 // ID reserved for last parameter
 
 #define DATA_QA_ID_INVAL 0 // invalid quick access ID
 
-static data_param_t data_param[DATA_PARAM_NUM_MAX];
-static data_qa_t data_qa[DATA_QA_NUM_MAX];
+#define DATA_GEN_NONE 0 // generation of an entry which is not inserted
+
+/**
+ * @brief Structure for a parameter entry of the store
+ */
+typedef struct {
+    data_param_t data;
+    uint32_t gen; ///< generation of the last change, DATA_GEN_NONE if not inserted
+} data_param_entry_t;
+
+/**
+ * @brief Structure for a quick access entry of the store
+ */
+typedef struct {
+    data_qa_t data;
+    uint32_t gen; ///< generation of the last change, DATA_GEN_NONE if not inserted
+} data_qa_entry_t;
+
+static data_param_entry_t data_param[DATA_PARAM_ID_NUM];
+static data_qa_entry_t data_qa[DATA_QA_ID_NUM];
 
 static int data_param_num = 0;
 static int data_qa_num = 0;
+static int data_param_inserted = 0;
+static int data_qa_inserted = 0;
 static uint8_t data_param_id_act = DATA_PARAM_ID_LAST;
 static uint8_t data_qa_id_act = DATA_QA_ID_INVAL;
 
+/* store generation, incremented on every change of an entry */
+static uint32_t data_gen = DATA_GEN_NONE;
+
 static data_cb_t *p_cb_param = NULL;
 static data_cb_t *p_cb_qa = NULL;
 
-static data_param_t *get_param(uint8_t id);
-static data_qa_t *get_qa(uint8_t id);
+static data_param_entry_t *get_param(uint8_t id);
+static data_qa_entry_t *get_qa(uint8_t id);
+static uint32_t next_gen(void);
+static int param_select(uint8_t id, int b_select, int b_changed);
+static int param_apply(data_param_entry_t *p_entry, const data_param_t *p_data);
 
 /**
  * @brief Set number of parameters
@@ -49,10 +79,34 @@ void data_set_param_num(uint8_t num) {
 
     /* reset all paramters */
     memset(data_param, 0, sizeof(data_param));
+    data_param_inserted = 0;
+
+    /* the entry for the last parameter is always available */
+    data_insert_param(DATA_PARAM_ID_LAST);
+}
 
-    for (int i = 0; i < data_param_num; i++) {
-        data_param[i].id = DATA_PARAM_ID_LAST;
+/**
+ * @brief Insert a parameter into the store
+ * @param id: ID of the parameter
+ * @retval 0 on success or if already inserted, -1 if ID is invalid or store is full
+ */
+int data_insert_param(uint8_t id) {
+    if (id >= DATA_PARAM_ID_NUM) {
+        return -1;
     }
+
+    if (data_param[id].gen == DATA_GEN_NONE) {
+        if (data_param_inserted >= data_param_num) {
+            return -1;
+        }
+
+        memset(&data_param[id].data, 0, sizeof(data_param_t));
+        data_param[id].data.id = id;
+        data_param[id].gen = next_gen();
+        data_param_inserted++;
+    }
+
+    return 0;
 }
 
 /**
@@ -65,19 +119,17 @@ void data_set_param_num(uint8_t num) {
 void data_set_param_value(uint8_t id, float value, int b_select) {
     int b_call_cb = 0;
 
-    data_param_t *p_param = get_param(id);
+    data_param_entry_t *p_param = get_param(id);
 
     if (p_param) {
-        if (b_select) {
-            if (data_qa_id_act != DATA_QA_ID_INVAL || data_param_id_act != id || p_param->value != value) {
-                b_call_cb = 1;
-            }
+        int b_changed = (p_param->data.value != value);
 
-            data_param_id_act = id;
-            data_qa_id_act = DATA_QA_ID_INVAL;
-        }
+        b_call_cb = param_select(id, b_select, b_changed);
 
-        p_param->value = value;
+        if (b_changed) {
+            p_param->data.value = value;
+            p_param->gen = next_gen();
+        }
     }
 
     if (b_call_cb && p_cb_param) {
@@ -95,19 +147,17 @@ void data_set_param_value(uint8_t id, float value, int b_select) {
 void data_set_param_min(uint8_t id, float min, int b_select) {
     int b_call_cb = 0;
 
-    data_param_t *p_param = get_param(id);
+    data_param_entry_t *p_param = get_param(id);
 
     if (p_param) {
-        if (b_select) {
-            if (data_qa_id_act != DATA_QA_ID_INVAL || data_param_id_act != id || p_param->min != min) {
-                b_call_cb = 1;
-            }
+        int b_changed = (p_param->data.min != min);
 
-            data_param_id_act = id;
-            data_qa_id_act = DATA_QA_ID_INVAL;
-        }
+        b_call_cb = param_select(id, b_select, b_changed);
 
-        p_param->min = min;
+        if (b_changed) {
+            p_param->data.min = min;
+            p_param->gen = next_gen();
+        }
     }
 
     if (b_call_cb && p_cb_param) {
@@ -125,19 +175,17 @@ void data_set_param_min(uint8_t id, float min, int b_select) {
 void data_set_param_max(uint8_t id, float max, int b_select) {
     int b_call_cb = 0;
 
-    data_param_t *p_param = get_param(id);
+    data_param_entry_t *p_param = get_param(id);
 
     if (p_param) {
-        if (b_select) {
-            if (data_qa_id_act != DATA_QA_ID_INVAL || data_param_id_act != id || p_param->max != max) {
-                b_call_cb = 1;
-            }
+        int b_changed = (p_param->data.max != max);
 
-            data_param_id_act = id;
-            data_qa_id_act = DATA_QA_ID_INVAL;
-        }
+        b_call_cb = param_select(id, b_select, b_changed);
 
-        p_param->max = max;
+        if (b_changed) {
+            p_param->data.max = max;
+            p_param->gen = next_gen();
+        }
     }
 
     if (b_call_cb && p_cb_param) {
@@ -155,25 +203,68 @@ void data_set_param_max(uint8_t id, float max, int b_select) {
 void data_set_param_cfg(uint8_t id, data_param_cfg_t *p_cfg, int b_select) {
     int b_call_cb = 0;
 
-    data_param_t *p_param = get_param(id);
+    data_param_entry_t *p_param = get_param(id);
 
     if (p_param) {
-        if (b_select) {
-            if (data_qa_id_act != DATA_QA_ID_INVAL || data_param_id_act != id ||
-                memcmp(&p_param->cfg, p_cfg, sizeof(data_param_cfg_t))) {
-                b_call_cb = 1;
+        int b_changed = (p_param->data.cfg.unit != p_cfg->unit || p_param->data.cfg.type != p_cfg->type ||
+                         p_param->data.cfg.image != p_cfg->image || p_param->data.cfg.text != p_cfg->text);
+
+        b_call_cb = param_select(id, b_select, b_changed);
+
+        if (b_changed) {
+            p_param->data.cfg = *p_cfg;
+            p_param->gen = next_gen();
+        }
+    }
+
+    if (b_call_cb && p_cb_param) {
+        p_cb_param();
+    }
+}
+
+/**
+ * @brief Apply data of several parameters at once
+ * @param p_params:  pointer to the parameter data, the ID of each record selects the entry
+ * @param num:       number of records
+ * @param id_select: ID of the parameter which shall be shown, DATA_PARAM_ID_LAST to keep the selection
+ * @retval number of applied records, records of not inserted parameters are skipped
+ */
+int data_apply_params(const data_param_t *p_params, int num, uint8_t id_select) {
+    int applied = 0;
+    int b_act_changed = 0;
+    int b_sel_changed = 0;
+    int b_call_cb = 0;
+
+    for (int i = 0; i < num; i++) {
+        data_param_entry_t *p_param = NULL;
+
+        if (p_params[i].id >= 0 && p_params[i].id < DATA_PARAM_ID_NUM) {
+            p_param = get_param((uint8_t)p_params[i].id);
+        }
+
+        if (p_param) {
+            if (param_apply(p_param, &p_params[i])) {
+                b_act_changed |= (p_params[i].id == data_param_id_act);
+                b_sel_changed |= (p_params[i].id == id_select);
             }
 
-            data_param_id_act = id;
-            data_qa_id_act = DATA_QA_ID_INVAL;
+            applied++;
         }
+    }
 
-        memcpy(&p_param->cfg, p_cfg, sizeof(data_param_cfg_t));
+    if (id_select != DATA_PARAM_ID_LAST && get_param(id_select)) {
+        /* select the parameter like a single setter would do */
+        b_call_cb = param_select(id_select, 1, b_sel_changed);
+    } else if (b_act_changed && data_qa_id_act == DATA_QA_ID_INVAL) {
+        /* data of the shown parameter changed */
+        b_call_cb = 1;
     }
 
     if (b_call_cb && p_cb_param) {
         p_cb_param();
     }
+
+    return applied;
 }
 
 /**
@@ -191,10 +282,31 @@ void data_set_qa_num(uint8_t num) {
 
     /* reset all QAs */
     memset(data_qa, 0, sizeof(data_qa));
+    data_qa_inserted = 0;
+}
+
+/**
+ * @brief Insert a quick access into the store
+ * @param id: ID of the QA
+ * @retval 0 on success or if already inserted, -1 if ID is invalid or store is full
+ */
+int data_insert_qa(uint8_t id) {
+    if (id == DATA_QA_ID_INVAL || id >= DATA_QA_ID_NUM) {
+        return -1;
+    }
+
+    if (data_qa[id].gen == DATA_GEN_NONE) {
+        if (data_qa_inserted >= data_qa_num) {
+            return -1;
+        }
 
-    for (int i = 0; i < data_qa_num; i++) {
-        data_qa[i].id = DATA_QA_ID_INVAL;
+        memset(&data_qa[id].data, 0, sizeof(data_qa_t));
+        data_qa[id].data.id = id;
+        data_qa[id].gen = next_gen();
+        data_qa_inserted++;
     }
+
+    return 0;
 }
 
 /**
@@ -207,11 +319,14 @@ void data_set_qa_num(uint8_t num) {
 void data_set_qa(uint8_t id, data_qa_t *p_data_qa, int b_select) {
     int b_call_cb = 0;
 
-    data_qa_t *p_qa = get_qa(id);
+    data_qa_entry_t *p_qa = get_qa(id);
 
     if (p_qa) {
+        int b_changed = (p_qa->data.value != p_data_qa->value || p_qa->data.state != p_data_qa->state ||
+                         p_qa->data.image != p_data_qa->image || p_qa->data.text != p_data_qa->text);
+
         if (b_select) {
-            if (data_qa_id_act != id || memcmp(p_qa, p_data_qa, sizeof(data_qa_t))) {
+            if (data_qa_id_act != id || b_changed) {
                 b_call_cb = 1;
             }
 
@@ -219,7 +334,13 @@ void data_set_qa(uint8_t id, data_qa_t *p_data_qa, int b_select) {
             data_param_id_act = DATA_PARAM_ID_LAST;
         }
 
-        memcpy(p_qa, p_data_qa, sizeof(data_qa_t));
+        if (b_changed) {
+            p_qa->data.value = p_data_qa->value;
+            p_qa->data.state = p_data_qa->state;
+            p_qa->data.image = p_data_qa->image;
+            p_qa->data.text = p_data_qa->text;
+            p_qa->gen = next_gen();
+        }
     }
 
     if (b_call_cb && p_cb_qa) {
@@ -251,12 +372,12 @@ void data_set_cb_qa(data_cb_t *p_cb) {
  * @retval 0 on success, -1 if no selected parameter could be found
  */
 int data_get_param(data_param_t *p_data_param) {
-    data_param_t *p_param;
+    data_param_entry_t *p_param;
 
     p_param = get_param(data_param_id_act);
 
     if (p_param) {
-        memcpy(p_data_param, p_param, sizeof(data_param_t));
+        memcpy(p_data_param, &p_param->data, sizeof(data_param_t));
     }
 
     return (p_param ? 0 : -1);
@@ -268,59 +389,151 @@ int data_get_param(data_param_t *p_data_param) {
  * @retval 0 on success, -1 if no selected parameter could be found
  */
 int data_get_qa(data_qa_t *p_data_qa) {
-    data_qa_t *p_qa;
+    data_qa_entry_t *p_qa;
 
     p_qa = get_qa(data_qa_id_act);
 
     if (p_qa) {
-        memcpy(p_data_qa, p_qa, sizeof(data_qa_t));
+        memcpy(p_data_qa, &p_qa->data, sizeof(data_qa_t));
     }
 
     return (p_qa ? 0 : -1);
 }
 
 /**
- * @brief Get pointer to parameter data for an ID
- * @param id: parameter ID
- * @retval pointer to the parameter data
+ * @brief Get actual generation of the store
+ * @retval generation of the last change of any entry
  */
-static data_param_t *get_param(uint8_t id) {
-    data_param_t *param = NULL;
-    int i;
+uint32_t data_get_generation(void) {
+    return data_gen;
+}
 
-    for (i = 0; i < data_param_num; i++) {
-        if (i < data_param_num - 1 && data_param[i].id == DATA_PARAM_ID_LAST) {
-            data_param[i].id = id;
+/**
+ * @brief Get IDs of parameters changed since a generation
+ * @param gen:     generation to compare with, e.g. a value returned by data_get_generation()
+ * @param p_ids:   pointer to buffer for the IDs of the changed parameters
+ * @param max_ids: size of the ID buffer
+ * @retval number of changed parameters, may be larger than max_ids
+ */
+int data_get_param_changes(uint32_t gen, uint8_t *p_ids, int max_ids) {
+    int num = 0;
+
+    for (int id = 0; id < DATA_PARAM_ID_NUM; id++) {
+        if (data_param[id].gen > gen) {
+            if (num < max_ids) {
+                p_ids[num] = id;
+            }
+
+            num++;
         }
+    }
 
-        if (data_param[i].id == id) {
-            param = &data_param[i];
-            break;
+    return num;
+}
+
+/**
+ * @brief Get IDs of quick accesses changed since a generation
+ * @param gen:     generation to compare with, e.g. a value returned by data_get_generation()
+ * @param p_ids:   pointer to buffer for the IDs of the changed QAs
+ * @param max_ids: size of the ID buffer
+ * @retval number of changed QAs, may be larger than max_ids
+ */
+int data_get_qa_changes(uint32_t gen, uint8_t *p_ids, int max_ids) {
+    int num = 0;
+
+    for (int id = 1; id < DATA_QA_ID_NUM; id++) {
+        if (data_qa[id].gen > gen) {
+            if (num < max_ids) {
+                p_ids[num] = id;
+            }
+
+            num++;
         }
     }
 
-    return param;
+    return num;
 }
 
 /**
- * @brief Get pointer to quick access data for an ID
+ * @brief Get pointer to parameter entry for an ID
+ * @param id: parameter ID
+ * @retval pointer to the parameter entry, NULL if the parameter is not inserted
+ */
+static data_param_entry_t *get_param(uint8_t id) {
+    if (id >= DATA_PARAM_ID_NUM || data_param[id].gen == DATA_GEN_NONE) {
+        return NULL;
+    }
+
+    return &data_param[id];
+}
+
+/**
+ * @brief Get pointer to quick access entry for an ID
  * @param id: QA ID
- * @retval pointer to the QA data
+ * @retval pointer to the QA entry, NULL if the QA is not inserted
  */
-static data_qa_t *get_qa(uint8_t id) {
-    data_qa_t *qa = NULL;
-    int i;
+static data_qa_entry_t *get_qa(uint8_t id) {
+    if (id >= DATA_QA_ID_NUM || data_qa[id].gen == DATA_GEN_NONE) {
+        return NULL;
+    }
 
-    for (i = 0; i < data_qa_num; i++) {
-        if (data_qa[i].id == DATA_QA_ID_INVAL) {
-            data_qa[i].id = id;
-        }
+    return &data_qa[id];
+}
+
+/**
+ * @brief Get next generation of the store
+ * @retval new generation
+ */
+static uint32_t next_gen(void) {
+    /* skip the generation reserved for not inserted entries on overflow */
+    if (++data_gen == DATA_GEN_NONE) {
+        data_gen++;
+    }
+
+    return data_gen;
+}
 
-        if (data_qa[i].id == id) {
-            qa = &data_qa[i];
-            break;
+/**
+ * @brief Handle selection of a parameter
+ * @param id:        ID of the parameter
+ * @param b_select:  flag if this parameter shall be shown
+ * @param b_changed: flag if data of the parameter changed
+ * @retval 1 if parameter callback has to be called, 0 if not
+ */
+static int param_select(uint8_t id, int b_select, int b_changed) {
+    int b_call_cb = 0;
+
+    if (b_select) {
+        if (data_qa_id_act != DATA_QA_ID_INVAL || data_param_id_act != id || b_changed) {
+            b_call_cb = 1;
         }
+
+        data_param_id_act = id;
+        data_qa_id_act = DATA_QA_ID_INVAL;
     }
 
-    return qa;
+    return b_call_cb;
+}
+
+/**
+ * @brief Apply parameter data to an entry
+ * @param p_entry: pointer to the parameter entry
+ * @param p_data:  pointer to the parameter data
+ * @retval 1 if data of the entry changed, 0 if not
+ */
+static int param_apply(data_param_entry_t *p_entry, const data_param_t *p_data) {
+    if (p_entry->data.value == p_data->value && p_entry->data.min == p_data->min &&
+        p_entry->data.max == p_data->max && p_entry->data.cfg.unit == p_data->cfg.unit &&
+        p_entry->data.cfg.type == p_data->cfg.type && p_entry->data.cfg.image == p_data->cfg.image &&
+        p_entry->data.cfg.text == p_data->cfg.text) {
+        return 0;
+    }
+
+    p_entry->data.value = p_data->value;
+    p_entry->data.min = p_data->min;
+    p_entry->data.max = p_data->max;
+    p_entry->data.cfg = p_data->cfg;
+    p_entry->gen = next_gen();
+
+    return 1;
 }
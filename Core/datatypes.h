@@ -64,6 +64,13 @@ typedef void(data_cb_t)(void);
  */
 void data_set_param_num(uint8_t num);
 
+/**
+ * @brief Insert a parameter into the store
+ * @param id: ID of the parameter
+ * @retval 0 on success or if already inserted, -1 if ID is invalid or store is full
+ */
+int data_insert_param(uint8_t id);
+
 /**
  * @brief Set parameter value
  * @param id:       ID of the parameter
@@ -100,6 +107,15 @@ void data_set_param_max(uint8_t id, float max, int b_select);
  */
 void data_set_param_cfg(uint8_t id, data_param_cfg_t *p_cfg, int b_select);
 
+/**
+ * @brief Apply data of several parameters at once
+ * @param p_params:  pointer to the parameter data, the ID of each record selects the entry
+ * @param num:       number of records
+ * @param id_select: ID of the parameter which shall be shown, DATA_PARAM_ID_LAST to keep the selection
+ * @retval number of applied records, records of not inserted parameters are skipped
+ */
+int data_apply_params(const data_param_t *p_params, int num, uint8_t id_select);
+
 /**
  * @brief Set number of quick accesses
  * @param num: number of quick accesses
@@ -107,6 +123,13 @@ void data_set_param_cfg(uint8_t id, data_param_cfg_t *p_cfg, int b_select);
  */
 void data_set_qa_num(uint8_t num);
 
+/**
+ * @brief Insert a quick access into the store
+ * @param id: ID of the QA
+ * @retval 0 on success or if already inserted, -1 if ID is invalid or store is full
+ */
+int data_insert_qa(uint8_t id);
+
 /**
  * @brief Set quick access data
  * @param id:        ID of the QA
@@ -144,4 +167,28 @@ int data_get_param(data_param_t *p_param);
  */
 int data_get_qa(data_qa_t *p_qa);
 
+/**
+ * @brief Get actual generation of the store
+ * @retval generation of the last change of any entry
+ */
+uint32_t data_get_generation(void);
+
+/**
+ * @brief Get IDs of parameters changed since a generation
+ * @param gen:     generation to compare with, e.g. a value returned by data_get_generation()
+ * @param p_ids:   pointer to buffer for the IDs of the changed parameters
+ * @param max_ids: size of the ID buffer
+ * @retval number of changed parameters, may be larger than max_ids
+ */
+int data_get_param_changes(uint32_t gen, uint8_t *p_ids, int max_ids);
+
+/**
+ * @brief Get IDs of quick accesses changed since a generation
+ * @param gen:     generation to compare with, e.g. a value returned by data_get_generation()
+ * @param p_ids:   pointer to buffer for the IDs of the changed QAs
+ * @param max_ids: size of the ID buffer
+ * @retval number of changed QAs, may be larger than max_ids
+ */
+int data_get_qa_changes(uint32_t gen, uint8_t *p_ids, int max_ids);
+
 #endif //_DATA_H
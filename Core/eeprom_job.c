@@ -0,0 +1,326 @@
+/*
+******************************************************************************
+* @file: eeprom_job.c
+* @author:
+* @brief: Queue of the EEPROM jobs commanded over CAN.
+*         The FDCAN2 interrupt only puts the received command into the
+*         queue, the 1-Wire access and the answer run in the main loop, once
+*         no asynchronous 1-Wire transaction is in progress. So the reception
+*         of other CAN messages is not held off by the EEPROM access.
+******************************************************************************
+*
+******************************************************************************
+*/
+
+/*** Include *****************************************************************/
+#include <string.h>
+
+#include "eeprom_job.h"
+#include "main.h"
+#include "msg.h"
+#include "fdcan2.h"
+#include "DS2484.h"
+#include "DS2431.h"
+#include "trace.h"
+#include "utils_circbuff.h"
+#include "boot.h"
+/* NO MORE DEFINITIONS */
+
+/*** Preprocessor definitions ************************************************/
+/* NO MORE DEFINITIONS */
+
+/*** Definition of variables *************************************************/
+
+/* job as received by the FDCAN2 interrupt */
+typedef struct {
+    eeprom_job_type_t type;
+    uint8_t data[FDCAN2_DATA_SIZE]; // received message
+    uint32_t tick;                  // time of reception
+} eeprom_job_t;
+
+/* ring of waiting jobs, filled by the interrupt and emptied by the main loop. The jobs are written and run in
+ * place, a job never wraps as the ring holds a whole number of jobs. */
+static eeprom_job_t eeprom_job_queue[EEPROM_JOB_QUEUE_SIZE];
+static utils_circbuff_handle_t eeprom_job_ring = UTILS_CIRCBUFF_STATIC(eeprom_job_queue);
+
+_Static_assert((sizeof(eeprom_job_queue) & (sizeof(eeprom_job_queue) - 1u)) == 0, "ring size not a power of 2");
+
+static eeprom_job_stats_t eeprom_job_stats;
+
+/* ROM ID job: the first packet is sent, the second one waits for EEPROM_JOB_ROMID_GAP */
+static uint8_t eeprom_job_b_romid_sent;
+static uint32_t eeprom_job_romid_tick;
+
+/* answer message of each job type */
+static const uint16_t eeprom_job_answer_id[E_EEPROM_JOB_N] = {MSG_0x1E1, MSG_0x1E1, MSG_0x1E3, MSG_0x1E5, MSG_0x1FA};
+
+/*** Prototypes of functions *************************************************/
+static int eeprom_job_run(const eeprom_job_t *p_job);
+static void eeprom_job_answer(eeprom_job_type_t type, uint8_t data[FDCAN2_DATA_SIZE], uint8_t b_from_isr);
+
+/*** Definitions of functions ************************************************/
+
+/**********************************************************
+ ** Name            : eeprom_job_push
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Puts a job into the queue. If the queue is full, the
+ **                   job is dropped and answered with CMD_BKCTEST_FAIL
+ **                   right away, a dropped ROM ID request is not
+ **                   answered.
+ **
+ ** Calling         : FDCAN2 interrupt
+ **
+ ** InputValues     : eeprom_job_type_t type, received message
+ ** OutputValues    : int. 1=Queued. 0=Dropped
+ **********************************************************/
+int eeprom_job_push(eeprom_job_type_t type, const uint8_t *p_data) {
+    eeprom_job_t *p_job;
+    uint8_t data[FDCAN2_DATA_SIZE];
+    uint8_t depth;
+
+    if (type >= E_EEPROM_JOB_N) {
+        return 0;
+    }
+
+    if (utils_circbuff_write_acquire(&eeprom_job_ring, (uint8_t **)&p_job) < sizeof(eeprom_job_t)) {
+        eeprom_job_stats.drops++;
+        if (type == E_EEPROM_JOB_ROMID) {
+            return 0;
+        }
+        memset(data, 0, sizeof(data));
+        data[0] = p_data[0];
+        /* the torch type read returns its status in data[5] */
+        data[(type == E_EEPROM_JOB_TORCHTYPE_READ) ? 5 : 1] = CMD_BKCTEST_FAIL;
+        eeprom_job_answer(type, data, 1);
+        return 0;
+    }
+
+    p_job->type = type;
+    memcpy(p_job->data, p_data, FDCAN2_DATA_SIZE);
+    p_job->tick = HAL_GetTick();
+    utils_circbuff_write_commit(&eeprom_job_ring, sizeof(eeprom_job_t));
+
+    depth = utils_circbuff_size(&eeprom_job_ring) / sizeof(eeprom_job_t);
+    if (depth > eeprom_job_stats.depth_max) {
+        eeprom_job_stats.depth_max = depth;
+    }
+    return 1;
+}
+
+/**********************************************************
+ ** Name            : eeprom_job_process
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Runs the oldest waiting job and sends its answer. The
+ **                   jobs use the blocking 1-Wire access, so they wait
+ **                   while an asynchronous transaction is in progress.
+ **                   One job per call, the GUI keeps running between the
+ **                   jobs.
+ **                   Jobs received during the boot sequence wait until
+ **                   the EEPROM pages were read. A job which is not
+ **                   finished stays at the head of the queue.
+ **
+ ** Calling         : main loop
+ **
+ ** InputValues     : void
+ ** OutputValues    : void
+ **********************************************************/
+void eeprom_job_process(void) {
+    const eeprom_job_t *p_job;
+    uint32_t latency;
+
+    if (!boot_done() || ow_async_busy() ||
+        (utils_circbuff_read_acquire(&eeprom_job_ring, (const uint8_t **)&p_job) < sizeof(eeprom_job_t))) {
+        return;
+    }
+
+    if (!eeprom_job_run(p_job)) {
+        return;
+    }
+
+    latency = HAL_GetTick() - p_job->tick;
+    TRACE2(TRACE_EEPROM_JOB, p_job->type, latency);
+    eeprom_job_stats.latency = latency;
+    if (latency > eeprom_job_stats.latency_max) {
+        eeprom_job_stats.latency_max = latency;
+    }
+    eeprom_job_stats.jobs++;
+    utils_circbuff_read_release(&eeprom_job_ring, sizeof(eeprom_job_t));
+}
+
+/**********************************************************
+ ** Name            : eeprom_job_get_stats
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Gets the statistics of the job queue
+ **
+ ** Calling         : application
+ **
+ ** InputValues     : statistics
+ ** OutputValues    : void
+ **********************************************************/
+void eeprom_job_get_stats(eeprom_job_stats_t *p_stats) {
+    *p_stats = eeprom_job_stats;
+    p_stats->depth = utils_circbuff_size(&eeprom_job_ring) / sizeof(eeprom_job_t);
+}
+
+/**********************************************************
+ ** Name            : eeprom_job_get_can
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Gets the answer of CO_GET_EEPROMJOBS, 4 bytes selected
+ **                   by the EEPROM_JOB_SEL_.. of the request. Values are
+ **                   little endian and saturated, an unknown selection is
+ **                   answered with zeros.
+ **
+ ** Calling         : FDCAN2 interrupt
+ **
+ ** InputValues     : uint8_t select, 4 bytes
+ ** OutputValues    : void
+ **********************************************************/
+void eeprom_job_get_can(uint8_t select, uint8_t data[4]) {
+    eeprom_job_stats_t stats;
+
+    memset(data, 0, 4);
+    eeprom_job_get_stats(&stats);
+    switch (select) {
+    case EEPROM_JOB_SEL_QUEUE:
+        data[0] = stats.depth;
+        data[1] = stats.depth_max;
+        fdcan2_put_u16(&data[2], stats.drops);
+        break;
+    case EEPROM_JOB_SEL_LATENCY:
+        fdcan2_put_u16(&data[0], stats.latency);
+        fdcan2_put_u16(&data[2], stats.latency_max);
+        break;
+    case EEPROM_JOB_SEL_JOBS:
+        fdcan2_put_u32(&data[0], stats.jobs);
+        break;
+    default:
+        break;
+    }
+}
+
+/**********************************************************
+ ** Name            : eeprom_job_run
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Runs a job and sends its answer, the answers are the
+ **                   same as before the queue was introduced. The ROM ID
+ **                   is answered in two packets, EEPROM_JOB_ROMID_GAP
+ **                   apart.
+ **
+ ** Calling         : eeprom_job_process
+ **
+ ** InputValues     : job
+ ** OutputValues    : int. 1=Finished. 0=Waiting for the next packet
+ **********************************************************/
+static int eeprom_job_run(const eeprom_job_t *p_job) {
+    uint8_t data[FDCAN2_DATA_SIZE];
+    uint8_t romid[8];
+    uint32_t u32torchtype;
+
+    memcpy(data, p_job->data, sizeof(data));
+    switch (p_job->type) {
+    case E_EEPROM_JOB_TORCHTYPE_WRITE:
+        u32torchtype = (data[1] | data[2] << 8 | data[3] << 16 | (uint32_t)data[4] << 24);
+        data[1] = ow_Write_TorchType(u32torchtype);
+        data[0] = CMD_TORCHTYPE_WRITE;
+        data[2] = 0;
+        data[3] = 0;
+        data[4] = 0;
+        data[5] = 0;
+        break;
+
+    case E_EEPROM_JOB_TORCHTYPE_READ:
+        data[5] = ow_read_TorchType(&u32torchtype);
+        if (data[5] == CMD_BKCTEST_PASS) {
+            data[1] = (uint8_t)(u32torchtype & 0xff);
+            data[2] = (uint8_t)((u32torchtype & 0xff00) >> 8);
+            data[3] = (uint8_t)((u32torchtype & 0xff0000) >> 16);
+            data[4] = (uint8_t)((u32torchtype & 0xff000000) >> 24);
+        } else {
+            data[1] = 0;
+            data[2] = 0;
+            data[3] = 0;
+            data[4] = 0;
+        }
+        data[0] = CMD_TORCHTYPE_READ;
+        break;
+
+    case E_EEPROM_JOB_CLEAR:
+        /* data[0] selects the page */
+        data[1] = ow_clear_memory_ds2431((owPage)data[0]);
+        data[2] = 0;
+        data[3] = 0;
+        data[4] = 0;
+        data[5] = 0;
+        break;
+
+    case E_EEPROM_JOB_BKCTEST:
+        data[1] = ow_BKCTest();
+        data[0] = CMD_BKCTEST_STARTTEST;
+        data[2] = 0;
+        data[3] = 0;
+        data[4] = 0;
+        data[5] = 0;
+        break;
+
+    case E_EEPROM_JOB_ROMID:
+        ow_split_ROMID_ds2431(romid);
+        if (!eeprom_job_b_romid_sent) {
+            data[0] = CMD_EEPROMID_READ;
+            memcpy(&data[1], &romid[0], 4);
+            data[5] = 0;
+            eeprom_job_answer(p_job->type, data, 0);
+            eeprom_job_b_romid_sent = 1;
+            eeprom_job_romid_tick = HAL_GetTick();
+            return 0;
+        }
+        if ((HAL_GetTick() - eeprom_job_romid_tick) < EEPROM_JOB_ROMID_GAP) {
+            return 0;
+        }
+        eeprom_job_b_romid_sent = 0;
+        data[0] = CMD_EEPROMID_READ_PACKET2;
+        memcpy(&data[1], &romid[4], 4);
+        data[5] = 0;
+        break;
+
+    default:
+        return 1;
+    }
+    eeprom_job_answer(p_job->type, data, 0);
+    return 1;
+}
+
+/**********************************************************
+ ** Name            : eeprom_job_answer
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Sends the answer of a job. From the main loop, the
+ **                   FDCAN2 interrupt is disabled meanwhile, as it sends
+ **                   messages too.
+ **
+ ** Calling         : eeprom_job_push, eeprom_job_run
+ **
+ ** InputValues     : eeprom_job_type_t type, answer, uint8_t b_from_isr
+ ** OutputValues    : void
+ **********************************************************/
+static void eeprom_job_answer(eeprom_job_type_t type, uint8_t data[FDCAN2_DATA_SIZE], uint8_t b_from_isr) {
+    data[6] = CAN_SW_ID_SystemTorch_FW;
+    data[7] = TORCH_ID;
+    if (b_from_isr) {
+        fdcan2_send(eeprom_job_answer_id[type], data);
+        return;
+    }
+    HAL_NVIC_DisableIRQ(FDCAN2_IT0_IRQn);
+    fdcan2_send(eeprom_job_answer_id[type], data);
+    HAL_NVIC_EnableIRQ(FDCAN2_IT0_IRQn);
+}
@@ -0,0 +1,61 @@
+/*
+******************************************************************************
+* @file: eeprom_job.h
+* @author:
+* @brief: Queue of the EEPROM jobs commanded over CAN
+******************************************************************************
+*
+******************************************************************************
+*/
+
+#ifndef _EEPROM_JOB_H
+#define _EEPROM_JOB_H
+
+/*** Include *****************************************************************/
+#include "types.h"
+
+/* NO MORE DEFINITIONS */
+
+/*** Preprocessor definitions ************************************************/
+#define EEPROM_JOB_QUEUE_SIZE 4   // maximum number of waiting jobs, power of 2
+#define EEPROM_JOB_ROMID_GAP  100 // ms between the two 0x1FA packets of the ROM ID
+
+/* CO_GET_EEPROMJOBS selectors, data[2] of the request */
+#define EEPROM_JOB_SEL_QUEUE   0x00 // waiting jobs, maximum of waiting jobs and dropped jobs
+#define EEPROM_JOB_SEL_LATENCY 0x01 // latency of the last job and maximum latency [ms]
+#define EEPROM_JOB_SEL_JOBS    0x02 // executed jobs
+
+/*** Definition of variables *************************************************/
+
+/* jobs commanded over CAN */
+typedef enum {
+    E_EEPROM_JOB_TORCHTYPE_WRITE, // 0x1E0 CMD_TORCHTYPE_WRITE, answered by 0x1E1
+    E_EEPROM_JOB_TORCHTYPE_READ,  // 0x1E0 CMD_TORCHTYPE_READ, answered by 0x1E1
+    E_EEPROM_JOB_CLEAR,           // 0x1E2, answered by 0x1E3
+    E_EEPROM_JOB_BKCTEST,         // 0x1E4 CMD_BKCTEST_STARTTEST, answered by 0x1E5
+    E_EEPROM_JOB_ROMID,           // 0x1FB CMD_EEPROMID_READ, answered by two 0x1FA packets
+    E_EEPROM_JOB_N
+} eeprom_job_type_t;
+
+/* statistics of the job queue */
+typedef struct {
+    uint32_t jobs;        // executed jobs
+    uint32_t drops;       // jobs rejected because the queue was full
+    uint8_t depth;        // waiting jobs
+    uint8_t depth_max;    // maximum of waiting jobs
+    uint32_t latency;     // ms from the reception to the answer of the last job
+    uint32_t latency_max; // maximum of latency
+} eeprom_job_stats_t;
+
+/*** Prototypes of functions *************************************************/
+int eeprom_job_push(eeprom_job_type_t type, const uint8_t *p_data);
+void eeprom_job_process(void);
+void eeprom_job_get_stats(eeprom_job_stats_t *p_stats);
+void eeprom_job_get_can(uint8_t select, uint8_t data[4]);
+
+/* NO MORE DEFINITIONS */
+
+/*** Definitions of functions ************************************************/
+/* NO MORE DEFINITIONS */
+
+#endif //_EEPROM_JOB_H
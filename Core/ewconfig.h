@@ -323,6 +323,34 @@
 #define EW_MAX_ISSUE_TASKS                 6
 
 
+/* ******************************************************************************
+   Following macros configure the capacity of the static object pools used by the
+   Runtime Environment to store pending signals and registered observers. As long
+   as a pool is not exhausted, posting a signal or attaching an observer does not
+   allocate memory from the heap. Once a pool is exhausted, further entries are
+   allocated from the heap as usual.
+
+   EW_SIGNAL_POOL_SIZE - This macro specifies the number of pending signals which
+   can be stored without any heap allocation. The value for this macro is an
+   integer number lying between 0 and 1024. The following quotation can be used
+   to calculate the approximated RAM usage: EW_SIGNAL_POOL_SIZE * 20 Byte.
+
+   EW_OBSERVER_POOL_SIZE - This macro specifies the number of observers which can
+   be registered without any heap allocation. The value for this macro is an
+   integer number lying between 0 and 1024. The following quotation can be used
+   to calculate the approximated RAM usage: EW_OBSERVER_POOL_SIZE * 24 Byte.
+
+   EW_OBSERVER_HASH_SIZE - This macro specifies the number of buckets used to
+   index the registered observers by the observed object, property and Id. The
+   value for this macro has to be a power of two lying between 1 and 256. The
+   following quotation can be used to calculate the approximated RAM usage:
+   ( EW_OBSERVER_HASH_SIZE * 3 * 4 ) Byte.
+   **************************************************************************** */
+#define EW_SIGNAL_POOL_SIZE               32
+#define EW_OBSERVER_POOL_SIZE             32
+#define EW_OBSERVER_HASH_SIZE             16
+
+
 /* ******************************************************************************
    Following macros configure the behavior of the surface cache and treatment
    of bitmap resources when these are generated with in the 'compressed' mode.
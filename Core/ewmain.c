@@ -110,9 +110,13 @@
 static void EwUpdate( XViewport* aViewport, CoreRoot aApplication );
 XEnum EwGetKeyCommand( void );
 
-static CoreRoot     RootObject;
-static XViewport*   Viewport;
-static XDisplayInfo DisplayInfo;
+static CoreRoot       RootObject;
+static XViewport*     Viewport;
+static XDisplayInfo   DisplayInfo;
+
+/* canvas used for every screen update - created once and kept alive for the
+   entire lifetime of the application to avoid allocations in the render path */
+static GraphicsCanvas Canvas;
 
 
 /*******************************************************************************
@@ -176,6 +180,14 @@ int EwInit( void )
     0, 255, DisplayInfo.FrameBuffer, DisplayInfo.DoubleBuffer, 0, 0 );
   CHECK_HANDLE( Viewport );
 
+  /* create the canvas object used for all screen updates and lock it, so that
+     the garbage collector will never release it */
+  EwPrint( "Create Embedded Wizard Canvas...             " );
+  Canvas = EwNewObject( GraphicsCanvas, 0 );
+  CHECK_HANDLE( Canvas );
+
+  EwLockObject( Canvas );
+
   /* initialize your device driver(s) that provide data for your GUI */
   DeviceDriver_Initialize();
 
@@ -207,6 +219,7 @@ void EwDone( void )
   /* destroy the applications root object and release unused resources and memory */
   EwPrint( "Shutting down Application...                 " );
   EwDoneViewport( Viewport );
+  EwUnlockObject( Canvas );
   EwUnlockObject( RootObject );
   EwReclaimMemory();
   EwPrint( "[OK]\n" );
@@ -229,6 +242,7 @@ void EwDone( void )
   EwBspDisplayDone( &DisplayInfo );
 
   Viewport   = 0;
+  Canvas     = 0;
   RootObject = 0;
 #endif //0 //XXXX
 
@@ -305,7 +319,9 @@ int EwProcess( void )
 *   EwUpdate
 *
 * DESCRIPTION:
-*   The function EwUpdate performs the screen update of the dirty area.
+*   The function EwUpdate performs the screen update of the dirty area. The
+*   drawing is done into the persistent canvas object created within EwInit(),
+*   so no objects are allocated per frame.
 *
 * ARGUMENTS:
 *   aViewPort    - Viewport used for the screen update.
@@ -318,7 +334,7 @@ int EwProcess( void )
 static void EwUpdate( XViewport* aViewport, CoreRoot aApplication )
 {
   XBitmap*       bitmap;
-  GraphicsCanvas canvas     = EwNewObject( GraphicsCanvas, 0 );
+  GraphicsCanvas canvas     = Canvas;
   XRect          updateRect = {{ 0, 0 }, { 0, 0 }};
 
   if ( !canvas )
@@ -14,6 +14,11 @@
 #include "bootloader_util.h"
 #include "TestBoard.h"
 #include "DS2431.h"
+#include "boot.h"
+#include "eeprom_job.h"
+#include "cpu_load.h"
+#include "inout.h"
+#include "trace.h"
 
 // CAN transmit instance struct
 typedef struct mcal_can_tx_ins {
@@ -39,6 +44,14 @@ FDCAN_HandleTypeDef hfdcan2;
 param_info_to_gui mapro_to_gui_update_param;
 uint8_t rx_buff[8];
 
+/* sequence number of the last parameter snapshot read by the GUI and of the last one consumed by the GUI,
+ * both are written in main context only */
+static uint32_t param_seq_read = 0;
+static volatile uint32_t param_seq_consumed = 0;
+
+/* parameter ID of the last completed write of the parameter data, for readers which must not wait */
+static volatile uint8_t param_id_written = 0;
+
 static mcal_can_tx_ins_t tx[MCAL_CAN2_TX_NUM];
 
 static FDCAN_HandleTypeDef *p_hfdcan;
@@ -49,11 +62,37 @@ static FDCAN_ErrorCountersTypeDef fdcan_error_counters;
 static can_error_counters fdcan_error_type_counters;
 static uint8_t can_busoff_flag = 0;
 
+static void param_write_begin(void);
+static void param_write_end(void);
+static int param_is_consumed(void);
+static uint32_t param_read(param_info_to_gui *can_param_data);
+static void fdcan2_diag_answer(uint8_t data[FDCAN2_DATA_SIZE]);
+static void fdcan2_diag_boottime(uint8_t select, uint8_t data[4]);
+static void fdcan2_diag_testtime(uint8_t select, uint8_t data[4]);
+static void fdcan2_diag_keylatency(uint8_t select, uint8_t data[4]);
+static void fdcan2_diag_seriallog(uint8_t select, uint8_t data[4]);
+
+/* diagnostic commands of 0x400: data[2] of the request selects the values, the getter writes 4 bytes into data[3]
+ * to data[6] of the answer, data[3] of the request may select further */
+typedef void(fdcan2_diag_get_t)(uint8_t select, uint8_t data[4]);
+
+typedef struct {
+    uint8_t command;
+    fdcan2_diag_get_t *p_get;
+} fdcan2_diag_t;
+
+static const fdcan2_diag_t fdcan2_diag[] = {
+    {CO_GET_BOOTTIME, fdcan2_diag_boottime},
+    {CO_GET_EEPROMJOBS, eeprom_job_get_can},
+    {CO_GET_TESTTIME, fdcan2_diag_testtime},
+    {CO_GET_KEYLATENCY, fdcan2_diag_keylatency},
+    {CO_GET_SERIALLOG, fdcan2_diag_seriallog},
+    {CO_GET_CPULOAD, cpu_load_get_can},
+};
+
 extern test_result_status_t TestResult;
 extern test_state_status_t TestState;
 extern uint8_t TestMode;
-extern uint16_t TestModeTimeout;
-extern uint16_t TestModeLEDTimeout;
 extern test_stage_t e_TestStage;
 extern SE_FwExchgData_TypeDef BL_ExcData; // Excange Data von Bootloader
 
@@ -226,20 +265,34 @@ void fdcan2_send(int msg_id, uint8_t data[FDCAN2_DATA_SIZE]) {
 
 /**
  * @brief  param_clear_flag
+ * @note   Marks the parameter snapshot last read by param_update_to_gui() as consumed. Only the sequence number
+ *         is stored, so the parameter data itself is written by the FDCAN2 interrupt only.
  * @param  void.
  * @retval void.
  */
 void param_clear_flag() {
-    mapro_to_gui_update_param.flag = MSG_0x110_clearall;
+    param_seq_consumed = param_seq_read;
 }
 
 /**
  * @brief  get_param_id
+ * @note   Seqlock read of the parameter ID without waiting, so the key interrupts may call it while they preempt
+ *         a write of the parameter data. The ID of the last completed write is returned then.
  * @param  void.
  * @retval uint8_t Paramter ID.
  */
 uint8_t get_param_id() {
-    return mapro_to_gui_update_param.ID;
+    uint32_t seq = mapro_to_gui_update_param.seq_number;
+    uint8_t id;
+
+    __DMB();
+    id = mapro_to_gui_update_param.ID;
+    __DMB();
+    if ((seq & 1) || (seq != mapro_to_gui_update_param.seq_number)) {
+        id = param_id_written;
+    }
+
+    return id;
 }
 
 /**
@@ -248,16 +301,129 @@ uint8_t get_param_id() {
  * @retval void.
  */
 void param_update_to_gui(param_info_to_gui *can_param_data) {
-    can_param_data->flag = mapro_to_gui_update_param.flag;
-    can_param_data->ID = mapro_to_gui_update_param.ID;
-    can_param_data->image = mapro_to_gui_update_param.image;
-    can_param_data->max = mapro_to_gui_update_param.max;
-    can_param_data->min = mapro_to_gui_update_param.min;
-    can_param_data->text = mapro_to_gui_update_param.text;
-    can_param_data->type = mapro_to_gui_update_param.type;
-    can_param_data->unit_id = mapro_to_gui_update_param.unit_id;
-    can_param_data->value = mapro_to_gui_update_param.value;
-    can_param_data->total_params = mapro_to_gui_update_param.total_params;
+    uint32_t seq = param_read(can_param_data);
+
+    param_seq_read = seq;
+
+    /* nothing new since the last consumed snapshot */
+    if (seq == param_seq_consumed) {
+        can_param_data->flag = MSG_0x110_clearall;
+    }
+}
+
+/**
+ * @brief  param_get_snapshot
+ * @note   Reads a consistent copy of the parameter data without marking it as read by the GUI.
+ * @param  can_param_data: pointer to the copy.
+ * @retval void.
+ */
+void param_get_snapshot(param_info_to_gui *can_param_data) {
+    param_read(can_param_data);
+}
+
+/**
+ * @brief  param_restore
+ * @note   Writes previously saved parameter data as if it was received. Only done as long as no parameter data
+ *         was received, the FDCAN2 interrupt is disabled meanwhile to keep it the single writer.
+ * @param  can_param_data: pointer to the saved parameter data.
+ * @retval int. 1 if the data was written, 0 if parameter data was already received.
+ */
+int param_restore(const param_info_to_gui *can_param_data) {
+    int b_restored = 0;
+
+    HAL_NVIC_DisableIRQ(FDCAN2_IT0_IRQn);
+    if (mapro_to_gui_update_param.seq_number == 0) {
+        param_write_begin();
+        mapro_to_gui_update_param.ID = can_param_data->ID;
+        mapro_to_gui_update_param.unit_id = can_param_data->unit_id;
+        mapro_to_gui_update_param.type = can_param_data->type;
+        mapro_to_gui_update_param.image = can_param_data->image;
+        mapro_to_gui_update_param.text = can_param_data->text;
+        mapro_to_gui_update_param.total_params = can_param_data->total_params;
+        mapro_to_gui_update_param.total_qas = can_param_data->total_qas;
+        mapro_to_gui_update_param.value = can_param_data->value;
+        mapro_to_gui_update_param.min = can_param_data->min;
+        mapro_to_gui_update_param.max = can_param_data->max;
+        mapro_to_gui_update_param.flag = MSG_0x110_setID;
+        param_write_end();
+        b_restored = 1;
+    }
+    HAL_NVIC_EnableIRQ(FDCAN2_IT0_IRQn);
+
+    return b_restored;
+}
+
+/**
+ * @brief  param_set_test_mode
+ * @note   Reuses the parameter data to enter the test mode screen of the GUI.
+ * @param  id, unit_id, type, image: parameter data for the GUI.
+ * @retval void.
+ */
+void param_set_test_mode(uint8_t id, uint8_t unit_id, uint8_t type, uint8_t image) {
+    param_write_begin();
+    mapro_to_gui_update_param.ID = id;
+    mapro_to_gui_update_param.unit_id = unit_id;
+    mapro_to_gui_update_param.type = type;
+    mapro_to_gui_update_param.image = image;
+    mapro_to_gui_update_param.flag = MSG_0x110_setID;
+    param_write_end();
+}
+
+/**
+ * @brief  param_write_begin
+ * @note   Starts a write of the parameter data, the sequence number becomes odd. Must only be called in the
+ *         FDCAN2 interrupt context or with the FDCAN2 interrupt disabled, so there is a single writer of the
+ *         parameter data.
+ * @param  void.
+ * @retval void.
+ */
+static void param_write_begin(void) {
+    mapro_to_gui_update_param.seq_number++;
+    __DMB();
+}
+
+/**
+ * @brief  param_write_end
+ * @note   Finishes a write of the parameter data, the sequence number becomes even again. The ID is saved for
+ *         get_param_id().
+ * @param  void.
+ * @retval void.
+ */
+static void param_write_end(void) {
+    param_id_written = mapro_to_gui_update_param.ID;
+    __DMB();
+    mapro_to_gui_update_param.seq_number++;
+}
+
+/**
+ * @brief  param_is_consumed
+ * @param  void.
+ * @retval int. 1 if the GUI consumed the actual parameter data, 0 if not.
+ */
+static int param_is_consumed(void) {
+    return (mapro_to_gui_update_param.seq_number == param_seq_consumed);
+}
+
+/**
+ * @brief  param_read
+ * @note   Seqlock read of the parameter data, repeats until the data was not modified by the FDCAN2 interrupt while
+ *         copying.
+ * @param  can_param_data: pointer to the copy.
+ * @retval uint32_t. Sequence number of the copy.
+ */
+static uint32_t param_read(param_info_to_gui *can_param_data) {
+    uint32_t seq;
+
+    do {
+        seq = mapro_to_gui_update_param.seq_number;
+        __DMB();
+        *can_param_data = mapro_to_gui_update_param;
+        __DMB();
+    } while ((seq & 1) || (seq != mapro_to_gui_update_param.seq_number));
+
+    can_param_data->seq_number = seq;
+
+    return seq;
 }
 
 /**
@@ -266,7 +432,11 @@ void param_update_to_gui(param_info_to_gui *can_param_data) {
  * @retval void.
  */
 void FDCAN2_IT0_IRQHandler(void) {
+    cpu_isr_frame_t frame;
+
+    cpu_load_isr_enter(E_CPU_ISR_FDCAN2, &frame);
     HAL_FDCAN_IRQHandler(&hfdcan2);
+    cpu_load_isr_exit(E_CPU_ISR_FDCAN2, &frame);
 }
 
 /**
@@ -276,72 +446,80 @@ void FDCAN2_IT0_IRQHandler(void) {
  */
 void HAL_FDCAN_RxFifo0Callback(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo0ITs) {
     FDCAN_RxHeaderTypeDef can_rx_head;
-    uint8_t *ptrDataRead;
-    uint32_t u32torchtpetowrite;
-    uint8_t splitromid[8];
 
     if (HAL_FDCAN_GetRxMessage(&hfdcan2, FDCAN_RX_FIFO0, &can_rx_head, rx_buff)) {
     }
+    TRACE2(TRACE_CAN_RX, can_rx_head.Identifier, rx_buff[0]);
 
     switch (can_rx_head.Identifier) {
     case MSG_VALUE_UPDATE: {
         if (rx_buff[0] == MSG_0x110_ActPar) {
-            if (mapro_to_gui_update_param.flag == MSG_0x110_clearall) {
-                mapro_to_gui_update_param.ID = rx_buff[1];
-                mapro_to_gui_update_param.flag = MSG_0x110_setID;
-            }
-            if ((rx_buff[2] == MSG_0x110_value) && (mapro_to_gui_update_param.ID == rx_buff[1])) {
-                mapro_to_gui_update_param.value = get_float(&rx_buff[3]);
-                if (mapro_to_gui_update_param.ID == MSG_0x110_ID_11) {
-                    mapro_to_gui_update_param.value =
-                        (mapro_to_gui_update_param.value / MSG_0x110_ID_11_step) - MSG_0x110_ID_11_MAX;
-                    mapro_to_gui_update_param.value = round(mapro_to_gui_update_param.value);
-                }
-                if (mapro_to_gui_update_param.ID == MSG_0x110_ID_12) {
-                    mapro_to_gui_update_param.value =
-                        (mapro_to_gui_update_param.value / MSG_0x110_ID_12_step) - MSG_0x110_ID_12_MAX;
-                }
-                mapro_to_gui_update_param.flag = MSG_0x110_setvalue;
-            } else if ((rx_buff[2] == MSG_0x110_min) && (mapro_to_gui_update_param.ID == rx_buff[1])) {
-                mapro_to_gui_update_param.min = get_float(&rx_buff[3]);
-                if (mapro_to_gui_update_param.ID == MSG_0x110_ID_11) {
-                    mapro_to_gui_update_param.min =
-                        (mapro_to_gui_update_param.min / MSG_0x110_ID_11_step) - MSG_0x110_ID_11_MAX;
-                    mapro_to_gui_update_param.min = round(mapro_to_gui_update_param.min);
-                }
-                if (mapro_to_gui_update_param.ID == MSG_0x110_ID_12) {
-                    mapro_to_gui_update_param.min =
-                        (mapro_to_gui_update_param.min / MSG_0x110_ID_12_step) - MSG_0x110_ID_12_MAX;
+            int b_consumed = param_is_consumed();
+
+            /* only messages for the latched parameter ID are written, a new ID is latched once the GUI consumed
+             * the last update */
+            if (b_consumed || (mapro_to_gui_update_param.ID == rx_buff[1])) {
+                param_write_begin();
+                if (b_consumed) {
+                    mapro_to_gui_update_param.ID = rx_buff[1];
+                    mapro_to_gui_update_param.flag = MSG_0x110_setID;
                 }
-                mapro_to_gui_update_param.flag = MSG_0x110_setmin;
-            } else if ((rx_buff[2] == MSG_0x110_max) && (mapro_to_gui_update_param.ID == rx_buff[1])) {
-                mapro_to_gui_update_param.max = get_float(&rx_buff[3]);
-                // below logic is not 100% fail proof but for current scenerio works well as the max value more than 2
-                // will not be received at all. Modify/change later
-                if (mapro_to_gui_update_param.ID == MSG_0x110_ID_11) {
-                    mapro_to_gui_update_param.max =
-                        (mapro_to_gui_update_param.max / MSG_0x110_ID_11_step) - MSG_0x110_ID_11_MAX;
-                    mapro_to_gui_update_param.max = round(mapro_to_gui_update_param.max);
-                }
-                if (mapro_to_gui_update_param.ID == MSG_0x110_ID_12) {
-                    mapro_to_gui_update_param.max =
-                        (mapro_to_gui_update_param.max / MSG_0x110_ID_12_step) - MSG_0x110_ID_12_MAX;
-                }
-                mapro_to_gui_update_param.flag = MSG_0x110_setmax;
-            } else if ((rx_buff[2] == MSG_0x110_format) && (mapro_to_gui_update_param.ID == rx_buff[1])) {
-                {
-                    mapro_to_gui_update_param.unit_id = rx_buff[3];
-                    mapro_to_gui_update_param.type = rx_buff[4];
-                    mapro_to_gui_update_param.image = rx_buff[5];
-                    mapro_to_gui_update_param.text = rx_buff[6];
-                    mapro_to_gui_update_param.flag = MSG_0x110_setformat;
+                if ((rx_buff[2] == MSG_0x110_value) && (mapro_to_gui_update_param.ID == rx_buff[1])) {
+                    mapro_to_gui_update_param.value = get_float(&rx_buff[3]);
+                    if (mapro_to_gui_update_param.ID == MSG_0x110_ID_11) {
+                        mapro_to_gui_update_param.value =
+                            (mapro_to_gui_update_param.value / MSG_0x110_ID_11_step) - MSG_0x110_ID_11_MAX;
+                        mapro_to_gui_update_param.value = round(mapro_to_gui_update_param.value);
+                    }
+                    if (mapro_to_gui_update_param.ID == MSG_0x110_ID_12) {
+                        mapro_to_gui_update_param.value =
+                            (mapro_to_gui_update_param.value / MSG_0x110_ID_12_step) - MSG_0x110_ID_12_MAX;
+                    }
+                    mapro_to_gui_update_param.flag = MSG_0x110_setvalue;
+                } else if ((rx_buff[2] == MSG_0x110_min) && (mapro_to_gui_update_param.ID == rx_buff[1])) {
+                    mapro_to_gui_update_param.min = get_float(&rx_buff[3]);
+                    if (mapro_to_gui_update_param.ID == MSG_0x110_ID_11) {
+                        mapro_to_gui_update_param.min =
+                            (mapro_to_gui_update_param.min / MSG_0x110_ID_11_step) - MSG_0x110_ID_11_MAX;
+                        mapro_to_gui_update_param.min = round(mapro_to_gui_update_param.min);
+                    }
+                    if (mapro_to_gui_update_param.ID == MSG_0x110_ID_12) {
+                        mapro_to_gui_update_param.min =
+                            (mapro_to_gui_update_param.min / MSG_0x110_ID_12_step) - MSG_0x110_ID_12_MAX;
+                    }
+                    mapro_to_gui_update_param.flag = MSG_0x110_setmin;
+                } else if ((rx_buff[2] == MSG_0x110_max) && (mapro_to_gui_update_param.ID == rx_buff[1])) {
+                    mapro_to_gui_update_param.max = get_float(&rx_buff[3]);
+                    // below logic is not 100% fail proof but for current scenerio works well as the max value more
+                    // than 2 will not be received at all. Modify/change later
+                    if (mapro_to_gui_update_param.ID == MSG_0x110_ID_11) {
+                        mapro_to_gui_update_param.max =
+                            (mapro_to_gui_update_param.max / MSG_0x110_ID_11_step) - MSG_0x110_ID_11_MAX;
+                        mapro_to_gui_update_param.max = round(mapro_to_gui_update_param.max);
+                    }
+                    if (mapro_to_gui_update_param.ID == MSG_0x110_ID_12) {
+                        mapro_to_gui_update_param.max =
+                            (mapro_to_gui_update_param.max / MSG_0x110_ID_12_step) - MSG_0x110_ID_12_MAX;
+                    }
+                    mapro_to_gui_update_param.flag = MSG_0x110_setmax;
+                } else if ((rx_buff[2] == MSG_0x110_format) && (mapro_to_gui_update_param.ID == rx_buff[1])) {
+                    {
+                        mapro_to_gui_update_param.unit_id = rx_buff[3];
+                        mapro_to_gui_update_param.type = rx_buff[4];
+                        mapro_to_gui_update_param.image = rx_buff[5];
+                        mapro_to_gui_update_param.text = rx_buff[6];
+                        mapro_to_gui_update_param.flag = MSG_0x110_setformat;
+                    }
                 }
+                param_write_end();
             }
         }
     } break;
     case MSG_TORCH_STATE: {
+        param_write_begin();
         mapro_to_gui_update_param.total_params = rx_buff[1];
         mapro_to_gui_update_param.total_qas = rx_buff[2];
+        param_write_end();
     } break;
     case MSG_0x200:
         if (rx_buff[3] == 'A' && rx_buff[4] == 'C' && rx_buff[5] == 'K') {
@@ -361,91 +539,28 @@ void HAL_FDCAN_RxFifo0Callback(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo0ITs)
     case MSG_0x1E4: // Test BKC
     {
         if (rx_buff[6] == CAN_SW_ID_SystemTorch_FW && rx_buff[7] == TORCH_ID && rx_buff[0] == CMD_BKCTEST_STARTTEST) {
-            rx_buff[1] = ow_BKCTest();
-            rx_buff[0] = CMD_BKCTEST_STARTTEST;
-            rx_buff[2] = 0;
-            rx_buff[3] = 0;
-            rx_buff[4] = 0;
-            rx_buff[5] = 0;
-            rx_buff[6] = CAN_SW_ID_SystemTorch_FW;
-            rx_buff[7] = TORCH_ID;
-            fdcan2_send(MSG_0x1E5, rx_buff); // ack
+            eeprom_job_push(E_EEPROM_JOB_BKCTEST, rx_buff); // answered by 0x1E5
         }
     } break;
     case MSG_0x1FB: // EEPROM ID request
     {
         if (rx_buff[6] == CAN_SW_ID_SystemTorch_FW && rx_buff[7] == TORCH_ID && rx_buff[0] == CMD_EEPROMID_READ) {
-            ow_split_ROMID_ds2431(&(splitromid[0]));
-            // packet 1
-            rx_buff[0] = CMD_EEPROMID_READ;
-            rx_buff[1] = splitromid[0];
-            rx_buff[2] = splitromid[1];
-            rx_buff[3] = splitromid[2];
-            rx_buff[4] = splitromid[3];
-            rx_buff[5] = 0x00;
-            rx_buff[6] = CAN_SW_ID_SystemTorch_FW;
-            rx_buff[7] = TORCH_ID;
-            fdcan2_send(MSG_0x1FA, rx_buff);
-            HAL_Delay(100);
-            // packet 2
-            rx_buff[0] = CMD_EEPROMID_READ_PACKET2;
-            rx_buff[1] = splitromid[4];
-            rx_buff[2] = splitromid[5];
-            rx_buff[3] = splitromid[6];
-            rx_buff[4] = splitromid[7];
-            rx_buff[5] = 0x00;
-            rx_buff[6] = CAN_SW_ID_SystemTorch_FW;
-            rx_buff[7] = TORCH_ID;
-            fdcan2_send(MSG_0x1FA, rx_buff);
+            eeprom_job_push(E_EEPROM_JOB_ROMID, rx_buff); // answered by 2 packets of 0x1FA
         }
     } break;
     case MSG_0x1E0: // torch type read/write
     {
         if (rx_buff[6] == CAN_SW_ID_SystemTorch_FW && rx_buff[7] == TORCH_ID && rx_buff[0] == CMD_TORCHTYPE_WRITE) {
-            u32torchtpetowrite = (rx_buff[1] | rx_buff[2] << 8 | rx_buff[3] << 16 | rx_buff[4] << 24);
-            rx_buff[1] = ow_Write_TorchType(u32torchtpetowrite);
-            rx_buff[0] = CMD_TORCHTYPE_WRITE;
-            rx_buff[2] = 0;
-            rx_buff[3] = 0;
-            rx_buff[4] = 0;
-            rx_buff[5] = 0;
-            rx_buff[6] = CAN_SW_ID_SystemTorch_FW;
-            rx_buff[7] = TORCH_ID;
-            fdcan2_send(MSG_0x1E1, rx_buff);
+            eeprom_job_push(E_EEPROM_JOB_TORCHTYPE_WRITE, rx_buff); // answered by 0x1E1
         }
         if (rx_buff[6] == CAN_SW_ID_SystemTorch_FW && rx_buff[7] == TORCH_ID && rx_buff[0] == CMD_TORCHTYPE_READ) {
-
-            rx_buff[5] = ow_read_TorchType(&u32torchtpetowrite);
-            if (rx_buff[5] == CMD_BKCTEST_PASS) {
-                ptrDataRead = (uint8_t *)&u32torchtpetowrite;
-                rx_buff[1] = *ptrDataRead++;
-                rx_buff[2] = *ptrDataRead++;
-                rx_buff[3] = *ptrDataRead++;
-                rx_buff[4] = *ptrDataRead++;
-            } else {
-                rx_buff[1] = 0;
-                rx_buff[2] = 0;
-                rx_buff[3] = 0;
-                rx_buff[4] = 0;
-            }
-
-            rx_buff[0] = CMD_TORCHTYPE_READ;
-            rx_buff[6] = CAN_SW_ID_SystemTorch_FW;
-            rx_buff[7] = TORCH_ID;
-            fdcan2_send(MSG_0x1E1, rx_buff);
+            eeprom_job_push(E_EEPROM_JOB_TORCHTYPE_READ, rx_buff); // answered by 0x1E1
         }
     } break;
     case MSG_0x1E2: // EEPROM clear
     {
         if (rx_buff[6] == CAN_SW_ID_SystemTorch_FW && rx_buff[7] == TORCH_ID) {
-            rx_buff[1] = ow_clear_memory_ds2431((owPage)rx_buff[0]);
-            rx_buff[2] = 0;
-            rx_buff[3] = 0;
-            rx_buff[4] = 0;
-            rx_buff[5] = 0;
-            rx_buff[6] = CAN_SW_ID_SystemTorch_FW;
-            rx_buff[7] = TORCH_ID;
-            fdcan2_send(MSG_0x1E3, rx_buff);
+            eeprom_job_push(E_EEPROM_JOB_CLEAR, rx_buff); // answered by 0x1E3
         }
     } break;
     case MSG_COMMTEST: {
@@ -497,6 +612,10 @@ void HAL_FDCAN_RxFifo0Callback(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo0ITs)
                     fdcan2_send(MSG_0x401, rx_buff);
                 }
                 break;
+
+            default:
+                fdcan2_diag_answer(rx_buff);
+                break;
             }
         }
     } break;
@@ -578,6 +697,86 @@ void HAL_FDCAN_ErrorStatusCallback(FDCAN_HandleTypeDef *hfdcan, uint32_t ErrorSt
     }
 }
 
+/**
+ * @brief  Answer a diagnostic command of 0x400 by its getter, requests for other torches are ignored
+ * @param  data: received message, data[0] and data[1] are left untouched in the answer
+ * @retval none
+ */
+static void fdcan2_diag_answer(uint8_t data[FDCAN2_DATA_SIZE]) {
+    for (uint8_t i = 0; i < (sizeof(fdcan2_diag) / sizeof(fdcan2_diag[0])); i++) {
+        if (fdcan2_diag[i].command == data[1]) {
+            if (data[7] == TORCH_ID) {
+                fdcan2_diag[i].p_get(data[2], &data[3]);
+                fdcan2_send(MSG_0x401, data);
+            }
+            return;
+        }
+    }
+}
+
+/**
+ * @brief  Getters of the diagnostic commands without their own CAN getter
+ * @param  select: data[2] of the request
+ * @param  data: data[3] to data[6] of the answer
+ * @retval none
+ */
+static void fdcan2_diag_boottime(uint8_t select, uint8_t data[4]) {
+    data[0] = BOOT_TIME_N;
+    fdcan2_put_u16(&data[1], boot_get_time(select));
+    data[3] = 0;
+}
+
+/* the time in ms is 24 bit wide, the key step alone takes up to KEY_TIMEOUT = 60 s */
+static void fdcan2_diag_testtime(uint8_t select, uint8_t data[4]) {
+    uint32_t time = Get_TestTime(select);
+
+    fdcan2_put_u32(&data[0], (time > 0xFFFFFFU) ? 0xFFFFFFU : time);
+    data[3] = (uint8_t)e_TestStage;
+}
+
+static void fdcan2_diag_keylatency(uint8_t select, uint8_t data[4]) {
+    uint32_t latency, latency_max;
+
+    (void)select;
+    inout_get_key_latency(&latency, &latency_max);
+    fdcan2_put_u16(&data[0], latency);
+    fdcan2_put_u16(&data[2], latency_max);
+}
+
+static void fdcan2_diag_seriallog(uint8_t select, uint8_t data[4]) {
+    serial_log_stats_t stats;
+
+    (void)select;
+    Serial_COM_GetLogStats(&stats);
+    fdcan2_put_u16(&data[0], stats.drops);
+    fdcan2_put_u16(&data[2], stats.fill_max);
+}
+
+/**
+ * @brief  Write a value saturated to 16 bit, little endian, into a message
+ * @param  p_data: 2 bytes of the message
+ * @param  value: value
+ * @retval none
+ */
+void fdcan2_put_u16(uint8_t *p_data, uint32_t value) {
+    value = (value > UINT16_MAX) ? UINT16_MAX : value;
+    p_data[0] = (uint8_t)(value & 0xff);
+    p_data[1] = (uint8_t)((value & 0xff00) >> 8);
+}
+
+/**
+ * @brief  Write a 32 bit value, little endian, into a message
+ * @param  p_data: 4 bytes of the message
+ * @param  value: value
+ * @retval none
+ */
+void fdcan2_put_u32(uint8_t *p_data, uint32_t value) {
+    p_data[0] = (uint8_t)(value & 0xff);
+    p_data[1] = (uint8_t)((value & 0xff00) >> 8);
+    p_data[2] = (uint8_t)((value & 0xff0000) >> 16);
+    p_data[3] = (uint8_t)((value & 0xff000000) >> 24);
+}
+
 /**
  * @brief  All below functions are called from gui.c to update CAN information to display
  * @param  void
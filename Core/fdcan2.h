@@ -56,6 +56,7 @@ typedef struct {
     float value;
     float min;
     float max;
+    uint32_t seq_number; // Seqlock counter, has to be even and equal before and after reading this struct
 } param_info_to_gui;
 
 /**
@@ -88,6 +89,15 @@ int fdcan2_receive(int *p_msg_id, uint8_t data[FDCAN2_DATA_SIZE]);
  */
 void fdcan2_send(int msg_id, uint8_t data[FDCAN2_DATA_SIZE]);
 
+/**
+ * @brief Write a value into a message, little endian. fdcan2_put_u16() saturates to 16 bit.
+ * @param p_data: 2 or 4 bytes of the message
+ * @param value: value
+ * @retval none
+ */
+void fdcan2_put_u16(uint8_t *p_data, uint32_t value);
+void fdcan2_put_u32(uint8_t *p_data, uint32_t value);
+
 uint8_t fdcan2_bus_status(void);
 uint32_t fdcan2_error_count(void);
 uint8_t fdcan2_ack_error_count(void);
@@ -100,4 +110,7 @@ void fdcan2_clear_busoffflag(void);
 void param_update_to_gui(param_info_to_gui *);
 void param_clear_flag(void);
 uint8_t get_param_id(void);
+void param_set_test_mode(uint8_t id, uint8_t unit_id, uint8_t type, uint8_t image);
+void param_get_snapshot(param_info_to_gui *);
+int param_restore(const param_info_to_gui *);
 #endif //_FDCAN2
\ No newline at end of file
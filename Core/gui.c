@@ -21,6 +21,9 @@
 
 #define DECIMAL_MARKER ','
 
+#define GUI_PARAM_CHANGES_MAX 8 // maximum number of changed parameter IDs checked per update
+
+static int param_changed(uint8_t id);
 static int text_string_changed(void);
 static int value_string_changed(void);
 static void format_value(float value, uint8_t type, char *p_buf, size_t length);
@@ -41,6 +44,12 @@ static data_param_t gui_data_param_last;
 /* actual parameter data */
 static data_param_t gui_data_param;
 
+/* store generation of the actual parameter data */
+static uint32_t gui_data_param_gen = 0;
+
+/* flag if actual parameter data is valid */
+static int gui_b_data_param_valid = 0;
+
 /* pointer to embedded wizard application device class */
 static void *p_gui_appl_dev_class = NULL;
 
@@ -107,10 +116,23 @@ int gui_data_qa_update(uint8_t *pb_on, uint8_t *pb_show_value_bar, uint8_t *p_fr
 int gui_data_param_update(uint8_t *pb_is_toggle, uint8_t *p_frame_number, uint8_t *pb_value_string_changed,
                           uint8_t *pb_text_string_changed) {
     int result = 0;
+    int b_changed = 1;
+    data_param_t data_param;
+
+    if (data_get_param(&data_param) == 0) {
+        /* data of the same parameter only has to be taken over if it changed since the last update */
+        if (gui_b_data_param_valid && data_param.id == gui_data_param.id) {
+            b_changed = param_changed((uint8_t)data_param.id);
+        }
 
-    memcpy(&gui_data_param_last, &gui_data_param, sizeof(data_param_t));
+        gui_data_param_gen = data_get_generation();
+
+        if (b_changed) {
+            memcpy(&gui_data_param_last, &gui_data_param, sizeof(data_param_t));
+            memcpy(&gui_data_param, &data_param, sizeof(data_param_t));
+            gui_b_data_param_valid = 1;
+        }
 
-    if (data_get_param(&gui_data_param) == 0) {
         *pb_is_toggle = gui_param_type_is_toggle(gui_data_param.cfg.type);
 
         *p_frame_number = gui_data_param.cfg.image;
@@ -120,8 +142,8 @@ int gui_data_param_update(uint8_t *pb_is_toggle, uint8_t *p_frame_number, uint8_
             (*p_frame_number)++;
         }
 
-        *pb_value_string_changed = value_string_changed();
-        *pb_text_string_changed = text_string_changed();
+        *pb_value_string_changed = b_changed && value_string_changed();
+        *pb_text_string_changed = b_changed && text_string_changed();
 
         result = 1;
     }
@@ -173,6 +195,29 @@ static void cb_qa(void) {
     ApplicationDeviceClass__UpdateQACounter(p_gui_appl_dev_class, ++qa_cnt);
 }
 
+/**
+ * @brief Check if a parameter changed since the last update
+ * @param id: ID of the parameter
+ * @retval 0: parameter not changed, 1: parameter (may be) changed
+ */
+static int param_changed(uint8_t id) {
+    uint8_t ids[GUI_PARAM_CHANGES_MAX];
+    int num = data_get_param_changes(gui_data_param_gen, ids, GUI_PARAM_CHANGES_MAX);
+
+    /* more changes than checked IDs, assume the parameter is one of them */
+    if (num > GUI_PARAM_CHANGES_MAX) {
+        return 1;
+    }
+
+    for (int i = 0; i < num; i++) {
+        if (ids[i] == id) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
 /**
  * @brief Check if text string (may be) changed
  * @retval 0: text string not changed, 1: text string (may be) changed
@@ -21,6 +21,8 @@
 /* NO MORE DEFINITIONS */
 
 /*** Definition of variables *************************************************/
+extern I2C_HandleTypeDef hi2cOneWire; // I2C2 or I2C3 to the DS2484, depending on the PCB
+
 /* NO MORE DEFINITIONS */
 
 /*** Prototypes of functions *************************************************/
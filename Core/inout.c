@@ -11,19 +11,71 @@
 #include "main.h"
 
 #include "inout.h"
+#include "msg.h"
+#include "led.h"
+#include "timers.h"
 
 #include "stm32g4xx_hal.h"
 #include "stm32g4xx_ll_gpio.h"
+#include "stm32g4xx_ll_bus.h"
+#include "stm32g4xx_ll_system.h"
+#include "stm32g4xx_ll_exti.h"
 
 #define WAIT_CNT         30
-#define STAT_LED_CNT_MAX 250 // 25 * 4 msec = 100 msec
 #define TORCH_BT_LED_OUT 1
-
-static int trigger_cnt = 0;
-static uint16_t output_mask = 0;
-static int trigger_stat_led_cnt = 0;
-
-static void refresh_outputs();
+#define TORCH_BT_LED_MS  2000 // EXT LED stays on after the torch switch was released
+
+#define KEY_N               5   // push buttons and torch switch
+#define KEY_DEBOUNCE_MS     20   // edges within this time after an accepted edge are bouncing
+#define KEY_SETTLE_US       2000 // glitch filter, time a key which has to settle must keep its level
+#define KEY_REPEAT_DELAY_MS 500  // UP/DOWN held alone repeats after this time
+
+/* key with its EXTI line, each key has its own line */
+typedef struct {
+    GPIO_TypeDef *p_port;
+    uint16_t pin;
+    uint32_t exti_port; // LL_SYSCFG_EXTI_PORTx
+    uint32_t exti_line; // LL_SYSCFG_EXTI_LINEx
+    uint16_t input;     // INOUT_xxx
+    uint8_t b_low;      // pressed at low level
+    uint8_t b_settle;   // taken over only after the level was stable for KEY_SETTLE_US
+} inout_key_t;
+
+static const inout_key_t inout_keys[KEY_N] = {
+    {BUTTON_DOWN_GPIO_Port, BUTTON_DOWN_Pin, LL_SYSCFG_EXTI_PORTD, LL_SYSCFG_EXTI_LINE1, INOUT_BUTTON_DOWN, 0, 0},
+    {BUTTON_UP_GPIO_Port, BUTTON_UP_Pin, LL_SYSCFG_EXTI_PORTB, LL_SYSCFG_EXTI_LINE2, INOUT_BUTTON_UP, 0, 0},
+    {BUTTON_RIGHT_GPIO_Port, BUTTON_RIGHT_Pin, LL_SYSCFG_EXTI_PORTC, LL_SYSCFG_EXTI_LINE0, INOUT_BUTTON_RIGHT, 0, 0},
+    {BUTTON_LEFT_GPIO_Port, BUTTON_LEFT_Pin, LL_SYSCFG_EXTI_PORTC, LL_SYSCFG_EXTI_LINE3, INOUT_BUTTON_LEFT, 0, 0},
+    /* a glitch on the torch switch must not start the weld */
+    {TORCH_SWITCH_GPIO_Port, TORCH_SWITCH_Pin, LL_SYSCFG_EXTI_PORTC, LL_SYSCFG_EXTI_LINE14, INOUT_TORCH_SWITCH, 1, 1},
+};
+
+/* auto-repeat of UP/DOWN, interval between two steps from the time the key is held */
+typedef struct {
+    uint16_t held;     // ms
+    uint16_t interval; // ms
+} inout_repeat_t;
+
+static const inout_repeat_t inout_repeat_curve[] = {{0, 200}, {1500, 100}, {3000, 40}, {5000, 10}};
+
+static volatile uint16_t output_mask = 0;
+
+/* debounced inputs and time of the last accepted edge of each key in ms */
+static volatile uint16_t key_inputs = 0;
+static uint32_t key_tick[KEY_N];
+static uint32_t key_edge_cycles[KEY_N]; // cycle counter at the last edge
+
+/* time of the next repeat step and repeat steps not taken yet, positive for UP */
+static uint32_t key_repeat_tick = 0;
+static int16_t key_repeat_steps = 0;
+
+/* time from the edge to the take-over of the change in us, the inputs message is queued right after */
+static uint32_t key_latency = 0;
+static uint32_t key_latency_max = 0;
+
+static void show_output(led_t led, const led_pattern_t *p_pattern);
+static int key_update(uint8_t key, uint32_t tick);
+static void key_repeat(uint32_t tick);
 
 extern uint8_t TestMode;
 
@@ -106,77 +158,64 @@ void inout_set_outputs(uint16_t outputs) {
 }
 
 /******************************************************************************
-** Name               : @fn inout_trigger_outputs
-** Created from /on   : @author ´WBO(IBV) / @date 00.00.2021
-** Description        : @brief trigger / update all outputs with interleaved PWM
-** Calling            : @ cyclic >200Hz
-
+** Name               : @fn inout_process_outputs
+** Created from /on   : @author / @date 18.10.2026
+** Description        : @brief Sets the LED patterns from the output bits. The LEDs are switched by the timer
+**                             and DMA of led.c, the red hood LEDs are on in alternate halves of the PWM frame.
+** Calling            : @remark main loop, before led_process()
+** InputValues        : @param none
 ******************************************************************************/
-void inout_trigger_outputs(void) {
-    if (!(output_mask & INOUT_LED_EXT) && (output_mask & INOUT_LED_RH)) {
-        /* switch between left and right LED */
-        trigger_cnt++;
-        trigger_cnt %= 2;
-    }
+void inout_process_outputs(void) {
+    uint16_t mask = output_mask;
+    const led_pattern_t *p_ext = &led_pattern_off;
+    const led_pattern_t *p_rh = &led_pattern_off;
+#ifdef TORCH_BT_LED_OUT
+    static uint32_t torch_tick = 0;
+    static uint8_t b_torch = 0;
+#endif
 
-    if (trigger_stat_led_cnt > STAT_LED_CNT_MAX) {
-        trigger_stat_led_cnt = 0;
+    if (TestMode != 0) {
+        return;
     }
-    trigger_stat_led_cnt++;
 
-    if (TestMode == 0)
-        refresh_outputs();
-}
-
-/******************************************************************************
-** Name               : @fn refresh_outputs
-** Created from /on   : @author ´WBO(IBV) / @date 00.00.2021
-** Description        : @brief cyclic output for GPIOs, needs to be called frequence > 200Hz.for RH LEDs PWM
-** Calling            : @
-** InputValues        : @param none
-******************************************************************************/
-static void refresh_outputs() {
-    GPIO_PinState Ext_Out;
-    static uint16_t count = 0;
-    if (output_mask & INOUT_LED_EXT) {
+    if (mask & INOUT_LED_EXT) {
         // EXT LED overrides RH LEDs
-        HAL_GPIO_WritePin(LED_1_GPIO_Port, LED_1_Pin, GPIO_PIN_RESET);
-        HAL_GPIO_WritePin(LED_2_GPIO_Port, LED_2_Pin, GPIO_PIN_RESET);
-        Ext_Out = GPIO_PIN_SET;
-    } else if (output_mask & INOUT_LED_RH) {
+        p_ext = &led_pattern_on;
+    } else if (mask & INOUT_LED_RH) {
         // Switch red hood LEDS interleaved
-        if (!trigger_cnt) {
-            HAL_GPIO_WritePin(LED_1_GPIO_Port, LED_1_Pin, GPIO_PIN_SET);
-            HAL_GPIO_WritePin(LED_2_GPIO_Port, LED_2_Pin, GPIO_PIN_RESET);
-        } else {
-            HAL_GPIO_WritePin(LED_1_GPIO_Port, LED_1_Pin, GPIO_PIN_RESET);
-            HAL_GPIO_WritePin(LED_2_GPIO_Port, LED_2_Pin, GPIO_PIN_SET);
-        }
-        // Clear EXT Led
-        Ext_Out = GPIO_PIN_RESET;
-    } else {
-        HAL_GPIO_WritePin(LED_1_GPIO_Port, LED_1_Pin, GPIO_PIN_RESET);
-        HAL_GPIO_WritePin(LED_2_GPIO_Port, LED_2_Pin, GPIO_PIN_RESET);
-        // Clear EXT Led
-        Ext_Out = GPIO_PIN_RESET;
+        p_rh = &led_pattern_half;
     }
 #ifdef TORCH_BT_LED_OUT
     if (!HAL_GPIO_ReadPin(TORCH_SWITCH_GPIO_Port, TORCH_SWITCH_Pin)) {
-        Ext_Out = GPIO_PIN_SET;
-        count = 500; // value 500 is based on 4ms timer interval. 500*4ms =2000ms
-    } else if (count) {
-        count--;
-        if (count == 0) {
-            Ext_Out = GPIO_PIN_RESET;
-        } else {
-            Ext_Out = GPIO_PIN_SET;
-        }
+        torch_tick = HAL_GetTick();
+        b_torch = 1;
+    } else if (b_torch && ((HAL_GetTick() - torch_tick) >= TORCH_BT_LED_MS)) {
+        b_torch = 0;
+    }
+    if (b_torch) {
+        p_ext = &led_pattern_on;
     }
 #endif
-    HAL_GPIO_WritePin(LED_EXT_GPIO_Port, LED_EXT_Pin, Ext_Out);
 
-    if (trigger_stat_led_cnt == STAT_LED_CNT_MAX) {
-        HAL_GPIO_TogglePin(LED_STAT_GPIO_Port, LED_STAT_Pin);
+    show_output(E_LED_EXT, p_ext);
+    show_output(E_LED_RH1, p_rh);
+    show_output(E_LED_RH2, p_rh);
+    show_output(E_LED_STAT, &led_pattern_blink);
+}
+
+/******************************************************************************
+** Name               : @fn show_output
+** Created from /on   : @author / @date 18.10.2026
+** Description        : @brief Sets the pattern of an LED if it differs from the one set before
+** Calling            : @remark inout_process_outputs
+** InputValues        : @param led, pattern
+******************************************************************************/
+static void show_output(led_t led, const led_pattern_t *p_pattern) {
+    static const led_pattern_t *p_shown[E_LED_N];
+
+    if (p_shown[led] != p_pattern) {
+        p_shown[led] = p_pattern;
+        led_set_pattern(led, p_pattern);
     }
 }
 
@@ -279,3 +318,216 @@ uint32_t IOProcessKeys(CoreRoot RootObject) {
     }
     return ret;
 }
+
+/******************************************************************************
+** Name               : @fn inout_keys_init
+** Created from /on   : @author / @date 18.10.2026
+** Description        : @brief Starts the edge capture of the keys. Both edges of each key raise an EXTI interrupt
+**                             at the priority of TIM16, which samples the keys too, and of the TIM17 compare.
+**                             The DWT cycle counter, started by cpu_load_init(), measures the time from the edge
+**                             to the take-over.
+** Calling            : @remark at init, after FDCAN2, TIM16 and TIM17 were started
+** InputValues        : @param none
+******************************************************************************/
+void inout_keys_init(void) {
+    LL_EXTI_InitTypeDef EXTI_InitStruct = {0};
+    uint32_t tick = HAL_GetTick();
+    uint16_t inputs;
+
+    LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_SYSCFG);
+    for (uint8_t i = 0; i < KEY_N; i++) {
+        LL_SYSCFG_SetEXTISource(inout_keys[i].exti_port, inout_keys[i].exti_line);
+        EXTI_InitStruct.Line_0_31 |= inout_keys[i].pin; // the EXTI line number is the pin number
+        key_tick[i] = tick - KEY_DEBOUNCE_MS;
+        key_edge_cycles[i] = DWT->CYCCNT;
+    }
+    EXTI_InitStruct.LineCommand = ENABLE;
+    EXTI_InitStruct.Mode = LL_EXTI_MODE_IT;
+    EXTI_InitStruct.Trigger = LL_EXTI_TRIGGER_RISING_FALLING;
+    LL_EXTI_Init(&EXTI_InitStruct);
+
+    inout_get_inputs(&inputs);
+    key_inputs = inputs;
+
+    HAL_NVIC_SetPriority(EXTI0_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(EXTI0_IRQn);
+    HAL_NVIC_SetPriority(EXTI1_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(EXTI1_IRQn);
+    HAL_NVIC_SetPriority(EXTI2_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(EXTI2_IRQn);
+    HAL_NVIC_SetPriority(EXTI3_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(EXTI3_IRQn);
+    HAL_NVIC_SetPriority(EXTI15_10_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(EXTI15_10_IRQn);
+}
+
+/******************************************************************************
+** Name               : @fn HAL_GPIO_EXTI_Callback
+** Created from /on   : @author / @date 18.10.2026
+** Description        : @brief Records an edge of a key. A change of a push button is taken over and sent right
+**                             away, ahead of the cyclic inputs message of TIM16, also during EwProcess() while
+**                             TIM16 is masked. An edge of a key which has to settle (re)starts the TIM17 compare,
+**                             which takes the key over once its level was stable for KEY_SETTLE_US.
+** Calling            : @remark EXTI interrupt
+** InputValues        : @param GPIO_Pin of the key
+******************************************************************************/
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) {
+    uint32_t cycles = DWT->CYCCNT;
+    uint32_t tick = HAL_GetTick();
+
+    for (uint8_t i = 0; i < KEY_N; i++) {
+        if (inout_keys[i].pin != GPIO_Pin) {
+            continue;
+        }
+        key_edge_cycles[i] = cycles;
+        if (inout_keys[i].b_settle) {
+            tim17_start_compare(KEY_SETTLE_US);
+        } else if (key_update(i, tick)) {
+            msg_update_inputs(key_inputs, 0, 0);
+        }
+    }
+}
+
+/******************************************************************************
+** Name               : @fn inout_settle_keys
+** Created from /on   : @author / @date 18.10.2026
+** Description        : @brief Takes over the keys which have to settle and sends a change right away. The
+**                             compare is restarted by each of their edges, so it elapses once the last edge
+**                             is KEY_SETTLE_US ago.
+** Calling            : @remark TIM17 compare interrupt
+** InputValues        : @param none
+******************************************************************************/
+void inout_settle_keys(void) {
+    uint32_t tick = HAL_GetTick();
+    uint8_t b_changed = 0;
+
+    for (uint8_t i = 0; i < KEY_N; i++) {
+        if (inout_keys[i].b_settle && key_update(i, tick)) {
+            b_changed = 1;
+        }
+    }
+    if (b_changed) {
+        msg_update_inputs(key_inputs, 0, 0);
+    }
+}
+
+/******************************************************************************
+** Name               : @fn inout_get_keys
+** Created from /on   : @author / @date 18.10.2026
+** Description        : @brief Getter for the debounced inputs. A key whose level differs from the debounced
+**                             state is taken over, if its last accepted edge is older than the debounce time,
+**                             a key which has to settle if its last edge is older than the settle time.
+** Calling            : @remark TIM16, all 10 msec
+** InputValues        : @param p_inputs
+******************************************************************************/
+void inout_get_keys(uint16_t *p_inputs) {
+    uint32_t tick = HAL_GetTick();
+
+    for (uint8_t i = 0; i < KEY_N; i++) {
+        key_update(i, tick);
+    }
+    key_repeat(tick);
+    *p_inputs = key_inputs;
+}
+
+/******************************************************************************
+** Name               : @fn inout_get_key_repeat
+** Created from /on   : @author / @date 18.10.2026
+** Description        : @brief Getter for the auto-repeat steps of UP/DOWN since the last call, the steps are
+**                             taken by inout_get_keys()
+** Calling            : @remark TIM16, once per inputs message
+** InputValues        : @param none
+**
+** OutputValues       : @retval int8_t steps, positive for UP, negative for DOWN
+******************************************************************************/
+int8_t inout_get_key_repeat(void) {
+    int16_t steps = key_repeat_steps;
+
+    steps = (steps > INT8_MAX) ? INT8_MAX : ((steps < -INT8_MAX) ? -INT8_MAX : steps);
+    key_repeat_steps -= steps;
+    return (int8_t)steps;
+}
+
+/******************************************************************************
+** Name               : @fn inout_get_key_latency
+** Created from /on   : @author / @date 18.10.2026
+** Description        : @brief Getter for the time from a key edge to the take-over of the change
+** Calling            : @remark fdcan2 (CO_GET_KEYLATENCY)
+** InputValues        : @param p_last, p_max
+******************************************************************************/
+void inout_get_key_latency(uint32_t *p_last, uint32_t *p_max) {
+    *p_last = key_latency;
+    *p_max = key_latency_max;
+}
+
+/******************************************************************************
+** Name               : @fn key_update
+** Created from /on   : @author / @date 18.10.2026
+** Description        : @brief Compares the level of a key with the debounced state. A change is accepted if
+**                             the last accepted edge of the key is at least KEY_DEBOUNCE_MS ago. A key which
+**                             has to settle is sampled again, its change is accepted once its last edge is at
+**                             least KEY_SETTLE_US ago, so a glitch shorter than that is never taken over.
+** Calling            : @remark HAL_GPIO_EXTI_Callback, inout_settle_keys, inout_get_keys
+** InputValues        : @param key, tick in ms
+**
+** OutputValues       : @retval int 1 if the debounced state changed
+******************************************************************************/
+static int key_update(uint8_t key, uint32_t tick) {
+    const inout_key_t *p_key = &inout_keys[key];
+    uint8_t b_pressed = (HAL_GPIO_ReadPin(p_key->p_port, p_key->pin) == GPIO_PIN_SET) != p_key->b_low;
+    uint8_t b_wait;
+
+    if (p_key->b_settle) {
+        b_wait = (DWT->CYCCNT - key_edge_cycles[key]) < (KEY_SETTLE_US * (SystemCoreClock / 1000000U));
+    } else {
+        b_wait = (tick - key_tick[key]) < KEY_DEBOUNCE_MS;
+    }
+    if ((b_pressed == ((key_inputs & p_key->input) != 0)) || b_wait) {
+        return 0;
+    }
+    key_inputs ^= p_key->input;
+    key_tick[key] = tick;
+    key_repeat_tick = tick + KEY_REPEAT_DELAY_MS;
+
+    key_latency = (DWT->CYCCNT - key_edge_cycles[key]) / (SystemCoreClock / 1000000U);
+    if (key_latency > key_latency_max) {
+        key_latency_max = key_latency;
+    }
+    return 1;
+}
+
+/******************************************************************************
+** Name               : @fn key_repeat
+** Created from /on   : @author / @date 18.10.2026
+** Description        : @brief Takes the auto-repeat steps of UP or DOWN held alone. The interval between two
+**                             steps shortens with the time the key is held, see inout_repeat_curve.
+** Calling            : @remark inout_get_keys
+** InputValues        : @param tick in ms
+******************************************************************************/
+static void key_repeat(uint32_t tick) {
+    uint8_t key;
+    int8_t step;
+    uint32_t held;
+    uint8_t i;
+
+    if (key_inputs == INOUT_BUTTON_UP) {
+        key = 1;
+        step = 1;
+    } else if (key_inputs == INOUT_BUTTON_DOWN) {
+        key = 0;
+        step = -1;
+    } else {
+        return;
+    }
+
+    while ((int32_t)(tick - key_repeat_tick) >= 0) {
+        held = key_repeat_tick - key_tick[key];
+        for (i = sizeof(inout_repeat_curve) / sizeof(inout_repeat_curve[0]) - 1; i > 0; i--) {
+            if (held >= inout_repeat_curve[i].held) {
+                break;
+            }
+        }
+        key_repeat_steps += step;
+        key_repeat_tick += inout_repeat_curve[i].interval;
+    }
+}
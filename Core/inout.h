@@ -49,6 +49,43 @@ void Set_LED(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
 void inout_get_inputs(uint16_t *p_inputs);
 void IO_Init();
 
+/**
+ * @brief Start the edge capture of the push buttons and the torch switch by EXTI.
+ *        Changes of the debounced inputs are sent right away.
+ * @retval none
+ */
+void inout_keys_init(void);
+
+/**
+ * @brief Take over the torch switch once its level was stable for the glitch
+ *        filter time, a change is sent right away.
+ * @retval none
+ */
+void inout_settle_keys(void);
+
+/**
+ * @brief Get mask of debounced inputs. Changes missed by the edge capture are
+ *        taken over, has to be called cyclic.
+ * @param p_inputs: pointer to mask of pressed buttons
+ * @retval none
+ */
+void inout_get_keys(uint16_t *p_inputs);
+
+/**
+ * @brief Get the auto-repeat steps of UP/DOWN held alone since the last call.
+ *        The interval between the steps shortens the longer the key is held.
+ * @retval steps, positive for UP, negative for DOWN
+ */
+int8_t inout_get_key_repeat(void);
+
+/**
+ * @brief Get the time from a key edge to the take-over of the change, the inputs message is queued right after
+ * @param p_last: pointer to the time of the last change in us
+ * @param p_max: pointer to the maximum time in us
+ * @retval none
+ */
+void inout_get_key_latency(uint32_t *p_last, uint32_t *p_max);
+
 /**
  * @brief Set mask of outputs (LEDs).
  *
@@ -60,10 +97,10 @@ void IO_Init();
 void inout_set_outputs(uint16_t outputs);
 
 /**
- * @brief Trigger outputs. Function has to be called cyclic with frequence > 200Hz.
+ * @brief Set the LED patterns from the outputs, has to be called cyclic.
  * @retval none
  */
-void inout_trigger_outputs(void);
+void inout_process_outputs(void);
 
 uint32_t IOProcessKeys(CoreRoot RootObject);
 
@@ -0,0 +1,295 @@
+/*
+******************************************************************************
+* @file: led.c
+* @author:
+* @brief: LED patterns played by timer and DMA.
+*         The LEDs are driven by a PWM frame of LED_LEVEL_MAX slots per GPIO
+*         port, one BSRR word per slot. TIM20 requests a DMA transfer of the
+*         next word of each port every slot, so all LEDs of a port are
+*         switched by one write and no interrupt is needed. The brightness of
+*         an LED is its number of on slots. A pattern is a sequence of
+*         brightness steps, its steps are advanced by the main loop.
+******************************************************************************
+*
+******************************************************************************
+*/
+
+/*** Include *****************************************************************/
+#include "led.h"
+#include "main.h"
+#include "timers.h"
+/* NO MORE DEFINITIONS */
+
+/*** Preprocessor definitions ************************************************/
+#define LED_SLOT_N LED_LEVEL_MAX // slots of the PWM frame, 16 * 250 us = 4 msec
+#define LED_PORT_N 3             // GPIO ports with LEDs, each needs its own DMA channel
+
+/*** Definition of variables *************************************************/
+
+/* PWM frame of a GPIO port */
+typedef struct {
+    GPIO_TypeDef *p_port;
+    uint32_t frame[LED_SLOT_N]; // BSRR word of each slot
+} led_port_t;
+
+/* DMA channel and its request of each port, all requested by TIM20 */
+typedef struct {
+    DMA_Channel_TypeDef *p_channel;
+    uint32_t request;
+    uint32_t tim_dma;
+} led_dma_t;
+
+static const led_dma_t led_dma_cfg[LED_PORT_N] = {
+    {DMA1_Channel2, DMA_REQUEST_TIM20_UP, TIM_DMA_UPDATE},
+    {DMA1_Channel3, DMA_REQUEST_TIM20_CH1, TIM_DMA_CC1},
+    {DMA1_Channel4, DMA_REQUEST_TIM20_CH2, TIM_DMA_CC2},
+};
+
+static const led_step_t led_steps_off[] = {{0, LED_TIME_HOLD}};
+static const led_step_t led_steps_on[] = {{LED_LEVEL_MAX, LED_TIME_HOLD}};
+static const led_step_t led_steps_half[] = {{LED_LEVEL_MAX / 2, LED_TIME_HOLD}};
+static const led_step_t led_steps_blink[] = {{LED_LEVEL_MAX, 1000}, {0, 1000}};
+static const led_step_t led_steps_pass[] = {{LED_LEVEL_MAX, 1000}};
+static const led_step_t led_steps_fail[] = {{LED_LEVEL_MAX, 5000}};
+
+const led_pattern_t led_pattern_off = {led_steps_off, 1, 0};
+const led_pattern_t led_pattern_on = {led_steps_on, 1, 0};
+const led_pattern_t led_pattern_half = {led_steps_half, 1, 0};
+const led_pattern_t led_pattern_blink = {led_steps_blink, 2, 0};
+const led_pattern_t led_pattern_blink_3 = {led_steps_blink, 2, 3};
+const led_pattern_t led_pattern_pass = {led_steps_pass, 1, 1};
+const led_pattern_t led_pattern_fail = {led_steps_fail, 1, 1};
+
+/* first on slot of each LED, the red hood LEDs are on in alternate halves of the frame */
+static const uint8_t led_phase[E_LED_N] = {0, 0, LED_SLOT_N / 2, 0, 0};
+
+static led_port_t led_ports[LED_PORT_N];
+static uint8_t led_port_n = 0;
+static DMA_HandleTypeDef led_dma[LED_PORT_N];
+
+/* port index and pin of each LED */
+static uint8_t led_port_index[E_LED_N];
+static uint32_t led_pin[E_LED_N];
+
+/* pattern requested by led_set_pattern(), taken over by led_process() */
+static const led_pattern_t *volatile p_led_request[E_LED_N];
+static volatile uint8_t led_b_request[E_LED_N];
+
+/* running pattern, its step and run and the brightness */
+static const led_pattern_t *p_led_pattern[E_LED_N];
+static uint8_t led_step[E_LED_N];
+static uint8_t led_run[E_LED_N];
+static uint32_t led_step_tick[E_LED_N];
+static uint8_t led_level[E_LED_N];
+
+/*** Prototypes of functions *************************************************/
+static uint8_t led_port_add(GPIO_TypeDef *p_port);
+static void led_update_frames(void);
+
+/*** Definitions of functions ************************************************/
+
+/**********************************************************
+ ** Name            : led_init
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Assigns the LEDs to their ports and starts the DMA
+ **                   channels of the ports and TIM20. The pins of the
+ **                   torch LEDs depend on the PCB type.
+ **
+ ** Calling         : main, after MX_GPIO_Init, MX_DMA_Init and
+ **                   MX_TIM20_Init
+ **
+ ** InputValues     : none
+ ** OutputValues    : none
+ **********************************************************/
+void led_init(void) {
+    GPIO_TypeDef *p_ports[E_LED_N] = {LED_EXT_GPIO_Port, LED_1_GPIO_Port, LED_2_GPIO_Port, LED_STAT_GPIO_Port,
+                                      LED_ERR_GPIO_Port};
+    uint32_t pins[E_LED_N] = {LED_EXT_Pin, LED_1_Pin, LED_2_Pin, LED_STAT_Pin, LED_ERR_Pin};
+
+    for (uint8_t i = 0; i < E_LED_N; i++) {
+        led_port_index[i] = led_port_add(p_ports[i]);
+        led_pin[i] = pins[i];
+    }
+    led_update_frames();
+
+    for (uint8_t i = 0; i < led_port_n; i++) {
+        led_dma[i].Instance = led_dma_cfg[i].p_channel;
+        led_dma[i].Init.Request = led_dma_cfg[i].request;
+        led_dma[i].Init.Direction = DMA_MEMORY_TO_PERIPH;
+        led_dma[i].Init.PeriphInc = DMA_PINC_DISABLE;
+        led_dma[i].Init.MemInc = DMA_MINC_ENABLE;
+        led_dma[i].Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+        led_dma[i].Init.MemDataAlignment = DMA_MDATAALIGN_WORD;
+        led_dma[i].Init.Mode = DMA_CIRCULAR;
+        led_dma[i].Init.Priority = DMA_PRIORITY_LOW;
+        if (HAL_DMA_Init(&led_dma[i]) != HAL_OK) {
+            Error_Handler();
+        }
+        HAL_DMA_Start(&led_dma[i], (uint32_t)led_ports[i].frame, (uint32_t)&led_ports[i].p_port->BSRR, LED_SLOT_N);
+        __HAL_TIM_ENABLE_DMA(&htim20, led_dma_cfg[i].tim_dma);
+    }
+    HAL_TIM_Base_Start(&htim20);
+}
+
+/**********************************************************
+ ** Name            : led_stop
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Stops TIM20, so the LEDs keep their state and can be
+ **                   written directly. Safe before led_init().
+ **
+ ** Calling         : Error_Handler
+ **
+ ** InputValues     : none
+ ** OutputValues    : none
+ **********************************************************/
+void led_stop(void) {
+    CLEAR_BIT(TIM20->CR1, TIM_CR1_CEN);
+}
+
+/**********************************************************
+ ** Name            : led_set_pattern
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Requests a pattern, it is started from its first step
+ **                   by the next led_process(). The last request wins.
+ **
+ ** Calling         : application, interrupts too
+ **
+ ** InputValues     : led_t led, pattern
+ ** OutputValues    : none
+ **********************************************************/
+void led_set_pattern(led_t led, const led_pattern_t *p_pattern) {
+    if ((led >= E_LED_N) || (p_pattern == NULL)) {
+        return;
+    }
+    p_led_request[led] = p_pattern;
+    led_b_request[led] = 1;
+}
+
+/**********************************************************
+ ** Name            : led_process
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Takes over the requested patterns and advances the
+ **                   steps of the running ones. The PWM frames are only
+ **                   rewritten if a brightness changed.
+ **
+ ** Calling         : main loop
+ **
+ ** InputValues     : none
+ ** OutputValues    : none
+ **********************************************************/
+void led_process(void) {
+    uint32_t tick = HAL_GetTick();
+    uint8_t b_changed = 0;
+    uint8_t level;
+
+    for (uint8_t i = 0; i < E_LED_N; i++) {
+        const led_pattern_t *p_pattern;
+
+        if (led_b_request[i]) {
+            /* cleared before the pattern is read, so a request meanwhile is taken over next time */
+            led_b_request[i] = 0;
+            p_led_pattern[i] = p_led_request[i];
+            led_step[i] = 0;
+            led_run[i] = 0;
+            led_step_tick[i] = tick;
+        } else {
+            p_pattern = p_led_pattern[i];
+            if ((p_pattern == NULL) || (p_pattern->p_steps[led_step[i]].time == LED_TIME_HOLD) ||
+                ((tick - led_step_tick[i]) < p_pattern->p_steps[led_step[i]].time)) {
+                continue;
+            }
+            led_step_tick[i] = tick;
+            led_step[i]++;
+            if (led_step[i] >= p_pattern->steps) {
+                led_step[i] = 0;
+                led_run[i]++;
+                if (p_pattern->repeat && (led_run[i] >= p_pattern->repeat)) {
+                    p_led_pattern[i] = &led_pattern_off;
+                }
+            }
+        }
+
+        level = p_led_pattern[i]->p_steps[led_step[i]].level;
+        if (level != led_level[i]) {
+            led_level[i] = level;
+            b_changed = 1;
+        }
+    }
+
+    if (b_changed) {
+        led_update_frames();
+    }
+}
+
+/**********************************************************
+ ** Name            : led_port_add
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Gets the index of the PWM frame of a port, a new
+ **                   port gets the next frame
+ **
+ ** Calling         : led_init
+ **
+ ** InputValues     : GPIO port
+ ** OutputValues    : uint8_t index
+ **********************************************************/
+static uint8_t led_port_add(GPIO_TypeDef *p_port) {
+    for (uint8_t i = 0; i < led_port_n; i++) {
+        if (led_ports[i].p_port == p_port) {
+            return i;
+        }
+    }
+    if (led_port_n >= LED_PORT_N) {
+        Error_Handler();
+    }
+    led_ports[led_port_n].p_port = p_port;
+    return led_port_n++;
+}
+
+/**********************************************************
+ ** Name            : led_update_frames
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Rewrites the PWM frames from the brightness of the
+ **                   LEDs. Each slot sets the pins of the LEDs on in this
+ **                   slot and resets the others. The DMA keeps reading
+ **                   meanwhile, for at most one frame old and new slots
+ **                   are mixed.
+ **
+ ** Calling         : led_init, led_process
+ **
+ ** InputValues     : none
+ ** OutputValues    : none
+ **********************************************************/
+static void led_update_frames(void) {
+    uint32_t set;
+    uint32_t reset;
+
+    for (uint8_t port = 0; port < led_port_n; port++) {
+        for (uint8_t slot = 0; slot < LED_SLOT_N; slot++) {
+            set = 0;
+            reset = 0;
+            for (uint8_t i = 0; i < E_LED_N; i++) {
+                if (led_port_index[i] != port) {
+                    continue;
+                }
+                if (((slot + LED_SLOT_N - led_phase[i]) % LED_SLOT_N) < led_level[i]) {
+                    set |= led_pin[i];
+                } else {
+                    reset |= led_pin[i];
+                }
+            }
+            led_ports[port].frame[slot] = set | (reset << 16);
+        }
+    }
+}
@@ -0,0 +1,67 @@
+/*
+******************************************************************************
+* @file: led.h
+* @author:
+* @brief: LED patterns played by timer and DMA
+******************************************************************************
+*
+******************************************************************************
+*/
+
+#ifndef _LED_H
+#define _LED_H
+
+/*** Include *****************************************************************/
+#include "types.h"
+
+/* NO MORE DEFINITIONS */
+
+/*** Preprocessor definitions ************************************************/
+#define LED_LEVEL_MAX 16 // brightness of a fully on LED, slots of the PWM frame
+#define LED_TIME_HOLD 0  // time of a step that is kept until another pattern is set
+
+/*** Definition of variables *************************************************/
+
+/* LEDs of the torch and the board */
+typedef enum {
+    E_LED_EXT,  // external LED
+    E_LED_RH1,  // red hood LED 1
+    E_LED_RH2,  // red hood LED 2, interleaved with LED 1
+    E_LED_STAT, // status LED
+    E_LED_ERR,  // error LED
+    E_LED_N
+} led_t;
+
+/* step of a pattern */
+typedef struct {
+    uint8_t level; // brightness 0..LED_LEVEL_MAX
+    uint16_t time; // ms, LED_TIME_HOLD keeps the step
+} led_step_t;
+
+/* pattern, a sequence of steps */
+typedef struct {
+    const led_step_t *p_steps;
+    uint8_t steps;  // number of steps
+    uint8_t repeat; // number of runs, 0 = endless. The LED is off after the last run.
+} led_pattern_t;
+
+extern const led_pattern_t led_pattern_off;
+extern const led_pattern_t led_pattern_on;
+extern const led_pattern_t led_pattern_half;
+extern const led_pattern_t led_pattern_blink;
+extern const led_pattern_t led_pattern_blink_3;
+extern const led_pattern_t led_pattern_pass;
+extern const led_pattern_t led_pattern_fail;
+
+/*** Prototypes of functions *************************************************/
+void led_init(void);
+void led_stop(void);
+void led_set_pattern(led_t led, const led_pattern_t *p_pattern);
+void led_process(void);
+
+/* NO MORE DEFINITIONS */
+
+/*** Definitions of functions ************************************************/
+/* NO MORE DEFINITIONS */
+
+#endif //_LED_H
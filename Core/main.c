@@ -27,7 +27,15 @@
 #include "gpio.h"
 #include "gui.h"
 #include "inout.h"
+#include "led.h"
+#include "trace.h"
+#include "cpu_load.h"
 #include "TestBoard.h"
+#include "param_cache.h"
+#include "weld_time.h"
+#include "eeprom_job.h"
+#include "boot.h"
+#include "DisplayDriver.h"
 #include "bootloader_util.h"
 // END of project specific includes
 
@@ -112,46 +120,94 @@ int main(void) {
 
     /* Configure the system clock */
     SystemClock_Config();
+    cpu_load_init();
+    trace_init();
 
     /* Test Mode parameter initialization*/
     TestMode_Init();
 
     /* Initialize all configured peripherals */
+    boot_phase_begin(E_BOOT_PERIPHERALS);
     MX_GPIO_Init();
-    MX_UART1_Init();
+    DisplayDriver_DisplayResetStart(); // the display reset runs while the other peripherals are initialized
     MX_DMA_Init();
+    MX_UART1_Init();
     MX_SPI1_Init();
     MX_TIM16_Init();
     MX_TIM17_Init();
+    MX_TIM20_Init();
     MX_FDCAN2_Init();
     if (PCB_Detection_Result)
         MX_I2C2_Init(); // OLD PCB TC22-E01B
     else
         MX_I2C3_Init(); // New PCB TC22-V01A
-    EwInit();
 
+    /* TIM16 is clocked by PCLK2 = HCLK, so its period in CPU cycles is exact */
+    cpu_load_set_period(E_CPU_ISR_TIM16, (htim16.Init.Prescaler + 1U) * (htim16.Init.Period + 1U));
     HAL_TIM_Base_Start_IT(&htim16);
-    HAL_TIM_Base_Start_IT(&htim17);
+    HAL_TIM_Base_Start(&htim17);
+    led_init();
+    inout_keys_init();
     msg_send_cfg_request(); // request all of the configuration at the begining
+    boot_phase_end(E_BOOT_PERIPHERALS);
+    DisplayDriver_DisplayResetPoll();
 
     // ---- how to do error handling to be discussed
+    boot_phase_begin(E_BOOT_ONEWIRE);
     I2C_Return = ow_setup_ds2484();
     update_chipstatus(I2C_Return);
+    boot_phase_end(E_BOOT_ONEWIRE);
+    DisplayDriver_DisplayResetPoll();
 
-    I2C_Return = ow_read_ROMID_ds2431();
-    update_chipstatus(I2C_Return);
+    boot_phase_begin(E_BOOT_CACHE);
+    param_cache_restore(); // show the last known parameter until MaPro answers the configuration request
+    boot_phase_end(E_BOOT_CACHE);
+    DisplayDriver_DisplayResetPoll();
 
-    owParamPage_init_ds2431(); // read all eeprom member element
-    update_chipstatus(I2C_Return);
+    boot_phase_begin(E_BOOT_GUI);
+    EwInit();
+    boot_phase_end(E_BOOT_GUI);
+
+    /* ROM ID and pages of the EEPROM are read by boot_process() after the first frame */
+    boot_phase_begin(E_BOOT_FIRST_FRAME);
 
     while (1) {
+        uint32_t gui_cycles;
+        int gui_events;
+
+        /* CPU load and main loop period */
+        cpu_load_loop();
+
         /* TIM16 IRQ has to been disabled during EwProcess() */
         HAL_NVIC_DisableIRQ(TIM1_UP_TIM16_IRQn);
-        EwProcess();
+        gui_cycles = DWT->CYCCNT;
+        gui_events = EwProcess();
         HAL_NVIC_EnableIRQ(TIM1_UP_TIM16_IRQn);
+        gui_cycles = DWT->CYCCNT - gui_cycles;
+        cpu_load_gui(gui_cycles);
+        TRACE2(TRACE_GUI_PROCESS, gui_cycles, gui_events);
+
+        /* Delays of the asynchronous 1-Wire transactions */
+        ow_async_process();
+
+        /* Remaining boot sequence */
+        boot_process();
 
         /* Board Test function*/
         BoardTest();
+
+        /* Save the last known parameter */
+        param_cache_process();
+
+        /* Accumulate and save the weld time */
+        weld_time_process();
+
+        /* EEPROM jobs commanded over CAN */
+        eeprom_job_process();
+
+        /* LED patterns */
+        inout_process_outputs();
+        led_process();
         // MSM
         //    mainStatemachine();
         // Ruecksetzten des Watchdogs
@@ -413,8 +469,9 @@ void Error_Handler(void) {
     /* USER CODE BEGIN Error_Handler_Debug */
     /* User can add his own implementation to report the HAL error return state */
     __disable_irq();
-    Serial_COM_PutString("\r\nHard Fault occured");
+    Serial_COM_PutString_Blocking("\r\nHard Fault occured");
     // Report Error with Red LEDs
+    led_stop();
     Set_LED(LED_ERR_GPIO_Port, LED_ERR_Pin);
 
     while (1) {
@@ -51,9 +51,9 @@ extern "C" {
 /* Exported types ------------------------------------------------------------*/
 /* USER CODE BEGIN ET */
 extern FDCAN_HandleTypeDef hfdcan2;
-extern TIM_HandleTypeDef htim15;
 extern TIM_HandleTypeDef htim16;
 extern TIM_HandleTypeDef htim17;
+extern TIM_HandleTypeDef htim20;
 extern uint32_t LED_EXT_Pin;
 extern GPIO_TypeDef *LED_EXT_GPIO_Port;
 extern uint32_t LED_1_Pin;
@@ -16,6 +16,7 @@
 #include "main.h"
 
 #include "msg.h"
+#include "trace.h"
 #include "version.h"
 
 #include "s4-config/peripherie/SoftwareEnums.h"
@@ -26,7 +27,12 @@
 
 static uint8_t tx_data[MSG_DATA_SIZE];
 
-static void send(int msg_id);
+/* time of the first inputs message and inputs of the last one */
+static uint32_t first_inputs_tick = 0;
+static int b_first_inputs_sent = 0;
+static uint16_t inputs_sent = 0;
+
+static void send(int msg_id, uint8_t data[MSG_DATA_SIZE]);
 
 /**
  * @brief Send a configuration request
@@ -37,21 +43,61 @@ void msg_send_cfg_request(void) {
 
     tx_data[1] = 0x0F;
 
-    send(MSG_REQUESTS);
+    send(MSG_REQUESTS, tx_data);
 }
 
 /**
- * @brief Send inputs
+ * @brief Send inputs, the message has its own buffer as the key interrupts
+ *        may preempt the sending of other messages
  * @param inputs: mask of pressed push buttons
+ * @param repeat: auto-repeat steps of UP/DOWN since the last inputs message,
+ *                positive for UP, negative for DOWN
  * @retval none
  */
-void msg_send_inputs(uint16_t inputs) {
-    memset(tx_data, 0, sizeof(tx_data));
+void msg_send_inputs(uint16_t inputs, int8_t repeat) {
+    uint8_t data[MSG_DATA_SIZE] = {0};
+
+    data[1] = inputs >> 8;
+    data[2] = inputs & 0xFF;
+    data[3] = (uint8_t)repeat;
+
+    send(MSG_INPUTS, data);
+    inputs_sent = inputs;
 
-    tx_data[1] = inputs >> 8;
-    tx_data[2] = inputs & 0xFF;
+    if (!b_first_inputs_sent) {
+        first_inputs_tick = HAL_GetTick();
+        b_first_inputs_sent = 1;
+    }
+}
+
+/**
+ * @brief Send inputs if they differ from the last inputs message or auto-repeat
+ *        steps are pending. UP or DOWN alone are not sent while no parameter
+ *        is active, to prevent QA requesting information through up and down
+ *        buttons.
+ * @param inputs: mask of pressed push buttons
+ * @param repeat: auto-repeat steps of UP/DOWN since the last inputs message
+ * @param b_always: send even if the inputs did not change
+ * @retval 1 if sent, 0 if not
+ */
+int msg_update_inputs(uint16_t inputs, int8_t repeat, int b_always) {
+    if (!b_always && !repeat && b_first_inputs_sent && (inputs == inputs_sent)) {
+        return 0;
+    }
+    if ((get_param_id() == 0) && ((inputs == INOUT_BUTTON_DOWN) || (inputs == INOUT_BUTTON_UP))) {
+        return 0;
+    }
+    msg_send_inputs(inputs, repeat);
+    TRACE2(TRACE_KEY_INPUTS, inputs, repeat);
+    return 1;
+}
 
-    send(MSG_INPUTS);
+/**
+ * @brief Get time of the first inputs message
+ * @retval time in ms since reset, 0 if no inputs were sent yet
+ */
+uint32_t msg_get_first_inputs_tick(void) {
+    return first_inputs_tick;
 }
 
 /**
@@ -63,18 +109,19 @@ void msg_send_inputs(uint16_t inputs) {
 void msg_send(int msg_id, uint8_t data[MSG_DATA_SIZE]) {
     memcpy(tx_data, data, MSG_DATA_SIZE);
 
-    send(msg_id);
+    send(msg_id, tx_data);
 }
 
 /**
  * @brief Send a message
  * @param msg_id: message ID
+ * @param data: message data
  * @retval none
  */
-static void send(int msg_id) {
+static void send(int msg_id, uint8_t data[MSG_DATA_SIZE]) {
 
-    tx_data[7] = TORCH_ID;
-    fdcan2_send(msg_id, tx_data);
+    data[7] = TORCH_ID;
+    fdcan2_send(msg_id, data);
 }
 
 /**
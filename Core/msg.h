@@ -66,6 +66,12 @@
 #define CO_GET_PRGVERSION 12 // SW Semantic Version of FW Image
 #define CO_SET_DETACH     18 // Jump into bootloader request
 #define CO_GET_LOCKSTATE  42 // Jump into bootloader request
+#define CO_GET_BOOTTIME   60 // Boot time report, data[2] selects the entry
+#define CO_GET_EEPROMJOBS 61 // EEPROM job queue statistics
+#define CO_GET_TESTTIME   62 // End-of-line test timing, data[2] selects the step
+#define CO_GET_KEYLATENCY 63 // Time from a key edge to the inputs message
+#define CO_GET_SERIALLOG  64 // UART log ring statistics
+#define CO_GET_CPULOAD    65 // CPU load and interrupt timing, data[2] selects the value
 #define GEN3_ID           0xAA
 
 #define GLOBAL_TAMP_REG   0x00 // TAMP_BKP0R
@@ -88,9 +94,27 @@ void msg_send_cfg_request(void);
 /**
  * @brief Send inputs
  * @param inputs: mask of pressed push buttons
+ * @param repeat: auto-repeat steps of UP/DOWN since the last inputs message,
+ *                positive for UP, negative for DOWN
  * @retval none
  */
-void msg_send_inputs(uint16_t inputs);
+void msg_send_inputs(uint16_t inputs, int8_t repeat);
+
+/**
+ * @brief Send inputs if they differ from the last inputs message or auto-repeat
+ *        steps are pending
+ * @param inputs: mask of pressed push buttons
+ * @param repeat: auto-repeat steps of UP/DOWN since the last inputs message
+ * @param b_always: send even if the inputs did not change
+ * @retval 1 if sent, 0 if not
+ */
+int msg_update_inputs(uint16_t inputs, int8_t repeat, int b_always);
+
+/**
+ * @brief Get time of the first inputs message
+ * @retval time in ms since reset, 0 if no inputs were sent yet
+ */
+uint32_t msg_get_first_inputs_tick(void);
 
 /**
  * @brief Send a message
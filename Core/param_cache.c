@@ -0,0 +1,289 @@
+/*
+******************************************************************************
+* @file: param_cache.c
+* @author:
+* @brief: Last known parameter data, kept in the EEPROM of the torch.
+*         The data of the active parameter is saved in the reserved rows of
+*         EEPROM page 1 and shown right after power-up, until it is replaced
+*         by the data received from MaPro.
+******************************************************************************
+*
+******************************************************************************
+*/
+
+/*** Include *****************************************************************/
+#include <stddef.h>
+#include <string.h>
+
+#include "param_cache.h"
+#include "fdcan2.h"
+#include "DS2484.h"
+#include "DS2431.h"
+#include "TestBoard.h"
+#include "boot.h"
+/* NO MORE DEFINITIONS */
+
+/*** Preprocessor definitions ************************************************/
+#define PARAM_CACHE_VERSION 0x01 // version of the record, 0x00 and 0xFF are never used
+
+#define PARAM_CACHE_OFFSET   BYTES_PER_ROW                 // rows 1..3 of page 1 (Reserved1)
+#define PARAM_CACHE_ADDRESS  (0x0000 + PARAM_CACHE_OFFSET) // EEPROM address of the record
+#define PARAM_CACHE_ROWS     (sizeof(param_cache_record_t) / BYTES_PER_ROW)
+#define PARAM_CACHE_ROW_MASK ((uint16_t)(((1 << PARAM_CACHE_ROWS) - 1) << (PARAM_CACHE_ADDRESS / BYTES_PER_ROW)))
+
+#define PARAM_CACHE_SETTLE_TIME    3000  // ms, data has to be unchanged for this time before it is saved
+#define PARAM_CACHE_WRITE_INTERVAL 30000 // ms, minimum time between two saves
+#define PARAM_CACHE_WRITES_MAX     64    // maximum number of saves per power cycle
+
+/*** Definition of variables *************************************************/
+
+/* record of the parameter cache, has to be a multiple of an EEPROM row without padding */
+typedef struct {
+    uint8_t version;
+    uint8_t ID;
+    uint8_t unit_id;
+    uint8_t type;
+    uint8_t image;
+    uint8_t text;
+    uint8_t total_params;
+    uint8_t total_qas;
+    float value;
+    float min;
+    float max;
+    uint16_t reserved;
+    uint16_t crc; // CRC16 of all bytes before
+} param_cache_record_t;
+
+extern owParamPage1 st_OwParamPage1;
+extern ChipConnectStatus ds2431connectstatus;
+
+/* record as stored in the EEPROM */
+static param_cache_record_t cache_stored;
+
+/* record waiting to be saved and time of its last change */
+static param_cache_record_t cache_pending;
+static uint32_t cache_pending_tick = 0;
+
+static uint32_t cache_write_tick = 0;
+static uint8_t cache_write_cnt = 0;
+static uint8_t b_cache_written = 0;
+
+/* record being saved and the result of the running 1-Wire transaction */
+static param_cache_record_t cache_writing;
+static uint8_t b_cache_writing = 0;
+static uint8_t b_cache_row_started = 0;
+static volatile HAL_StatusTypeDef cache_ow_status = HAL_OK;
+
+/*** Prototypes of functions *************************************************/
+static void cache_from_param(param_cache_record_t *p_record, const param_info_to_gui *p_param);
+static int cache_write(void);
+static void cache_ow_done(HAL_StatusTypeDef status);
+
+/*** Definitions of functions ************************************************/
+
+/**********************************************************
+ ** Name            : param_cache_restore
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Reads the parameter cache from the EEPROM and shows
+ **                   it, as long as no parameter data was received yet
+ **
+ ** Calling         : main, after EwInit() and ow_setup_ds2484()
+ **
+ ** InputValues     : void
+ ** OutputValues    : int. 1=Restored. 0=No valid cache or data received
+ **********************************************************/
+int param_cache_restore(void) {
+    param_info_to_gui param;
+    uint8_t *p_bytes = (uint8_t *)&cache_stored;
+
+    memset(&cache_stored, 0, sizeof(cache_stored));
+    if (ds2431connectstatus == ChipOff) {
+        return 0;
+    }
+    do {
+        if (ow_read_memory_address_ds2431(PARAM_CACHE_ADDRESS, p_bytes, sizeof(cache_stored)) != HAL_OK) {
+            memset(&cache_stored, 0, sizeof(cache_stored));
+            return 0;
+        }
+        if (cache_stored.version != PARAM_CACHE_VERSION) {
+            return 0;
+        }
+        /* a record with CRC failure is read again at standard speed after overdrive */
+    } while ((cache_stored.crc != ow_crc16_ds2431(0, p_bytes, offsetof(param_cache_record_t, crc))) &&
+             ow_overdrive_fallback_ds2431());
+    if (cache_stored.crc != ow_crc16_ds2431(0, p_bytes, offsetof(param_cache_record_t, crc))) {
+        return 0;
+    }
+
+    memset(&param, 0, sizeof(param));
+    param.ID = cache_stored.ID;
+    param.unit_id = cache_stored.unit_id;
+    param.type = cache_stored.type;
+    param.image = cache_stored.image;
+    param.text = cache_stored.text;
+    param.total_params = cache_stored.total_params;
+    param.total_qas = cache_stored.total_qas;
+    param.value = cache_stored.value;
+    param.min = cache_stored.min;
+    param.max = cache_stored.max;
+
+    cache_pending = cache_stored;
+    return param_restore(&param);
+}
+
+/**********************************************************
+ ** Name            : param_cache_process
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Saves the actual parameter data into the cache. To
+ **                   limit the EEPROM wear, the data is saved only after
+ **                   it was unchanged for PARAM_CACHE_SETTLE_TIME, at most
+ **                   every PARAM_CACHE_WRITE_INTERVAL and at most
+ **                   PARAM_CACHE_WRITES_MAX times per power cycle. Only
+ **                   the rows which differ from the RAM shadow of the
+ **                   EEPROM are written, one asynchronous row write after
+ **                   another.
+ **
+ ** Calling         : main loop
+ **
+ ** InputValues     : void
+ ** OutputValues    : void
+ **********************************************************/
+void param_cache_process(void) {
+    param_info_to_gui param;
+    param_cache_record_t record;
+    uint32_t tick = HAL_GetTick();
+
+    /* save in progress */
+    if (b_cache_writing) {
+        cache_write();
+        return;
+    }
+
+    /* the rows are written through the RAM copy of the pages, which is loaded by the boot sequence */
+    if (!boot_done()) {
+        return;
+    }
+
+    /* the parameter data is reused for the test mode */
+    if ((ds2431connectstatus == ChipOff) || Get_TestMode() || (cache_write_cnt >= PARAM_CACHE_WRITES_MAX)) {
+        return;
+    }
+
+    param_get_snapshot(&param);
+    if ((param.seq_number == 0) || (param.ID == 0)) {
+        return;
+    }
+
+    cache_from_param(&record, &param);
+    if (memcmp(&record, &cache_pending, sizeof(record)) != 0) {
+        cache_pending = record;
+        cache_pending_tick = tick;
+        return;
+    }
+
+    if ((memcmp(&cache_pending, &cache_stored, sizeof(cache_pending)) == 0) ||
+        ((tick - cache_pending_tick) < PARAM_CACHE_SETTLE_TIME) ||
+        (b_cache_written && ((tick - cache_write_tick) < PARAM_CACHE_WRITE_INTERVAL))) {
+        return;
+    }
+
+    cache_write_cnt++;
+    cache_write_tick = tick;
+    b_cache_written = 1;
+    cache_writing = cache_pending;
+    b_cache_writing = 1;
+    b_cache_row_started = 0;
+    cache_write();
+}
+
+/**********************************************************
+ ** Name            : cache_from_param
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Builds a cache record from parameter data
+ **
+ ** Calling         : param_cache_process
+ **
+ ** InputValues     : record, parameter data
+ ** OutputValues    : void
+ **********************************************************/
+static void cache_from_param(param_cache_record_t *p_record, const param_info_to_gui *p_param) {
+    memset(p_record, 0, sizeof(param_cache_record_t));
+    p_record->version = PARAM_CACHE_VERSION;
+    p_record->ID = p_param->ID;
+    p_record->unit_id = p_param->unit_id;
+    p_record->type = p_param->type;
+    p_record->image = p_param->image;
+    p_record->text = p_param->text;
+    p_record->total_params = p_param->total_params;
+    p_record->total_qas = p_param->total_qas;
+    p_record->value = p_param->value;
+    p_record->min = p_param->min;
+    p_record->max = p_param->max;
+    p_record->crc = ow_crc16_ds2431(0, (const uint8_t *)p_record, offsetof(param_cache_record_t, crc));
+}
+
+/**********************************************************
+ ** Name            : cache_write
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Continues saving the record, it is placed in the
+ **                   page content and the dirty rows are written one per
+ **                   asynchronous 1-Wire transaction
+ **
+ ** Calling         : param_cache_process
+ **
+ ** InputValues     : void
+ ** OutputValues    : int. 1=Save in progress. 0=Done. -1=Failure
+ **********************************************************/
+static int cache_write(void) {
+    if (b_cache_row_started) {
+        if (cache_ow_status == HAL_BUSY) {
+            return 1;
+        }
+        b_cache_row_started = 0;
+        if (cache_ow_status != HAL_OK) {
+            /* the row stays dirty in the RAM shadow and is written with the next save */
+            memset(&cache_stored, 0, sizeof(cache_stored));
+            b_cache_writing = 0;
+            return -1;
+        }
+    }
+
+    /* copied with every call, a page read meanwhile would have replaced it */
+    memcpy(st_OwParamPage1.Reserved1, &cache_writing, sizeof(cache_writing));
+    if ((owParamPage_dirty_ds2431() & PARAM_CACHE_ROW_MASK) == 0) {
+        cache_stored = cache_writing;
+        b_cache_writing = 0;
+        return 0;
+    }
+
+    cache_ow_status = HAL_BUSY;
+    if (owParamPage_flush_row_async_ds2431(PARAM_CACHE_ROW_MASK, cache_ow_done) == HAL_OK) {
+        b_cache_row_started = 1;
+    }
+    /* otherwise the 1-Wire is in use, retried with the next call */
+    return 1;
+}
+
+/**********************************************************
+ ** Name            : cache_ow_done
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Takes over the result of a row write
+ **
+ ** Calling         : I2C interrupt
+ **
+ ** InputValues     : HAL_StatusTypeDef status
+ ** OutputValues    : void
+ **********************************************************/
+static void cache_ow_done(HAL_StatusTypeDef status) {
+    cache_ow_status = status;
+}
@@ -0,0 +1,34 @@
+/*
+******************************************************************************
+* @file: param_cache.h
+* @author:
+* @brief: Last known parameter data, kept in the EEPROM of the torch
+******************************************************************************
+*
+******************************************************************************
+*/
+
+#ifndef _PARAM_CACHE_H
+#define _PARAM_CACHE_H
+
+/*** Include *****************************************************************/
+#include "types.h"
+
+/* NO MORE DEFINITIONS */
+
+/*** Preprocessor definitions ************************************************/
+/* NO MORE DEFINITIONS */
+
+/*** Definition of variables *************************************************/
+/* NO MORE DEFINITIONS */
+
+/*** Prototypes of functions *************************************************/
+int param_cache_restore(void);
+void param_cache_process(void);
+
+/* NO MORE DEFINITIONS */
+
+/*** Definitions of functions ************************************************/
+/* NO MORE DEFINITIONS */
+
+#endif //_PARAM_CACHE_H
@@ -19,13 +19,32 @@
 /*** Preprocessor definitions ************************************************/
 #define SERIAL_COM_TRACE_TIME_OUT ((uint32_t)100U) /*!< Serial PutString Timeout*/
 #define BUFFER_SIZE               10
+#define SERIAL_LOG_SIZE           2048U // bytes of the log ring, power of 2
+#define SERIAL_LOG_MASK           (SERIAL_LOG_SIZE - 1U)
+#define SERIAL_LOG_CALL_MAX       128U // characters taken over by one call, the rest is dropped
+#define SERIAL_LOG_CHUNK_MAX      256U // bytes of one DMA transfer
 
 /* NO DEFINITIONS */
 
 /*** Definition of variables *************************************************/
 UART_HandleTypeDef huart1;
 
+/* log ring, head and tail run freely and are masked on access. The head is
+ * written by the callers of the output functions, the tail by the DMA
+ * callbacks. */
+static uint8_t serial_log[SERIAL_LOG_SIZE];
+static volatile uint32_t serial_log_head = 0;
+static volatile uint32_t serial_log_tail = 0;
+
+/* bytes of the running DMA transfer, 0 = idle, and bytes of it released by the half transfer */
+static volatile uint32_t serial_tx_len = 0;
+static volatile uint32_t serial_tx_released = 0;
+
+static serial_log_stats_t serial_log_stats;
+
 /*** Prototypes of functions *************************************************/
+static void serial_log_put(const char *pString, uint8_t b_crlf);
+static void serial_tx_start(void);
 
 /*** Definitions of functions ************************************************/
 
@@ -63,7 +82,9 @@ void MX_UART1_Init(void) {
  **
  ** Created from/on : APR / 10.08.2023
  **
- ** Description     : print the string provided as parameter
+ ** Description     : print the string provided as parameter. The string is
+ **                   copied into the log ring and sent by DMA, the call
+ **                   does not wait for the UART. Interrupts may call it.
  **
  ** Calling         : to print a message
  **
@@ -71,19 +92,206 @@ void MX_UART1_Init(void) {
  ** OutputValues    : none
  **********************************************************/
 void Serial_COM_PutString(char *pString) {
-    uint16_t length = 0U;
-
     /* Check the pointers allocation */
     if (pString == NULL) {
         Error_Handler();
     }
 
-    while (pString[length] != (uint8_t)'\0') {
-        length++;
+    serial_log_put(pString, 0);
+}
+
+/**********************************************************
+ ** Name            : Serial_COM_PutConsole
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Prints a trace message of Embedded Wizard (EwPrint)
+ **                   by the log ring, a carriage return is added to each
+ **                   newline
+ **
+ ** Calling         : EwConsoleOutput
+ **
+ ** InputValues     : const char *
+ ** OutputValues    : none
+ **********************************************************/
+void Serial_COM_PutConsole(const char *pString) {
+    if (pString != NULL) {
+        serial_log_put(pString, 1);
     }
-    if (HAL_UART_Transmit(&huart1, (uint8_t *)pString, length, SERIAL_COM_TRACE_TIME_OUT) != HAL_OK) {
-        Error_Handler();
+}
+
+/**********************************************************
+ ** Name            : Serial_COM_PutString_Blocking
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Aborts the log output and prints the string by
+ **                   polling the UART, works with disabled interrupts
+ **
+ ** Calling         : Error_Handler
+ **
+ ** InputValues     : char *
+ ** OutputValues    : none
+ **********************************************************/
+void Serial_COM_PutString_Blocking(char *pString) {
+    HAL_UART_AbortTransmit(&huart1);
+    serial_log_tail = serial_log_head;
+    serial_tx_len = 0;
+    HAL_UART_Transmit(&huart1, (uint8_t *)pString, strlen(pString), SERIAL_COM_TRACE_TIME_OUT);
+}
+
+/**********************************************************
+ ** Name            : Serial_COM_GetLogStats
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Gets the statistics of the log ring
+ **
+ ** Calling         : fdcan2 (CO_GET_SERIALLOG)
+ **
+ ** InputValues     : statistics
+ ** OutputValues    : none
+ **********************************************************/
+void Serial_COM_GetLogStats(serial_log_stats_t *p_stats) {
+    *p_stats = serial_log_stats;
+}
+
+/**********************************************************
+ ** Name            : serial_log_put
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Copies a string into the log ring and starts the DMA
+ **                   if it is idle. Callers of all interrupt priorities
+ **                   are serialized by disabling the interrupts for the
+ **                   copy of at most SERIAL_LOG_CALL_MAX characters. A
+ **                   string not fitting completely is cut and counted as
+ **                   dropped.
+ **
+ ** Calling         : Serial_COM_PutString, Serial_COM_PutConsole
+ **
+ ** InputValues     : const char *, uint8_t b_crlf. 1 = CR before LF
+ ** OutputValues    : none
+ **********************************************************/
+static void serial_log_put(const char *pString, uint8_t b_crlf) {
+    uint32_t primask = __get_PRIMASK();
+    uint32_t head;
+    uint32_t free;
+    uint32_t fill;
+    uint32_t n = 0;
+
+    __disable_irq();
+    head = serial_log_head;
+    free = SERIAL_LOG_SIZE - (head - serial_log_tail);
+    while ((pString[n] != '\0') && (n < SERIAL_LOG_CALL_MAX)) {
+        if (b_crlf && (pString[n] == '\n')) {
+            if (free < 2) {
+                break;
+            }
+            serial_log[head++ & SERIAL_LOG_MASK] = '\r';
+            free--;
+        } else if (free < 1) {
+            break;
+        }
+        serial_log[head++ & SERIAL_LOG_MASK] = (uint8_t)pString[n++];
+        free--;
+    }
+    if (pString[n] != '\0') {
+        serial_log_stats.drops++;
+    }
+    serial_log_head = head;
+
+    fill = head - serial_log_tail;
+    if (fill > serial_log_stats.fill_max) {
+        serial_log_stats.fill_max = fill;
+    }
+    if (serial_tx_len == 0) {
+        serial_tx_start();
+    }
+    __set_PRIMASK(primask);
+}
+
+/**********************************************************
+ ** Name            : serial_tx_start
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Starts the DMA transfer of the next contiguous part
+ **                   of the log ring, at most SERIAL_LOG_CHUNK_MAX bytes
+ **
+ ** Calling         : serial_log_put, HAL_UART_TxCpltCallback, with
+ **                   disabled interrupts
+ **
+ ** InputValues     : none
+ ** OutputValues    : none
+ **********************************************************/
+static void serial_tx_start(void) {
+    uint32_t tail = serial_log_tail;
+    uint32_t offset = tail & SERIAL_LOG_MASK;
+    uint32_t len = serial_log_head - tail;
+
+    if (len > (SERIAL_LOG_SIZE - offset)) {
+        len = SERIAL_LOG_SIZE - offset;
+    }
+    if (len > SERIAL_LOG_CHUNK_MAX) {
+        len = SERIAL_LOG_CHUNK_MAX;
+    }
+    if (len == 0) {
+        return;
+    }
+
+    serial_tx_released = 0;
+    serial_tx_len = len;
+    if (HAL_UART_Transmit_DMA(&huart1, &serial_log[offset], (uint16_t)len) != HAL_OK) {
+        serial_tx_len = 0;
+    }
+}
+
+/**********************************************************
+ ** Name            : HAL_UART_TxHalfCpltCallback
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Releases the first half of the running transfer
+ **                   for new log output
+ **
+ ** Calling         : DMA1 channel 5 interrupt
+ **
+ ** InputValues     : UART_HandleTypeDef *
+ ** OutputValues    : none
+ **********************************************************/
+void HAL_UART_TxHalfCpltCallback(UART_HandleTypeDef *huart) {
+    if (huart != &huart1) {
+        return;
+    }
+    serial_tx_released = serial_tx_len / 2;
+    serial_log_tail += serial_tx_released;
+}
+
+/**********************************************************
+ ** Name            : HAL_UART_TxCpltCallback
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Releases the rest of the finished transfer and
+ **                   starts the next one
+ **
+ ** Calling         : USART1 interrupt
+ **
+ ** InputValues     : UART_HandleTypeDef *
+ ** OutputValues    : none
+ **********************************************************/
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) {
+    uint32_t primask = __get_PRIMASK();
+
+    if (huart != &huart1) {
+        return;
     }
+    __disable_irq();
+    serial_log_tail += serial_tx_len - serial_tx_released;
+    serial_tx_len = 0;
+    serial_tx_start();
+    __set_PRIMASK(primask);
 }
 
 /**********************************************************
@@ -20,11 +20,19 @@
 /* NO MORE DEFINITIONS */
 
 /*** Definition of variables *************************************************/
-/* NO MORE DEFINITIONS */
+
+/* statistics of the log ring */
+typedef struct {
+    uint32_t drops;    // strings cut because the ring was full
+    uint32_t fill_max; // maximum of bytes waiting in the ring
+} serial_log_stats_t;
 
 /*** Prototypes of functions *************************************************/
 void MX_UART1_Init(void);
 void Serial_COM_PutString(char *pString);
+void Serial_COM_PutConsole(const char *pString);
+void Serial_COM_PutString_Blocking(char *pString);
+void Serial_COM_GetLogStats(serial_log_stats_t *p_stats);
 /* NO MORE DEFINITIONS */
 
 /*** Definitions of functions ************************************************/
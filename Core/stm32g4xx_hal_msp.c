@@ -43,6 +43,7 @@
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE BEGIN PV */
 DMA_HandleTypeDef DisplayDmaHandle;
+DMA_HandleTypeDef SerialDmaHandle;
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -219,16 +220,15 @@ void HAL_TIM_Base_MspInit(TIM_HandleTypeDef *htim_base) {
     if (htim_base->Instance == TIM17) {
         /* Peripheral clock enable */
         __HAL_RCC_TIM17_CLK_ENABLE();
-        /* TIM16 interrupt Init */
+        /* TIM17 interrupt Init, priority of the EXTI interrupts of the keys */
         HAL_NVIC_SetPriority(TIM1_TRG_COM_TIM17_IRQn, 0, 0);
         HAL_NVIC_EnableIRQ(TIM1_TRG_COM_TIM17_IRQn);
     }
-    if (htim_base->Instance == TIM15) {
-        /* Peripheral clock enable */
-        __HAL_RCC_TIM15_CLK_ENABLE();
-        /* TIM16 interrupt Init */
-        HAL_NVIC_SetPriority(TIM1_BRK_TIM15_IRQn, 0, 0);
-        HAL_NVIC_EnableIRQ(TIM1_BRK_TIM15_IRQn);
+
+    /* manually added */
+    if (htim_base->Instance == TIM20) {
+        /* Peripheral clock enable, LED DMA requests only */
+        __HAL_RCC_TIM20_CLK_ENABLE();
     }
 }
 
@@ -255,12 +255,11 @@ void HAL_TIM_Base_MspDeInit(TIM_HandleTypeDef *htim_base) {
         /* TIM17 interrupt DeInit */
         HAL_NVIC_DisableIRQ(TIM1_TRG_COM_TIM17_IRQn);
     }
-    if (htim_base->Instance == TIM15) {
-        /* Peripheral clock disable */
-        __HAL_RCC_TIM15_CLK_DISABLE();
 
-        /* TIM17 interrupt DeInit */
-        HAL_NVIC_DisableIRQ(TIM1_BRK_TIM15_IRQn);
+    /* manually added */
+    if (htim_base->Instance == TIM20) {
+        /* Peripheral clock disable */
+        __HAL_RCC_TIM20_CLK_DISABLE();
     }
 }
 
@@ -297,6 +296,12 @@ void HAL_I2C_MspInit(I2C_HandleTypeDef *hi2c) {
 
         /* Peripheral clock enable */
         __HAL_RCC_I2C2_CLK_ENABLE();
+
+        /* I2C2 interrupt Init, used by the asynchronous 1-Wire transactions */
+        HAL_NVIC_SetPriority(I2C2_EV_IRQn, 2, 0);
+        HAL_NVIC_EnableIRQ(I2C2_EV_IRQn);
+        HAL_NVIC_SetPriority(I2C2_ER_IRQn, 2, 0);
+        HAL_NVIC_EnableIRQ(I2C2_ER_IRQn);
     }
 
     if (hi2c->Instance == I2C3) {
@@ -322,6 +327,12 @@ void HAL_I2C_MspInit(I2C_HandleTypeDef *hi2c) {
 
         /* Peripheral clock enable */
         __HAL_RCC_I2C3_CLK_ENABLE();
+
+        /* I2C3 interrupt Init, used by the asynchronous 1-Wire transactions */
+        HAL_NVIC_SetPriority(I2C3_EV_IRQn, 2, 0);
+        HAL_NVIC_EnableIRQ(I2C3_EV_IRQn);
+        HAL_NVIC_SetPriority(I2C3_ER_IRQn, 2, 0);
+        HAL_NVIC_EnableIRQ(I2C3_ER_IRQn);
     }
 
     __HAL_RCC_GPIOA_CLK_ENABLE();
@@ -349,6 +360,10 @@ void HAL_I2C_MspDeInit(I2C_HandleTypeDef *hi2c) {
         /* Peripheral clock disable */
         __HAL_RCC_I2C2_CLK_DISABLE();
 
+        /* I2C2 interrupt DeInit */
+        HAL_NVIC_DisableIRQ(I2C2_EV_IRQn);
+        HAL_NVIC_DisableIRQ(I2C2_ER_IRQn);
+
         /**I2C2 GPIO Configuration
         PA8     ------> I2C2_SDA
         PA9     ------> I2C2_SCL
@@ -361,6 +376,10 @@ void HAL_I2C_MspDeInit(I2C_HandleTypeDef *hi2c) {
         /* Peripheral clock disable */
         __HAL_RCC_I2C3_CLK_DISABLE();
 
+        /* I2C3 interrupt DeInit */
+        HAL_NVIC_DisableIRQ(I2C3_EV_IRQn);
+        HAL_NVIC_DisableIRQ(I2C3_ER_IRQn);
+
         /**I2C3 GPIO Configuration
         PC9     ------> I2C3_SDA
         PC8     ------> I2C3_SCL
@@ -393,6 +412,29 @@ void HAL_UART_MspInit(UART_HandleTypeDef *huart) {
         GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
         GPIO_InitStruct.Alternate = GPIO_AF7_USART1;
         HAL_GPIO_Init(GPIOC, &GPIO_InitStruct);
+
+        /* USART1 DMA Init */
+        /* USART1_TX Init, drains the log ring of serial.c */
+        SerialDmaHandle.Instance = DMA1_Channel5;
+        SerialDmaHandle.Init.Request = DMA_REQUEST_USART1_TX;
+        SerialDmaHandle.Init.Direction = DMA_MEMORY_TO_PERIPH;
+        SerialDmaHandle.Init.PeriphInc = DMA_PINC_DISABLE;
+        SerialDmaHandle.Init.MemInc = DMA_MINC_ENABLE;
+        SerialDmaHandle.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+        SerialDmaHandle.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+        SerialDmaHandle.Init.Mode = DMA_NORMAL;
+        SerialDmaHandle.Init.Priority = DMA_PRIORITY_LOW;
+        if (HAL_DMA_Init(&SerialDmaHandle) != HAL_OK) {
+            Error_Handler();
+        }
+
+        __HAL_LINKDMA(huart, hdmatx, SerialDmaHandle);
+
+        /* lowest priority, only the log output */
+        HAL_NVIC_SetPriority(DMA1_Channel5_IRQn, 3, 0);
+        HAL_NVIC_EnableIRQ(DMA1_Channel5_IRQn);
+        HAL_NVIC_SetPriority(USART1_IRQn, 3, 0);
+        HAL_NVIC_EnableIRQ(USART1_IRQn);
     }
 }
 
@@ -410,6 +452,10 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef *huart) {
         HAL_GPIO_DeInit(GPIOC, GPIO_PIN_4);
 
         HAL_GPIO_DeInit(GPIOC, GPIO_PIN_5);
+
+        HAL_DMA_DeInit(huart->hdmatx);
+        HAL_NVIC_DisableIRQ(DMA1_Channel5_IRQn);
+        HAL_NVIC_DisableIRQ(USART1_IRQn);
     }
 }
 
@@ -25,6 +25,8 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "DisplayDriver.h"
+#include "i2c.h"
+#include "cpu_load.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -59,12 +61,10 @@
 
 /* External variables --------------------------------------------------------*/
 extern DMA_HandleTypeDef DisplayDmaHandle;
-extern uint16_t TestModeTimeout;
-extern uint16_t TestModeLEDTimeout;
+extern DMA_HandleTypeDef SerialDmaHandle;
+extern UART_HandleTypeDef huart1;
 extern uint8_t TestMode;
 extern test_stage_t e_TestStage;
-extern LED_Blink_on_off_t LEDResultDisplay;
-extern uint8_t PassFailflg;
 
 extern test_result_status_t TestResult;
 extern test_state_status_t TestState;
@@ -200,33 +200,148 @@ void SysTick_Handler(void) {
  */
 void TIM1_UP_TIM16_IRQHandler(void) {
     /* USER CODE BEGIN TIM1_UP_TIM16_IRQn 0 */
-
+    cpu_isr_frame_t frame;
+    cpu_load_isr_enter(E_CPU_ISR_TIM16, &frame);
     /* USER CODE END TIM1_UP_TIM16_IRQn 0 */
     HAL_TIM_IRQHandler(&htim16);
     /* USER CODE BEGIN TIM1_UP_TIM16_IRQn 1 */
-
+    cpu_load_isr_exit(E_CPU_ISR_TIM16, &frame);
     /* USER CODE END TIM1_UP_TIM16_IRQn 1 */
 }
 
 /* USER CODE BEGIN 1 */
 
-void TIM1_TRG_COM_TIM17_IRQHandler(void) {
-    HAL_TIM_IRQHandler(&htim17);
+/**
+ * @brief  This function handles DMA1 Channel_1 IRQ.
+ * @param  None
+ * @retval None
+ */
+void DMA1_Channel1_IRQHandler(void) {
+    cpu_isr_frame_t frame;
+
+    cpu_load_isr_enter(E_CPU_ISR_DISPLAY, &frame);
+    DisplayDriver_DmaCallback();
+    cpu_load_isr_exit(E_CPU_ISR_DISPLAY, &frame);
 }
 
-// 10ms interrupt
-void TIM1_BRK_TIM15_IRQHandler(void) {
-    HAL_TIM_IRQHandler(&htim15);
-    TIM15_interrupt_handler();
+/**
+ * @brief  These functions handle the USART1 TX DMA and the USART1 IRQ of the
+ *         log output.
+ * @param  None
+ * @retval None
+ */
+void DMA1_Channel5_IRQHandler(void) {
+    cpu_isr_frame_t frame;
+
+    cpu_load_isr_enter(E_CPU_ISR_UART, &frame);
+    HAL_DMA_IRQHandler(&SerialDmaHandle);
+    cpu_load_isr_exit(E_CPU_ISR_UART, &frame);
+}
+
+void USART1_IRQHandler(void) {
+    cpu_isr_frame_t frame;
+
+    cpu_load_isr_enter(E_CPU_ISR_UART, &frame);
+    HAL_UART_IRQHandler(&huart1);
+    cpu_load_isr_exit(E_CPU_ISR_UART, &frame);
 }
 
 /**
- * @brief  This function handles DMA1 Channel_1 IRQ.
+ * @brief  These functions handle the I2C event and error IRQs of the DS2484
+ *         1-Wire bridge, I2C2 on the old PCB and I2C3 on the new PCB.
  * @param  None
  * @retval None
  */
-void DMA1_Channel1_IRQHandler(void) {
-    DisplayDriver_DmaCallback();
+void I2C2_EV_IRQHandler(void) {
+    cpu_isr_frame_t frame;
+
+    cpu_load_isr_enter(E_CPU_ISR_I2C, &frame);
+    HAL_I2C_EV_IRQHandler(&hi2cOneWire);
+    cpu_load_isr_exit(E_CPU_ISR_I2C, &frame);
+}
+
+void I2C2_ER_IRQHandler(void) {
+    cpu_isr_frame_t frame;
+
+    cpu_load_isr_enter(E_CPU_ISR_I2C, &frame);
+    HAL_I2C_ER_IRQHandler(&hi2cOneWire);
+    cpu_load_isr_exit(E_CPU_ISR_I2C, &frame);
+}
+
+void I2C3_EV_IRQHandler(void) {
+    cpu_isr_frame_t frame;
+
+    cpu_load_isr_enter(E_CPU_ISR_I2C, &frame);
+    HAL_I2C_EV_IRQHandler(&hi2cOneWire);
+    cpu_load_isr_exit(E_CPU_ISR_I2C, &frame);
+}
+
+void I2C3_ER_IRQHandler(void) {
+    cpu_isr_frame_t frame;
+
+    cpu_load_isr_enter(E_CPU_ISR_I2C, &frame);
+    HAL_I2C_ER_IRQHandler(&hi2cOneWire);
+    cpu_load_isr_exit(E_CPU_ISR_I2C, &frame);
+}
+
+/**
+ * @brief  These functions handle the EXTI IRQs of the push buttons and the
+ *         torch switch, both edges of each key are captured.
+ * @param  None
+ * @retval None
+ */
+void EXTI0_IRQHandler(void) {
+    cpu_isr_frame_t frame;
+
+    cpu_load_isr_enter(E_CPU_ISR_EXTI, &frame);
+    HAL_GPIO_EXTI_IRQHandler(BUTTON_RIGHT_Pin);
+    cpu_load_isr_exit(E_CPU_ISR_EXTI, &frame);
+}
+
+void EXTI1_IRQHandler(void) {
+    cpu_isr_frame_t frame;
+
+    cpu_load_isr_enter(E_CPU_ISR_EXTI, &frame);
+    HAL_GPIO_EXTI_IRQHandler(BUTTON_DOWN_Pin);
+    cpu_load_isr_exit(E_CPU_ISR_EXTI, &frame);
+}
+
+void EXTI2_IRQHandler(void) {
+    cpu_isr_frame_t frame;
+
+    cpu_load_isr_enter(E_CPU_ISR_EXTI, &frame);
+    HAL_GPIO_EXTI_IRQHandler(BUTTON_UP_Pin);
+    cpu_load_isr_exit(E_CPU_ISR_EXTI, &frame);
+}
+
+void EXTI3_IRQHandler(void) {
+    cpu_isr_frame_t frame;
+
+    cpu_load_isr_enter(E_CPU_ISR_EXTI, &frame);
+    HAL_GPIO_EXTI_IRQHandler(BUTTON_LEFT_Pin);
+    cpu_load_isr_exit(E_CPU_ISR_EXTI, &frame);
+}
+
+void EXTI15_10_IRQHandler(void) {
+    cpu_isr_frame_t frame;
+
+    cpu_load_isr_enter(E_CPU_ISR_EXTI, &frame);
+    HAL_GPIO_EXTI_IRQHandler(TORCH_SWITCH_Pin);
+    cpu_load_isr_exit(E_CPU_ISR_EXTI, &frame);
+}
+
+/**
+ * @brief  This function handles the TIM17 IRQ, the compare which takes over
+ *         the torch switch once it settled. It is counted with the key edges.
+ * @param  None
+ * @retval None
+ */
+void TIM1_TRG_COM_TIM17_IRQHandler(void) {
+    cpu_isr_frame_t frame;
+
+    cpu_load_isr_enter(E_CPU_ISR_EXTI, &frame);
+    HAL_TIM_IRQHandler(&htim17);
+    cpu_load_isr_exit(E_CPU_ISR_EXTI, &frame);
 }
 
 /* USER CODE END 1 */
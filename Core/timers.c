@@ -19,40 +19,14 @@
 /* NO DEFINITIONS */
 
 /*** Definition of variables *************************************************/
-TIM_HandleTypeDef htim15;
 TIM_HandleTypeDef htim16;
 TIM_HandleTypeDef htim17;
+TIM_HandleTypeDef htim20;
 static uint8_t can_busoff_count = 0;
 
 /*** Prototypes of functions *************************************************/
 
 /*** Definitions of functions ************************************************/
-/**********************************************************
- ** Name            : MX_TIM15_Init
- **
- ** Created from/on : SP / 30.10.2023
- **
- ** Description     : Initialise Timer 15
- **
- ** Calling         : main
- **
- ** InputValues     : none
- ** OutputValues    : none
- **********************************************************/
-void MX_TIM15_Init(void) {
-
-    htim15.Instance = TIM15;
-    htim15.Init.Prescaler = 40000;
-    htim15.Init.CounterMode = TIM_COUNTERMODE_UP;
-    htim15.Init.Period = 40; /* 10 msec */
-    htim15.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
-    htim15.Init.RepetitionCounter = 0;
-    htim15.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
-    if (HAL_TIM_Base_Init(&htim15) != HAL_OK) {
-        Error_Handler();
-    }
-}
-
 /**********************************************************
  ** Name            : MX_TIM16_Init
  **
@@ -82,9 +56,13 @@ void MX_TIM16_Init(void) {
 /**********************************************************
  ** Name            : MX_TIM17_Init
  **
- ** Created from/on : APR / 10.08.2023
+ ** Created from/on : 18.10.2026
  **
- ** Description     : Initialise Timer 17
+ ** Description     : Initialise Timer 17, free running at
+ **                   1 MHz. The compare of channel 1 is a
+ **                   one-shot delay for the keys, started by
+ **                   tim17_start_compare(). Its interrupt
+ **                   stays enabled during EwProcess().
  **
  ** Calling         : main
  **
@@ -92,16 +70,88 @@ void MX_TIM16_Init(void) {
  ** OutputValues    : none
  **********************************************************/
 void MX_TIM17_Init(void) {
+    TIM_OC_InitTypeDef sConfigOC = {0};
+
     htim17.Instance = TIM17;
-    htim17.Init.Prescaler = 40000;
+    htim17.Init.Prescaler = (SystemCoreClock / 1000000U) - 1U; /* 1 MHz */
     htim17.Init.CounterMode = TIM_COUNTERMODE_UP;
-    htim17.Init.Period = 16; /* 4 msec */
+    htim17.Init.Period = 0xFFFF;
     htim17.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
     htim17.Init.RepetitionCounter = 0;
     htim17.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
     if (HAL_TIM_Base_Init(&htim17) != HAL_OK) {
         Error_Handler();
     }
+
+    /* compare only raises the interrupt, enabled by tim17_start_compare() */
+    sConfigOC.OCMode = TIM_OCMODE_TIMING;
+    sConfigOC.Pulse = 0;
+    sConfigOC.OCPolarity = TIM_OCPOLARITY_HIGH;
+    sConfigOC.OCFastMode = TIM_OCFAST_DISABLE;
+    if (HAL_TIM_OC_ConfigChannel(&htim17, &sConfigOC, TIM_CHANNEL_1) != HAL_OK) {
+        Error_Handler();
+    }
+}
+
+/**********************************************************
+ ** Name            : tim17_start_compare
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Starts the one-shot compare of TIM17,
+ **                   a compare already started is moved.
+ **
+ ** Calling         : HAL_GPIO_EXTI_Callback
+ **
+ ** InputValues     : delay in usec, at most 0xFFFF
+ ** OutputValues    : none
+ **********************************************************/
+void tim17_start_compare(uint16_t us) {
+    __HAL_TIM_SET_COMPARE(&htim17, TIM_CHANNEL_1, (__HAL_TIM_GET_COUNTER(&htim17) + us) & 0xFFFFU);
+    __HAL_TIM_CLEAR_FLAG(&htim17, TIM_FLAG_CC1);
+    __HAL_TIM_ENABLE_IT(&htim17, TIM_IT_CC1);
+}
+
+/**********************************************************
+ ** Name            : MX_TIM20_Init
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Initialise Timer 20, the slot clock of the LED PWM
+ **                   frames. The update and the compare events of channel
+ **                   1 and 2 request the DMA transfers of up to three
+ **                   ports, no interrupt.
+ **
+ ** Calling         : main
+ **
+ ** InputValues     : none
+ ** OutputValues    : none
+ **********************************************************/
+void MX_TIM20_Init(void) {
+    TIM_OC_InitTypeDef sConfigOC = {0};
+
+    htim20.Instance = TIM20;
+    htim20.Init.Prescaler = 159; /* 1 MHz */
+    htim20.Init.CounterMode = TIM_COUNTERMODE_UP;
+    htim20.Init.Period = 249; /* 250 usec */
+    htim20.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    htim20.Init.RepetitionCounter = 0;
+    htim20.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+    if (HAL_TIM_Base_Init(&htim20) != HAL_OK) {
+        Error_Handler();
+    }
+
+    /* compare at the begin of each slot, only to request the DMA */
+    sConfigOC.OCMode = TIM_OCMODE_TIMING;
+    sConfigOC.Pulse = 0;
+    sConfigOC.OCPolarity = TIM_OCPOLARITY_HIGH;
+    sConfigOC.OCFastMode = TIM_OCFAST_DISABLE;
+    if (HAL_TIM_OC_ConfigChannel(&htim20, &sConfigOC, TIM_CHANNEL_1) != HAL_OK) {
+        Error_Handler();
+    }
+    if (HAL_TIM_OC_ConfigChannel(&htim20, &sConfigOC, TIM_CHANNEL_2) != HAL_OK) {
+        Error_Handler();
+    }
 }
 
 /**********************************************************
@@ -119,9 +169,8 @@ void MX_TIM17_Init(void) {
 void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim) {
     if (htim == &htim16) {
         static int cnt = 0;
-        static uint16_t inputs_sum = 0;
-        static uint16_t inputs_sum_last = 0xFFFF;
-        static uint16_t inputs;
+        uint16_t inputs;
+        int8_t repeat;
 
         /* all 10 msec */
 
@@ -136,49 +185,37 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim) {
             }
         }
 
-        /* check for inputs */
-        inout_get_inputs(&inputs);
-        inputs_sum |= inputs;
-
-        /* all 50 msec */
-        if (!(cnt % 5)) {
-#if 0 // commented as it is requesting the config every 5 seconds
-			/* check for time out */
-			state_check_tmo(&b_request_cfg);
-
-
-			/* check if a torch configuration shall be requested */
-			if (b_request_cfg)
-			{
-				/* request a torch configuration */
-			//	msg_send_cfg_request();
-
-				b_request_cfg = 0;
-			}
-			else
-			{
-#endif
-            /* send message with inputs each second or on changed inputs */
-            if ((inputs_sum != inputs_sum_last) || !(cnt % 100)) {
-                if (!((get_param_id() == 0) && ((inputs_sum == 0x0100) || (inputs_sum == 0x0200)))) {
-                    msg_send_inputs(inputs_sum);
-                } else {
-                    // do nothing for now, to prevent QA requesting information through up and down buttons
-                }
-
-                inputs_sum_last = inputs_sum;
-                cnt = 0;
-            }
-            //	}
-
-            inputs_sum = 0;
+        /* send message with inputs each second or on changed inputs, changes of the keys are normally sent by
+         * the EXTI interrupts and the TIM17 compare already. The auto-repeat steps of UP/DOWN are collected over
+         * 50 msec and sent as one message. */
+        inout_get_keys(&inputs);
+        repeat = (cnt % 5) ? 0 : inout_get_key_repeat();
+        if (msg_update_inputs(inputs, repeat, !(cnt % 100))) {
+            cnt = 0;
         }
 
         cnt++;
         cnt %= 1000;
-    } else if (htim == &htim17) {
-        /* all 4 msec */
-        inout_trigger_outputs();
+    }
+}
+
+/**********************************************************
+ ** Name            : HAL_TIM_OC_DelayElapsedCallback
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Timer compare call back function, the
+ **                   compare of TIM17 is a one-shot
+ **
+ ** Calling         : Timer interrupt function
+ **
+ ** InputValues     : TIM_HandleTypeDef *
+ ** OutputValues    : none
+ **********************************************************/
+void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim) {
+    if (htim == &htim17) {
+        __HAL_TIM_DISABLE_IT(&htim17, TIM_IT_CC1);
+        inout_settle_keys();
     }
 }
 
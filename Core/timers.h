@@ -24,9 +24,10 @@
 /* NO MORE DEFINITIONS */
 
 /*** Prototypes of functions *************************************************/
-void MX_TIM15_Init(void);
 void MX_TIM16_Init(void);
 void MX_TIM17_Init(void);
+void MX_TIM20_Init(void);
+void tim17_start_compare(uint16_t us);
 /* NO MORE DEFINITIONS */
 
 /*** Definitions of functions ************************************************/
@@ -0,0 +1,101 @@
+/*
+******************************************************************************
+* @file: trace.c
+* @author:
+* @brief: Tokenized trace records.
+*         A trace point writes its ID, a cycle counter time stamp and its raw
+*         arguments into a RAM ring, the text is only formatted on the host.
+*         The ring keeps the newest records and is read by the debugger
+*         (symbol trace_buffer), tools/trace_decode.py decodes it with the
+*         format strings of TRACE_TABLE in trace.h.
+*
+*         Record: header word (ID in bits 0..15, number of arguments in bits
+*         16..23, 0xA5 in bits 24..31), time stamp (DWT cycle counter),
+*         arguments.
+******************************************************************************
+*
+******************************************************************************
+*/
+
+/*** Include *****************************************************************/
+#include "trace.h"
+#include "main.h"
+/* NO MORE DEFINITIONS */
+
+/*** Preprocessor definitions ************************************************/
+#define TRACE_RING_MASK   (TRACE_RING_WORDS - 1U)
+#define TRACE_HEADER_SYNC 0xA5000000U // marks the header word of a record
+
+/*** Definition of variables *************************************************/
+trace_buffer_t trace_buffer = {TRACE_MAGIC, TRACE_RING_WORDS, 0, 0, {0}};
+
+/*** Prototypes of functions *************************************************/
+
+/*** Definitions of functions ************************************************/
+
+/**********************************************************
+ ** Name            : trace_init
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Records the CPU clock for the decoder, the DWT cycle
+ **                   counter of the time stamps is started by
+ **                   cpu_load_init()
+ **
+ ** Calling         : main, after cpu_load_init
+ **
+ ** InputValues     : none
+ ** OutputValues    : none
+ **********************************************************/
+void trace_init(void) {
+    trace_buffer.cpu_hz = SystemCoreClock;
+}
+
+/**********************************************************
+ ** Name            : trace_write
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Writes a record into the trace ring, the oldest
+ **                   records are overwritten. The interrupts are disabled
+ **                   for the few word writes only, so trace points may be
+ **                   used in interrupts of any priority.
+ **
+ ** Calling         : TRACE0..TRACE4
+ **
+ ** InputValues     : trace_id_t id, uint32_t number of arguments,
+ **                   arguments
+ ** OutputValues    : none
+ **********************************************************/
+void trace_write(trace_id_t id, uint32_t n, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3) {
+    uint32_t primask = __get_PRIMASK();
+    uint32_t *p_ring = trace_buffer.ring;
+    uint32_t head;
+
+    if (n > TRACE_ARGS_MAX) {
+        n = TRACE_ARGS_MAX;
+    }
+
+    __disable_irq();
+    head = trace_buffer.head;
+    p_ring[head++ & TRACE_RING_MASK] = TRACE_HEADER_SYNC | (n << 16) | (uint32_t)id;
+    p_ring[head++ & TRACE_RING_MASK] = DWT->CYCCNT;
+    switch (n) {
+    case 4:
+        p_ring[(head + 3) & TRACE_RING_MASK] = a3;
+        /* fall through */
+    case 3:
+        p_ring[(head + 2) & TRACE_RING_MASK] = a2;
+        /* fall through */
+    case 2:
+        p_ring[(head + 1) & TRACE_RING_MASK] = a1;
+        /* fall through */
+    case 1:
+        p_ring[head & TRACE_RING_MASK] = a0;
+        break;
+    default:
+        break;
+    }
+    trace_buffer.head = head + n;
+    __set_PRIMASK(primask);
+}
@@ -0,0 +1,81 @@
+/*
+******************************************************************************
+* @file: trace.h
+* @author:
+* @brief: Tokenized trace records, decoded on the host by
+*         tools/trace_decode.py
+******************************************************************************
+*
+******************************************************************************
+*/
+
+#ifndef _TRACE_H
+#define _TRACE_H
+
+/*** Include *****************************************************************/
+#include "types.h"
+
+/* NO MORE DEFINITIONS */
+
+/*** Preprocessor definitions ************************************************/
+#ifndef TRACE_ENABLE
+    #define TRACE_ENABLE 1 // 0 removes all trace points
+#endif
+
+#define TRACE_RING_WORDS 512        // words of the trace ring, power of 2
+#define TRACE_ARGS_MAX   4          // arguments of a record
+#define TRACE_MAGIC      0x54524331 // "TRC1", begin of trace_buffer
+
+/* Trace points: ID and format string. The format strings are not part of the
+ * firmware, the host decoder reads them from this table. New entries are
+ * appended, so the IDs of recorded traces stay valid. */
+#define TRACE_TABLE(X)                                                                                                 \
+    X(TRACE_CAN_RX, "CAN rx 0x%03x data[0]=0x%02x")                                                                    \
+    X(TRACE_OW_START, "1-Wire start ops=%u")                                                                           \
+    X(TRACE_OW_DONE, "1-Wire done status=%u")                                                                          \
+    X(TRACE_GUI_PROCESS, "GUI EwProcess cycles=%u events=%u")                                                          \
+    X(TRACE_EEPROM_JOB, "EEPROM job type=%u latency=%u ms")                                                            \
+    X(TRACE_KEY_INPUTS, "keys inputs=0x%04x repeat=%d")
+
+#define TRACE_ENUM(id, fmt) id,
+
+/*** Definition of variables *************************************************/
+
+/* trace points */
+typedef enum { TRACE_TABLE(TRACE_ENUM) E_TRACE_N } trace_id_t;
+
+/* trace ring as read by the debugger, the record words follow the header */
+typedef struct {
+    uint32_t magic;   // TRACE_MAGIC
+    uint32_t words;   // TRACE_RING_WORDS
+    uint32_t head;    // words written since start, free running
+    uint32_t cpu_hz;  // clock of the time stamps
+    uint32_t ring[TRACE_RING_WORDS];
+} trace_buffer_t;
+
+/*** Prototypes of functions *************************************************/
+void trace_init(void);
+void trace_write(trace_id_t id, uint32_t n, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3);
+
+/* trace points with 0..4 arguments */
+#if TRACE_ENABLE
+    #define TRACE0(id)                 trace_write((id), 0, 0, 0, 0, 0)
+    #define TRACE1(id, a0)             trace_write((id), 1, (uint32_t)(a0), 0, 0, 0)
+    #define TRACE2(id, a0, a1)         trace_write((id), 2, (uint32_t)(a0), (uint32_t)(a1), 0, 0)
+    #define TRACE3(id, a0, a1, a2)     trace_write((id), 3, (uint32_t)(a0), (uint32_t)(a1), (uint32_t)(a2), 0)
+    #define TRACE4(id, a0, a1, a2, a3)                                                                                 \
+        trace_write((id), 4, (uint32_t)(a0), (uint32_t)(a1), (uint32_t)(a2), (uint32_t)(a3))
+#else
+    #define TRACE0(id)
+    #define TRACE1(id, a0)
+    #define TRACE2(id, a0, a1)
+    #define TRACE3(id, a0, a1, a2)
+    #define TRACE4(id, a0, a1, a2, a3)
+#endif
+
+/* NO MORE DEFINITIONS */
+
+/*** Definitions of functions ************************************************/
+/* NO MORE DEFINITIONS */
+
+#endif //_TRACE_H
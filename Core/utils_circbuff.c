@@ -5,6 +5,8 @@
 ******************************************************************************/
 
 /*** Include *****************************************************************/
+#include <string.h>
+
 #include "utils_circbuff.h"
 /* NO MORE DEFINITIONS */
 
@@ -15,6 +17,8 @@
 /* NO MORE DEFINITIONS */
 
 /*** Prototypes of functions *************************************************/
+static inline uint32_t circbuff_load(const uint32_t *p_index);
+static inline void circbuff_store(uint32_t *p_index, uint32_t value);
 /* NO MORE DEFINITIONS */
 
 /*** Definitions of functions ************************************************/
@@ -25,16 +29,16 @@
 **
 ** Description        : @brief initialize the circular buffer.
 **
-** Calling            : @remark
+** Calling            : @remark before the producer and the consumer use it
 **
 ** InputValues        : @param circbuff_hdl Pointer to circbuff handle
-                        @param destination  Pointer to queue buffer
-                        @param max_size     Size (bytes) of the queue buffer
+                        @param buffer       Pointer to queue buffer
+                        @param max_size     Size (bytes) of the queue buffer, power of 2
 **
 ** OutputValues       : @retval bool status. SUCCESS = true; FAILURE = false.
 ******************************************************************************/
-bool utils_circbuff_init(utils_circbuff_handle_t *const circbuff_hdl, uint8_t *const buffer, const uint16_t max_size) {
-    if ((buffer == NULL) || (max_size == 0)) {
+bool utils_circbuff_init(utils_circbuff_handle_t *const circbuff_hdl, uint8_t *const buffer, const uint32_t max_size) {
+    if ((buffer == NULL) || (max_size == 0) || ((max_size & (max_size - 1u)) != 0) || (max_size > 0x80000000u)) {
         circbuff_hdl->buffer = NULL;
         circbuff_hdl->head = 0u;
         circbuff_hdl->tail = 0u;
@@ -54,8 +58,10 @@ bool utils_circbuff_init(utils_circbuff_handle_t *const circbuff_hdl, uint8_t *c
 ** Created from /on   : @author Arun Prasad Bhikshesha / @date 16.08.2022
 **
 ** Description        : @brief get the contents from circular buffer.
+**                      All or nothing: nothing is dequeued if less than size
+**                      bytes are in the buffer. Copied by at most two memcpy.
 **
-** Calling            : @remark
+** Calling            : @remark consumer
 **
 ** InputValues        : @param circbuff_hdl Pointer to circbuff handle
                         @param destination  Pointer to destination buffer
@@ -63,24 +69,27 @@ bool utils_circbuff_init(utils_circbuff_handle_t *const circbuff_hdl, uint8_t *c
 **
 ** OutputValues       : @retval bool status. SUCCESS = true; FAILURE = false.
 ******************************************************************************/
+bool utils_circbuff_dequeue(utils_circbuff_handle_t *const circbuff_hdl, uint8_t destination[], const uint32_t size) {
+    uint32_t tail;
+    uint32_t offset;
+    uint32_t first;
 
-bool utils_circbuff_dequeue(utils_circbuff_handle_t *const circbuff_hdl, uint8_t destination[], const uint8_t size) {
     if ((circbuff_hdl == NULL) || (circbuff_hdl->buffer == NULL) || (destination == NULL)) {
         return false;
     }
-    for (uint8_t i = 0; i < size; i++) {
-        uint16_t next;
-        if (circbuff_hdl->head == circbuff_hdl->tail) {
-            // Circbuff is empty, nothing to dequeue
-            return false;
-        }
-        next = circbuff_hdl->tail + 1;
-        if (next >= circbuff_hdl->maxlen) {
-            next = 0;
-        }
-        destination[i] = circbuff_hdl->buffer[circbuff_hdl->tail];
-        circbuff_hdl->tail = next;
+    tail = circbuff_hdl->tail;
+    if ((circbuff_load(&circbuff_hdl->head) - tail) < size) {
+        // not enough data, nothing to dequeue
+        return false;
+    }
+    offset = tail & (circbuff_hdl->maxlen - 1u);
+    first = circbuff_hdl->maxlen - offset;
+    if (first > size) {
+        first = size;
     }
+    memcpy(destination, &circbuff_hdl->buffer[offset], first);
+    memcpy(&destination[first], circbuff_hdl->buffer, size - first);
+    circbuff_store(&circbuff_hdl->tail, tail + size);
     return true;
 }
 
@@ -90,8 +99,10 @@ bool utils_circbuff_dequeue(utils_circbuff_handle_t *const circbuff_hdl, uint8_t
 ** Created from /on   : @author Arun Prasad Bhikshesha / @date 16.08.2022
 **
 ** Description        : @brief put the contents to circular buffer.
+**                      All or nothing: nothing is enqueued if less than size
+**                      bytes are free. Copied by at most two memcpy.
 **
-** Calling            : @remark
+** Calling            : @remark producer
 **
 ** InputValues        : @param source       Pointer to source array
                         @param circbuff_hdl Pointer to circbuff handle
@@ -99,24 +110,27 @@ bool utils_circbuff_dequeue(utils_circbuff_handle_t *const circbuff_hdl, uint8_t
 **
 ** OutputValues       : @retval bool status. SUCCESS = true; FAILURE = false.
 ******************************************************************************/
-bool utils_circbuff_enqueue(const uint8_t source[], utils_circbuff_handle_t *const circbuff_hdl, const uint8_t size) {
+bool utils_circbuff_enqueue(const uint8_t source[], utils_circbuff_handle_t *const circbuff_hdl, const uint32_t size) {
+    uint32_t head;
+    uint32_t offset;
+    uint32_t first;
+
     if ((circbuff_hdl == NULL) || (circbuff_hdl->buffer == NULL) || (source == NULL)) {
         return false;
     }
-    for (uint8_t i = 0; i < size; i++) {
-        uint16_t next;
-        if (utils_circbuff_full(circbuff_hdl)) {
-            // check whether the buffer is full and return. Re-check whether we need to overwrite the buffer in case
-            // of new data(SGE, MKE)
-            return false;
-        }
-        next = circbuff_hdl->head + 1;
-        if (next >= circbuff_hdl->maxlen) {
-            next = 0;
-        }
-        circbuff_hdl->buffer[circbuff_hdl->head] = source[i];
-        circbuff_hdl->head = next;
+    head = circbuff_hdl->head;
+    if ((circbuff_hdl->maxlen - (head - circbuff_load(&circbuff_hdl->tail))) < size) {
+        // buffer is full, nothing is overwritten
+        return false;
+    }
+    offset = head & (circbuff_hdl->maxlen - 1u);
+    first = circbuff_hdl->maxlen - offset;
+    if (first > size) {
+        first = size;
     }
+    memcpy(&circbuff_hdl->buffer[offset], source, first);
+    memcpy(circbuff_hdl->buffer, &source[first], size - first);
+    circbuff_store(&circbuff_hdl->head, head + size);
     return true;
 }
 
@@ -134,7 +148,7 @@ bool utils_circbuff_enqueue(const uint8_t source[], utils_circbuff_handle_t *con
 ** OutputValues       : @retval bool status. FULL = true; NOT FULL = false.
 ******************************************************************************/
 bool utils_circbuff_full(utils_circbuff_handle_t const *const circbuff_hdl) {
-    return ((circbuff_hdl->head + 1) % circbuff_hdl->maxlen) == circbuff_hdl->tail;
+    return utils_circbuff_size(circbuff_hdl) == circbuff_hdl->maxlen;
 }
 
 /******************************************************************************
@@ -151,7 +165,7 @@ bool utils_circbuff_full(utils_circbuff_handle_t const *const circbuff_hdl) {
 ** OutputValues       : @retval bool status. EMPTY = true; NOT EMPTY = false.
 ******************************************************************************/
 bool utils_circbuff_empty(utils_circbuff_handle_t const *const circbuff_hdl) {
-    return (circbuff_hdl->head == circbuff_hdl->tail);
+    return utils_circbuff_size(circbuff_hdl) == 0u;
 }
 
 /******************************************************************************
@@ -159,26 +173,188 @@ bool utils_circbuff_empty(utils_circbuff_handle_t const *const circbuff_hdl) {
 **
 ** Created from /on   : @author Arun Prasad Bhikshesha / @date 20.04.2023
 **
-** Description        : @brief Returns the circular buffer size.
+** Description        : @brief Returns the number of bytes in the circular
+**                      buffer.
+**
+** Calling            : @remark
+**
+** InputValues        : @param circbuff_hdl Pointer to circbuff handle
+**
+** OutputValues       : @retval uint32_t size.
+******************************************************************************/
+uint32_t utils_circbuff_size(utils_circbuff_handle_t const *const circbuff_hdl) {
+    uint32_t tail = circbuff_load(&circbuff_hdl->tail);
+
+    return circbuff_load(&circbuff_hdl->head) - tail;
+}
+
+/******************************************************************************
+** Name               : @fn utils_circbuff_free
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief Returns the number of free bytes in the
+**                      circular buffer.
 **
 ** Calling            : @remark
 **
 ** InputValues        : @param circbuff_hdl Pointer to circbuff handle
 **
-** OutputValues       : @retval uint16_t size.
+** OutputValues       : @retval uint32_t free bytes.
 ******************************************************************************/
-uint16_t utils_circbuff_size(utils_circbuff_handle_t const *const circbuff_hdl) {
-    uint16_t size = circbuff_hdl->maxlen;
-
-    if (!utils_circbuff_full(circbuff_hdl)) {
-        if (circbuff_hdl->head >= circbuff_hdl->tail) {
-            size = (circbuff_hdl->head - circbuff_hdl->tail);
-        } else {
-            size = (circbuff_hdl->maxlen + circbuff_hdl->head - circbuff_hdl->tail);
-        }
+uint32_t utils_circbuff_free(utils_circbuff_handle_t const *const circbuff_hdl) {
+    return circbuff_hdl->maxlen - utils_circbuff_size(circbuff_hdl);
+}
+
+/******************************************************************************
+** Name               : @fn utils_circbuff_write_acquire
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief Gets the contiguous free span at the head.
+**                      The producer writes it in place and passes it on by
+**                      utils_circbuff_write_commit(). The span ends at the
+**                      end of the buffer, the rest of the free bytes follow
+**                      with the next acquire.
+**
+** Calling            : @remark producer
+**
+** InputValues        : @param circbuff_hdl Pointer to circbuff handle
+                        @param pp_span      Pointer to the begin of the span
+**
+** OutputValues       : @retval uint32_t size (bytes) of the span. 0 = full.
+******************************************************************************/
+uint32_t utils_circbuff_write_acquire(utils_circbuff_handle_t *const circbuff_hdl, uint8_t **const pp_span) {
+    uint32_t head;
+    uint32_t offset;
+    uint32_t span;
+    uint32_t free;
+
+    if ((circbuff_hdl == NULL) || (circbuff_hdl->buffer == NULL)) {
+        *pp_span = NULL;
+        return 0u;
     }
+    head = circbuff_hdl->head;
+    offset = head & (circbuff_hdl->maxlen - 1u);
+    span = circbuff_hdl->maxlen - offset;
+    free = circbuff_hdl->maxlen - (head - circbuff_load(&circbuff_hdl->tail));
+    *pp_span = &circbuff_hdl->buffer[offset];
+    return (free < span) ? free : span;
+}
 
-    return size;
+/******************************************************************************
+** Name               : @fn utils_circbuff_write_commit
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief Passes the written bytes of the acquired span
+**                      on to the consumer.
+**
+** Calling            : @remark producer, after utils_circbuff_write_acquire()
+**
+** InputValues        : @param circbuff_hdl Pointer to circbuff handle
+                        @param size         Written bytes, at most the span size
+**
+** OutputValues       : @retval none
+******************************************************************************/
+void utils_circbuff_write_commit(utils_circbuff_handle_t *const circbuff_hdl, const uint32_t size) {
+    circbuff_store(&circbuff_hdl->head, circbuff_hdl->head + size);
+}
+
+/******************************************************************************
+** Name               : @fn utils_circbuff_read_acquire
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief Gets the contiguous filled span at the tail.
+**                      The consumer reads it in place and frees it by
+**                      utils_circbuff_read_release(). The span ends at the
+**                      end of the buffer, the rest of the data follows with
+**                      the next acquire.
+**
+** Calling            : @remark consumer
+**
+** InputValues        : @param circbuff_hdl Pointer to circbuff handle
+                        @param pp_span      Pointer to the begin of the span
+**
+** OutputValues       : @retval uint32_t size (bytes) of the span. 0 = empty.
+******************************************************************************/
+uint32_t utils_circbuff_read_acquire(utils_circbuff_handle_t *const circbuff_hdl, const uint8_t **const pp_span) {
+    uint32_t tail;
+    uint32_t offset;
+    uint32_t span;
+    uint32_t fill;
+
+    if ((circbuff_hdl == NULL) || (circbuff_hdl->buffer == NULL)) {
+        *pp_span = NULL;
+        return 0u;
+    }
+    tail = circbuff_hdl->tail;
+    offset = tail & (circbuff_hdl->maxlen - 1u);
+    span = circbuff_hdl->maxlen - offset;
+    fill = circbuff_load(&circbuff_hdl->head) - tail;
+    *pp_span = &circbuff_hdl->buffer[offset];
+    return (fill < span) ? fill : span;
+}
+
+/******************************************************************************
+** Name               : @fn utils_circbuff_read_release
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief Frees the read bytes of the acquired span for
+**                      the producer.
+**
+** Calling            : @remark consumer, after utils_circbuff_read_acquire()
+**
+** InputValues        : @param circbuff_hdl Pointer to circbuff handle
+                        @param size         Read bytes, at most the span size
+**
+** OutputValues       : @retval none
+******************************************************************************/
+void utils_circbuff_read_release(utils_circbuff_handle_t *const circbuff_hdl, const uint32_t size) {
+    circbuff_store(&circbuff_hdl->tail, circbuff_hdl->tail + size);
+}
+
+/******************************************************************************
+** Name               : @fn circbuff_load
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief Loads the index written by the other side
+**                      with acquire order: the data passed on by the index
+**                      is not accessed before the index is read. On the
+**                      Cortex-M4 this is a load followed by a DMB.
+**
+** Calling            : @remark
+**
+** InputValues        : @param p_index Pointer to head or tail
+**
+** OutputValues       : @retval uint32_t index
+******************************************************************************/
+static inline uint32_t circbuff_load(const uint32_t *p_index) {
+    return __atomic_load_n(p_index, __ATOMIC_ACQUIRE);
+}
+
+/******************************************************************************
+** Name               : @fn circbuff_store
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief Stores the own index with release order: the
+**                      data is written (producer) or read (consumer) before
+**                      the index passes it on. On the Cortex-M4 this is a DMB
+**                      followed by the store.
+**
+** Calling            : @remark
+**
+** InputValues        : @param p_index Pointer to head or tail
+                        @param value   New index
+**
+** OutputValues       : @retval none
+******************************************************************************/
+static inline void circbuff_store(uint32_t *p_index, uint32_t value) {
+    __atomic_store_n(p_index, value, __ATOMIC_RELEASE);
 }
 
 /* NO MORE DEFINITIONS */
@@ -2,43 +2,53 @@
 ** @file utils_circbuff.h
 ** @author Arun Prasad Bhikshesha
 ** @brief circular buffer enqueue and dequeue functions
+**
+**        Single producer, single consumer: the producer (e.g. an interrupt)
+**        only writes the head, the consumer (e.g. the main loop) only writes
+**        the tail, so no interrupt lock is needed. The size of the buffer is
+**        a power of 2.
 ******************************************************************************/
 
 #ifndef _UTILS_CIRCBUFF_H
 #define _UTILS_CIRCBUFF_H
 
 /*** Include *****************************************************************/
+#include <stddef.h>
 #include "types.h"
-#include "tms.h"
-#include "init.h"
-#include "gData.h"
-#include "gError.h"
-#include <stdio.h>
 /* NO MORE DEFINITIONS */
 
 /*** Preprocessor definitions ************************************************/
+// Initializer of a circular buffer on a static array, its size has to be a power of 2
+#define UTILS_CIRCBUFF_STATIC(array) {(uint8_t *)(array), 0u, 0u, sizeof(array)}
 /* NO MORE DEFINITIONS */
 
 /*** Definition of variables *************************************************/
 // Circular buffer
 typedef struct utils_circbuff_circ_buffer {
     uint8_t *buffer;
-    uint16_t head;
-    uint16_t tail;
-    uint16_t maxlen;
+    uint32_t head;   // bytes enqueued since init, free running, only written by the producer
+    uint32_t tail;   // bytes dequeued since init, free running, only written by the consumer
+    uint32_t maxlen; // size of the buffer, power of 2
 } utils_circbuff_handle_t;
 /* NO MORE DEFINITIONS */
 
 /*** Prototypes of functions *************************************************/
-bool utils_circbuff_init(utils_circbuff_handle_t *const circbuff_hdl, uint8_t *const buffer, const uint16_t max_size);
-bool utils_circbuff_dequeue(utils_circbuff_handle_t *const circbuff_hdl, uint8_t destination[], const uint8_t size);
-bool utils_circbuff_enqueue(const uint8_t source[], utils_circbuff_handle_t *const circbuff_hdl, const uint8_t size);
+bool utils_circbuff_init(utils_circbuff_handle_t *const circbuff_hdl, uint8_t *const buffer, const uint32_t max_size);
+bool utils_circbuff_dequeue(utils_circbuff_handle_t *const circbuff_hdl, uint8_t destination[], const uint32_t size);
+bool utils_circbuff_enqueue(const uint8_t source[], utils_circbuff_handle_t *const circbuff_hdl, const uint32_t size);
 bool utils_circbuff_full(utils_circbuff_handle_t const *const circbuff_hdl);
 bool utils_circbuff_empty(utils_circbuff_handle_t const *const circbuff_hdl);
-uint16_t utils_circbuff_size(utils_circbuff_handle_t const *const circbuff_hdl);
+uint32_t utils_circbuff_size(utils_circbuff_handle_t const *const circbuff_hdl);
+uint32_t utils_circbuff_free(utils_circbuff_handle_t const *const circbuff_hdl);
+
+/* zero-copy access: acquire a contiguous span, fill or read it in place, then commit or release it */
+uint32_t utils_circbuff_write_acquire(utils_circbuff_handle_t *const circbuff_hdl, uint8_t **const pp_span);
+void utils_circbuff_write_commit(utils_circbuff_handle_t *const circbuff_hdl, const uint32_t size);
+uint32_t utils_circbuff_read_acquire(utils_circbuff_handle_t *const circbuff_hdl, const uint8_t **const pp_span);
+void utils_circbuff_read_release(utils_circbuff_handle_t *const circbuff_hdl, const uint32_t size);
 /* NO MORE DEFINITIONS */
 
 /*** Definitions of functions ************************************************/
 /* NO MORE DEFINITIONS */
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,282 @@
+/*
+******************************************************************************
+* @file: weld_time.c
+* @author:
+* @brief: Weld time counter, kept in the EEPROM of the torch.
+*         The arc-on time is accumulated in RAM and saved as a log of records
+*         in the rows of EEPROM page 2, each save goes to the next row. A
+*         record carries a sequence number and a CRC16, so an interrupted
+*         write leaves the previous record valid and the newest valid record
+*         is found in one pass at boot.
+******************************************************************************
+*
+******************************************************************************
+*/
+
+/*** Include *****************************************************************/
+#include <stddef.h>
+#include <string.h>
+
+#include "weld_time.h"
+#include "inout.h"
+#include "DS2484.h"
+#include "DS2431.h"
+#include "TestBoard.h"
+/* NO MORE DEFINITIONS */
+
+/*** Preprocessor definitions ************************************************/
+#define WELD_TIME_ROWS    ROWS_PER_PAGE  // one record per row of page 2
+#define WELD_TIME_ADDRESS BYTES_PER_PAGE // EEPROM address of page 2
+
+#define WELD_TIME_COMMIT_INTERVAL 600000 // ms, arc-on time is saved at least this often while welding
+#define WELD_TIME_ARC_OFF_MIN     60000  // ms, minimum time between two saves after arc off
+
+/*** Definition of variables *************************************************/
+
+/* record of the weld time log, has to be an EEPROM row without padding */
+typedef struct {
+    uint32_t seconds; // accumulated arc-on time in s
+    uint16_t seq;     // sequence number, the valid record with the highest one is the newest
+    uint16_t crc;     // inverted CRC16 of all bytes before
+} weld_time_record_t;
+
+extern owParamPage2 st_OwParamPage2;
+
+/* newest record in the EEPROM, WELD_TIME_ROWS if there is none */
+static uint8_t weld_time_row = WELD_TIME_ROWS;
+static uint16_t weld_time_seq = 0;
+static uint32_t weld_time_stored = 0;
+static uint8_t b_weld_time_restored = 0;
+
+/* arc-on time not saved yet */
+static uint32_t weld_time_ms = 0;
+static uint32_t weld_time_tick = 0;
+static uint32_t weld_time_commit_tick = 0;
+static uint8_t b_weld_time_arc = 0;
+
+/* record being saved, its row and the result of the running 1-Wire transaction */
+static weld_time_record_t weld_time_writing;
+static uint8_t weld_time_write_row;
+static uint8_t b_weld_time_writing = 0;
+static uint8_t b_weld_time_row_started = 0;
+static volatile HAL_StatusTypeDef weld_time_ow_status = HAL_OK;
+
+/*** Prototypes of functions *************************************************/
+static uint8_t weld_time_arc_on(void);
+static uint8_t weld_time_valid(const weld_time_record_t *p_record);
+static void weld_time_write(uint32_t tick);
+static void weld_time_ow_done(HAL_StatusTypeDef status);
+
+/*** Definitions of functions ************************************************/
+
+/**********************************************************
+ ** Name            : weld_time_restore
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Takes over the newest valid record of the weld time
+ **                   log from the page content, the counter runs only
+ **                   after it was restored
+ **
+ ** Calling         : boot_process, after the EEPROM pages were read
+ **
+ ** InputValues     : void
+ ** OutputValues    : void
+ **********************************************************/
+void weld_time_restore(void) {
+    weld_time_record_t record;
+
+    weld_time_row = WELD_TIME_ROWS;
+    for (uint8_t row = 0; row < WELD_TIME_ROWS; row++) {
+        memcpy(&record, (const uint8_t *)&st_OwParamPage2 + (row * BYTES_PER_ROW), sizeof(record));
+        if (!weld_time_valid(&record)) {
+            continue;
+        }
+        /* the sequence number may wrap around */
+        if ((weld_time_row == WELD_TIME_ROWS) || ((int16_t)(record.seq - weld_time_seq) > 0)) {
+            weld_time_row = row;
+            weld_time_seq = record.seq;
+            weld_time_stored = record.seconds;
+        }
+    }
+    weld_time_tick = HAL_GetTick();
+    weld_time_commit_tick = weld_time_tick;
+    b_weld_time_restored = 1;
+}
+
+/**********************************************************
+ ** Name            : weld_time_process
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Accumulates the arc-on time and saves it. To limit
+ **                   the EEPROM wear, it is saved every
+ **                   WELD_TIME_COMMIT_INTERVAL while welding and after arc
+ **                   off, at most every WELD_TIME_ARC_OFF_MIN. The record
+ **                   is written by asynchronous row writes.
+ **
+ ** Calling         : main loop
+ **
+ ** InputValues     : void
+ ** OutputValues    : void
+ **********************************************************/
+void weld_time_process(void) {
+    uint32_t tick = HAL_GetTick();
+    uint32_t interval;
+
+    if (!b_weld_time_restored) {
+        return;
+    }
+
+    if (b_weld_time_arc) {
+        weld_time_ms += tick - weld_time_tick;
+    }
+    weld_time_tick = tick;
+    b_weld_time_arc = weld_time_arc_on();
+
+    /* save in progress */
+    if (b_weld_time_writing) {
+        weld_time_write(tick);
+        return;
+    }
+
+    interval = b_weld_time_arc ? WELD_TIME_COMMIT_INTERVAL : WELD_TIME_ARC_OFF_MIN;
+    if ((weld_time_ms < 1000) || ((tick - weld_time_commit_tick) < interval)) {
+        return;
+    }
+
+    weld_time_writing.seconds = weld_time_stored + (weld_time_ms / 1000);
+    weld_time_writing.seq = weld_time_seq + 1;
+    weld_time_writing.crc = ~ow_crc16_ds2431(0, (const uint8_t *)&weld_time_writing, offsetof(weld_time_record_t, crc));
+    weld_time_write_row = (weld_time_row + 1) % WELD_TIME_ROWS;
+    b_weld_time_writing = 1;
+    b_weld_time_row_started = 0;
+    weld_time_write(tick);
+}
+
+/**********************************************************
+ ** Name            : weld_time_get
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Gets the weld time of the torch
+ **
+ ** Calling         : application
+ **
+ ** InputValues     : void
+ ** OutputValues    : uint32_t. Arc-on time in s, including the time not
+ **                   saved yet
+ **********************************************************/
+uint32_t weld_time_get(void) {
+    return weld_time_stored + (weld_time_ms / 1000);
+}
+
+/**********************************************************
+ ** Name            : weld_time_arc_on
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Gets the welding state. The machine does not send
+ **                   the arc state, the torch switch is taken instead,
+ **                   except during the test mode.
+ **
+ ** Calling         : weld_time_process
+ **
+ ** InputValues     : void
+ ** OutputValues    : uint8_t. 1=Arc on. 0=Arc off
+ **********************************************************/
+static uint8_t weld_time_arc_on(void) {
+    uint16_t inputs;
+
+    if (Get_TestMode()) {
+        return 0;
+    }
+    inout_get_inputs(&inputs);
+    return (inputs & INOUT_TORCH_SWITCH) ? 1 : 0;
+}
+
+/**********************************************************
+ ** Name            : weld_time_valid
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Checks the CRC16 of a record. Cleared rows (0x00) and
+ **                   erased rows (0xFF) are never valid.
+ **
+ ** Calling         : weld_time_restore
+ **
+ ** InputValues     : record
+ ** OutputValues    : uint8_t. 1=Valid. 0=Invalid
+ **********************************************************/
+static uint8_t weld_time_valid(const weld_time_record_t *p_record) {
+    uint16_t crc = ~ow_crc16_ds2431(0, (const uint8_t *)p_record, offsetof(weld_time_record_t, crc));
+
+    return (p_record->crc == crc) ? 1 : 0;
+}
+
+/**********************************************************
+ ** Name            : weld_time_write
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Continues saving the record, it is placed in the
+ **                   page content and the row is written by an
+ **                   asynchronous 1-Wire transaction. After a failure the
+ **                   next save goes to the same row again.
+ **
+ ** Calling         : weld_time_process
+ **
+ ** InputValues     : uint32_t tick
+ ** OutputValues    : void
+ **********************************************************/
+static void weld_time_write(uint32_t tick) {
+    uint16_t row_mask = OW_ROW_MASK(WELD_TIME_ADDRESS + (weld_time_write_row * BYTES_PER_ROW));
+
+    if (b_weld_time_row_started) {
+        if (weld_time_ow_status == HAL_BUSY) {
+            return;
+        }
+        b_weld_time_row_started = 0;
+        if (weld_time_ow_status != HAL_OK) {
+            /* time stays accumulated, retried after the interval */
+            weld_time_commit_tick = tick;
+            b_weld_time_writing = 0;
+            return;
+        }
+    }
+
+    /* copied with every call, a page read meanwhile would have replaced it */
+    memcpy((uint8_t *)&st_OwParamPage2 + (weld_time_write_row * BYTES_PER_ROW), &weld_time_writing,
+           sizeof(weld_time_writing));
+    if ((owParamPage_dirty_ds2431() & row_mask) == 0) {
+        weld_time_ms -= (weld_time_writing.seconds - weld_time_stored) * 1000;
+        weld_time_row = weld_time_write_row;
+        weld_time_seq = weld_time_writing.seq;
+        weld_time_stored = weld_time_writing.seconds;
+        weld_time_commit_tick = tick;
+        b_weld_time_writing = 0;
+        return;
+    }
+
+    weld_time_ow_status = HAL_BUSY;
+    if (owParamPage_flush_row_async_ds2431(row_mask, weld_time_ow_done) == HAL_OK) {
+        b_weld_time_row_started = 1;
+    }
+    /* otherwise the 1-Wire is in use, retried with the next call */
+}
+
+/**********************************************************
+ ** Name            : weld_time_ow_done
+ **
+ ** Created from/on : 18.10.2026
+ **
+ ** Description     : Takes over the result of a row write
+ **
+ ** Calling         : I2C interrupt
+ **
+ ** InputValues     : HAL_StatusTypeDef status
+ ** OutputValues    : void
+ **********************************************************/
+static void weld_time_ow_done(HAL_StatusTypeDef status) {
+    weld_time_ow_status = status;
+}
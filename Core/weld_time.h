@@ -0,0 +1,35 @@
+/*
+******************************************************************************
+* @file: weld_time.h
+* @author:
+* @brief: Weld time counter, kept in the EEPROM of the torch
+******************************************************************************
+*
+******************************************************************************
+*/
+
+#ifndef _WELD_TIME_H
+#define _WELD_TIME_H
+
+/*** Include *****************************************************************/
+#include "types.h"
+
+/* NO MORE DEFINITIONS */
+
+/*** Preprocessor definitions ************************************************/
+/* NO MORE DEFINITIONS */
+
+/*** Definition of variables *************************************************/
+/* NO MORE DEFINITIONS */
+
+/*** Prototypes of functions *************************************************/
+void weld_time_restore(void);
+void weld_time_process(void);
+uint32_t weld_time_get(void);
+
+/* NO MORE DEFINITIONS */
+
+/*** Definitions of functions ************************************************/
+/* NO MORE DEFINITIONS */
+
+#endif //_WELD_TIME_H
@@ -71,6 +71,7 @@
 #include <setjmp.h>
 
 // #include "ew_bsp_console.h"   //XXXX SysBrenner keine Konsole 
+#include "serial.h"                 // SysBrenner Konsole ueber UART Log-Ring
 // #include "ew_bsp_clock.h"     //XXXX SysBrenner keine RTC
 
 
@@ -205,16 +206,9 @@ void EwPanic( void )
 *******************************************************************************/
 void EwConsoleOutput( const char* aMessage )
 {
-#if 0 //XXXX SysBrenner kein EwConsoleOutput()
-	while( *aMessage )
-  {
-    /* add carriage return in case of newline */
-    if ( *aMessage == '\n' )
-      EwBspConsolePutCharacter( '\r' );
-
-    EwBspConsolePutCharacter( *aMessage++ );
-  }
-#endif //0 //XXXX SysBrenner kein EwConsoleOutput()
+  /* SysBrenner: trace output by the UART log ring of serial.c, carriage
+     return added in case of newline */
+  Serial_COM_PutConsole( aMessage );
 }
 
 
@@ -101,12 +101,178 @@ static struct XPendingSignal* PostSignals = 0;
 static struct XPendingSignal* IdleSignals = 0;
 
 
-/* The following variables store the origin of lists of registered observers.
-   New observers are added to the begin of the list by using the functions
-   EwAttachObjObserver() and EwAttachRefObserver(). */
-static struct XObserver* Observers    = 0; /* global observers   */
-static struct XObserver* ObjObservers = 0; /* object observers   */
-static struct XObserver* RefObservers = 0; /* reference observer */
+/* The registered observers are managed in hash tables. The bucket for an
+   observer is derived from the observed object, the property and the Id, so
+   all observers which are notified together are stored within the same
+   bucket. Within a bucket, the observers are managed in a single linked chain.
+   The number of buckets has to be a power of two. */
+#ifndef EW_OBSERVER_HASH_SIZE
+  #define EW_OBSERVER_HASH_SIZE 16
+#endif
+
+#define HASH_OBSERVER( aObject, aProperty, aId )                               \
+  (((((unsigned long)( aObject )) >> 3 ) ^                                     \
+    (((unsigned long)( aProperty )) >> 1 ) ^ (unsigned long)( aId ) ^          \
+    ((unsigned long)( aId ) >> 4 )) & ( EW_OBSERVER_HASH_SIZE - 1 ))
+
+
+/* The following variables store the origin of the chains of registered
+   observers. New observers are added to the begin of the chain within the
+   bucket by using the functions EwAttachObjObserver(), EwAttachRefObserver()
+   and EwAttachObserver(). */
+static struct XObserver* Observers   [ EW_OBSERVER_HASH_SIZE ]; /* global observers   */
+static struct XObserver* ObjObservers[ EW_OBSERVER_HASH_SIZE ]; /* object observers   */
+static struct XObserver* RefObservers[ EW_OBSERVER_HASH_SIZE ]; /* reference observer */
+
+
+/* If not configured, no static pools are used for signals and observers. */
+#ifndef EW_SIGNAL_POOL_SIZE
+  #define EW_SIGNAL_POOL_SIZE 0
+#endif
+
+#ifndef EW_OBSERVER_POOL_SIZE
+  #define EW_OBSERVER_POOL_SIZE 0
+#endif
+
+
+/* The following variables implement fixed-capacity pools for XPendingSignal
+   and XObserver structures. Entries are taken from the pool in sequence until
+   it is exhausted. Released entries are chained in a free list and reused in
+   the first place. In this manner, the posting of signals and the registration
+   of observers does not cause any heap allocation in the steady state. */
+#if EW_SIGNAL_POOL_SIZE > 0
+  static struct XPendingSignal  SignalPool[ EW_SIGNAL_POOL_SIZE ];
+  static struct XPendingSignal* FreeSignals    = 0;
+  static int                    SignalPoolUsed = 0;
+#endif
+
+#if EW_OBSERVER_POOL_SIZE > 0
+  static struct XObserver  ObserverPool[ EW_OBSERVER_POOL_SIZE ];
+  static struct XObserver* FreeObservers    = 0;
+  static int               ObserverPoolUsed = 0;
+#endif
+
+
+/* This internal function returns a new XPendingSignal structure. The structure
+   is taken from the signal pool. Only if the pool is exhausted, the memory is
+   allocated from the heap. If there is no memory available, 0 is returned. */
+static struct XPendingSignal* NewSignal( void )
+{
+  struct XPendingSignal* signal;
+
+  #if EW_SIGNAL_POOL_SIZE > 0
+    /* Reuse a previously released entry ... */
+    if ( FreeSignals )
+    {
+      signal      = FreeSignals;
+      FreeSignals = signal->Next;
+      return signal;
+    }
+
+    /* ... or take the next never used entry */
+    if ( SignalPoolUsed < EW_SIGNAL_POOL_SIZE )
+      return &SignalPool[ SignalPoolUsed++ ];
+  #endif
+
+  /* The pool is exhausted - use the heap */
+  if (( signal = EwAlloc( sizeof( struct XPendingSignal ))) == 0 )
+    return 0;
+
+  /* Track the RAM usage */
+  EwObjectsMemory += sizeof( struct XPendingSignal );
+
+  /* Also track the max. memory pressure */
+  if ( EwObjectsMemory > EwObjectsMemoryPeak )
+    EwObjectsMemoryPeak = EwObjectsMemory;
+
+  if (( EwObjectsMemory + EwStringsMemory + EwResourcesMemory ) > EwMemoryPeak )
+    EwMemoryPeak = EwObjectsMemory + EwStringsMemory + EwResourcesMemory;
+
+  return signal;
+}
+
+
+/* This internal function releases the XPendingSignal structure aSignal. If the
+   structure belongs to the signal pool, it is returned to the free list of the
+   pool. Otherwise its memory is returned to the heap. */
+static void FreeSignal( struct XPendingSignal* aSignal )
+{
+  #if EW_SIGNAL_POOL_SIZE > 0
+    if (( aSignal >= SignalPool ) &&
+        ( aSignal <  SignalPool + EW_SIGNAL_POOL_SIZE ))
+    {
+      aSignal->Next = FreeSignals;
+      FreeSignals   = aSignal;
+      return;
+    }
+  #endif
+
+  /* Track the RAM usage */
+  EwObjectsMemory -= sizeof( struct XPendingSignal );
+
+  EwFree( aSignal );
+}
+
+
+/* This internal function returns a new XObserver structure. The structure is
+   taken from the observer pool. Only if the pool is exhausted, the memory is
+   allocated from the heap. If there is no memory available, 0 is returned. */
+static struct XObserver* NewObserver( void )
+{
+  struct XObserver* obs;
+
+  #if EW_OBSERVER_POOL_SIZE > 0
+    /* Reuse a previously released entry ... */
+    if ( FreeObservers )
+    {
+      obs           = FreeObservers;
+      FreeObservers = obs->Next;
+      return obs;
+    }
+
+    /* ... or take the next never used entry */
+    if ( ObserverPoolUsed < EW_OBSERVER_POOL_SIZE )
+      return &ObserverPool[ ObserverPoolUsed++ ];
+  #endif
+
+  /* The pool is exhausted - use the heap */
+  if (( obs = EwAlloc( sizeof( struct XObserver ))) == 0 )
+    return 0;
+
+  /* Track the RAM usage */
+  EwObjectsMemory += sizeof( struct XObserver );
+
+  /* Also track the max. memory pressure */
+  if ( EwObjectsMemory > EwObjectsMemoryPeak )
+    EwObjectsMemoryPeak = EwObjectsMemory;
+
+  if (( EwObjectsMemory + EwStringsMemory + EwResourcesMemory ) > EwMemoryPeak )
+    EwMemoryPeak = EwObjectsMemory + EwStringsMemory + EwResourcesMemory;
+
+  return obs;
+}
+
+
+/* This internal function releases the XObserver structure aObserver. If the
+   structure belongs to the observer pool, it is returned to the free list of
+   the pool. Otherwise its memory is returned to the heap. */
+static void FreeObserver( struct XObserver* aObserver )
+{
+  #if EW_OBSERVER_POOL_SIZE > 0
+    if (( aObserver >= ObserverPool ) &&
+        ( aObserver <  ObserverPool + EW_OBSERVER_POOL_SIZE ))
+    {
+      aObserver->Next = FreeObservers;
+      FreeObservers   = aObserver;
+      return;
+    }
+  #endif
+
+  /* Track the RAM usage */
+  EwObjectsMemory -= sizeof( struct XObserver );
+
+  EwFree( aObserver );
+}
 
 
 /* This internal function is called, when a new signal aSlot should be stored
@@ -152,7 +318,7 @@ static int AddSignal( struct XPendingSignal** aList, XSlot aSlot,
        cleared. Thus for the later list append operation we need to start at the
        begin of the list again. */
     do
-      if (( signal = EwAlloc( sizeof( struct XPendingSignal ))) == 0 )
+      if (( signal = NewSignal()) == 0 )
         aList = list;
     while ( !signal && EwImmediateReclaimMemory( 4 ));
 
@@ -167,16 +333,6 @@ static int AddSignal( struct XPendingSignal** aList, XSlot aSlot,
     signal->Next      = 0;
     signal->Processed = 0;
     signal->Slot      = aSlot;
-
-    /* Track the RAM usage */
-    EwObjectsMemory += sizeof( struct XPendingSignal );
-
-    /* Also track the max. memory pressure */
-    if ( EwObjectsMemory > EwObjectsMemoryPeak )
-      EwObjectsMemoryPeak = EwObjectsMemory;
-
-    if (( EwObjectsMemory + EwStringsMemory + EwResourcesMemory ) > EwMemoryPeak )
-      EwMemoryPeak = EwObjectsMemory + EwStringsMemory + EwResourcesMemory;
   }
 
   /* Step2: Look for the end of the list and ... */
@@ -214,11 +370,8 @@ static void ProcessSignals( struct XPendingSignal** aList )
     /* Skip to the next signal ... */
     *aList = (*aList)->Next;
 
-    /* Track the RAM usage */
-    EwObjectsMemory -= sizeof( struct XPendingSignal );
-
     /* ... and remove the processed signal now */
-    EwFree( signal );
+    FreeSignal( signal );
   }
 }
 
@@ -235,42 +388,43 @@ static void ClearSignals( struct XPendingSignal** aList )
     /* ... continue with the next signal */
     *aList = (*aList)->Next;
 
-    /* Track the RAM usage */
-    EwObjectsMemory -= sizeof( struct XPendingSignal );
-
     /* Remove the currenty signal */
-    EwFree( signal );
+    FreeSignal( signal );
   }
 }
 
 
-/* This function removes all unused observers from the given list. */
-static void DisposeObservers( struct XObserver** aList )
+/* This function removes all unused observers from the given hash table. */
+static void DisposeObservers( struct XObserver** aTable )
 {
-  struct XObserver** obs = aList;
+  struct XObserver** obs;
   struct XObserver*  tmp;
+  int                i;
 
-  /* Look for observers, which are attached to unused objects */
-  while ( *obs )
+  /* Repeat for all buckets of the hash table */
+  for ( i = 0; i < EW_OBSERVER_HASH_SIZE; i++ )
   {
-    /* Verify, wheter the affected objects has been marked by the Garbage
-       Collector - If not, remove the observer */
-    if (
-         !((XObject)((*obs)->Slot.Object ))->_.Mark ||
-         ((*obs)->Object && !(*obs)->Object->_.Mark )
-       )
-    {
-      /* Track the RAM usage */
-      EwObjectsMemory -= sizeof( struct XObserver );
-
-      tmp  = *obs;
-      *obs = tmp->Next;
-      EwFree( tmp );
-    }  
+    obs = &aTable[i];
 
-    /* Continue with the next observer in the chain */
-    else
-      obs = &((*obs)->Next );
+    /* Look for observers, which are attached to unused objects */
+    while ( *obs )
+    {
+      /* Verify, wheter the affected objects has been marked by the Garbage
+         Collector - If not, remove the observer */
+      if (
+           !((XObject)((*obs)->Slot.Object ))->_.Mark ||
+           ((*obs)->Object && !(*obs)->Object->_.Mark )
+         )
+      {
+        tmp  = *obs;
+        *obs = tmp->Next;
+        FreeObserver( tmp );
+      }  
+
+      /* Continue with the next observer in the chain */
+      else
+        obs = &((*obs)->Next );
+    }
   }
 }
 
@@ -294,12 +448,9 @@ static void DisposeSignals( struct XPendingSignal** aList )
          !(*sig)->Processed
        )
     {
-      /* Track the RAM usage */
-      EwObjectsMemory -= sizeof( struct XPendingSignal );
-
       tmp  = *sig;
       *sig = tmp->Next;
-      EwFree( tmp );
+      FreeSignal( tmp );
     }  
 
     /* Continue with the next signal in the chain */
@@ -364,9 +515,9 @@ void EwDiscardSignals( void )
 /* Removes unused observers */
 void EwDisposeObservers( void )
 {
-  DisposeObservers( &Observers    );
-  DisposeObservers( &ObjObservers );
-  DisposeObservers( &RefObservers );
+  DisposeObservers( Observers    );
+  DisposeObservers( ObjObservers );
+  DisposeObservers( RefObservers );
 }
 
 
@@ -621,12 +772,17 @@ int EwAnyPendingSignals( void )
 *******************************************************************************/
 int EwAttachObjObserver( XSlot aSlot, XObject aObject, XUInt32 aId )
 {
-  struct XObserver* obs = ObjObservers;
+  struct XObserver** bucket;
+  struct XObserver*  obs;
 
   /* No observer to register */
   if ( !aSlot.Object || !aObject )
     return 0;
 
+  /* Only the bucket for the given object and id needs to be evaluated */
+  bucket = &ObjObservers[ HASH_OBSERVER( aObject, 0, aId )];
+  obs    = *bucket;
+
   /* Ensure, that the observer is not registered yet */
   while ( obs && 
           (
@@ -645,7 +801,7 @@ int EwAttachObjObserver( XSlot aSlot, XObject aObject, XUInt32 aId )
 
   /* Ok, the observer is not registered. Create a new XObserver */
   do
-    obs = EwAlloc( sizeof( struct XObserver ));
+    obs = NewObserver();
   while ( !obs && EwImmediateReclaimMemory( 5 ));
 
   /* Out of memory? */
@@ -661,18 +817,8 @@ int EwAttachObjObserver( XSlot aSlot, XObject aObject, XUInt32 aId )
   obs->Object   = aObject;
   obs->Property = 0;
   obs->Id       = aId;
-  obs->Next     = ObjObservers;
-  ObjObservers  = obs;
-
-  /* Track the RAM usage */
-  EwObjectsMemory += sizeof( struct XObserver );
-
-  /* Also track the max. memory pressure */
-  if ( EwObjectsMemory > EwObjectsMemoryPeak )
-    EwObjectsMemoryPeak = EwObjectsMemory;
-
-  if (( EwObjectsMemory + EwStringsMemory + EwResourcesMemory ) > EwMemoryPeak )
-    EwMemoryPeak = EwObjectsMemory + EwStringsMemory + EwResourcesMemory;
+  obs->Next     = *bucket;
+  *bucket       = obs;
 
   return 1;
 }
@@ -711,12 +857,17 @@ int EwAttachObjObserver( XSlot aSlot, XObject aObject, XUInt32 aId )
 *******************************************************************************/
 int EwAttachRefObserver( XSlot aSlot, XRef aRef, XUInt32 aId )
 {
-  struct XObserver* obs = RefObservers;
+  struct XObserver** bucket;
+  struct XObserver*  obs;
 
   /* No observer to register */
   if ( !aSlot.Object || !aRef.Object )
     return 0;
 
+  /* Only the bucket for the given property and id needs to be evaluated */
+  bucket = &RefObservers[ HASH_OBSERVER( aRef.Object, aRef.OnGet, aId )];
+  obs    = *bucket;
+
   /* Ensure, that the observer is not registered yet */
   while ( obs && 
           (
@@ -735,7 +886,7 @@ int EwAttachRefObserver( XSlot aSlot, XRef aRef, XUInt32 aId )
 
   /* Ok, the observer is not registered. Create a new XObserver */
   do
-    obs = EwAlloc( sizeof( struct XObserver ));
+    obs = NewObserver();
   while ( !obs && EwImmediateReclaimMemory( 6 ));
 
   /* Out of memory? */
@@ -751,18 +902,8 @@ int EwAttachRefObserver( XSlot aSlot, XRef aRef, XUInt32 aId )
   obs->Object   = aRef.Object;
   obs->Property = aRef.OnGet;
   obs->Id       = aId;
-  obs->Next     = RefObservers;
-  RefObservers  = obs;
-
-  /* Track the RAM usage */
-  EwObjectsMemory += sizeof( struct XObserver );
-
-  /* Also track the max. memory pressure */
-  if ( EwObjectsMemory > EwObjectsMemoryPeak )
-    EwObjectsMemoryPeak = EwObjectsMemory;
-
-  if (( EwObjectsMemory + EwStringsMemory + EwResourcesMemory ) > EwMemoryPeak )
-    EwMemoryPeak = EwObjectsMemory + EwStringsMemory + EwResourcesMemory;
+  obs->Next     = *bucket;
+  *bucket       = obs;
 
   return 1;
 }
@@ -797,12 +938,17 @@ int EwAttachRefObserver( XSlot aSlot, XRef aRef, XUInt32 aId )
 *******************************************************************************/
 int EwAttachObserver( XSlot aSlot, XUInt32 aId )
 {
-  struct XObserver* obs = Observers;
+  struct XObserver** bucket;
+  struct XObserver*  obs;
 
   /* No observer to register */
   if ( !aSlot.Object )
     return 0;
 
+  /* Only the bucket for the given id needs to be evaluated */
+  bucket = &Observers[ HASH_OBSERVER( 0, 0, aId )];
+  obs    = *bucket;
+
   /* Ensure, that the observer is not registered yet */
   while ( obs && 
           (
@@ -821,7 +967,7 @@ int EwAttachObserver( XSlot aSlot, XUInt32 aId )
 
   /* Ok, the observer is not registered. Create a new XObserver */
   do
-    obs = EwAlloc( sizeof( struct XObserver ));
+    obs = NewObserver();
   while ( !obs && EwImmediateReclaimMemory( 7 ));
 
   /* Out of memory? */
@@ -837,18 +983,8 @@ int EwAttachObserver( XSlot aSlot, XUInt32 aId )
   obs->Object   = 0;
   obs->Property = 0;
   obs->Id       = aId;
-  obs->Next     = Observers;
-  Observers     = obs;
-
-  /* Track the RAM usage */
-  EwObjectsMemory += sizeof( struct XObserver );
-
-  /* Also track the max. memory pressure */
-  if ( EwObjectsMemory > EwObjectsMemoryPeak )
-    EwObjectsMemoryPeak = EwObjectsMemory;
-
-  if (( EwObjectsMemory + EwStringsMemory + EwResourcesMemory ) > EwMemoryPeak )
-    EwMemoryPeak = EwObjectsMemory + EwStringsMemory + EwResourcesMemory;
+  obs->Next     = *bucket;
+  *bucket       = obs;
 
   return 1;
 }
@@ -883,13 +1019,16 @@ int EwAttachObserver( XSlot aSlot, XUInt32 aId )
 *******************************************************************************/
 int EwDetachObjObserver( XSlot aSlot, XObject aObject, XUInt32 aId )
 {
-  struct XObserver** obs = &ObjObservers;
+  struct XObserver** obs;
   struct XObserver*  tmp;
 
   /* No observer to deregister */
   if ( !aSlot.Object || !aObject )
     return 0;
 
+  /* Only the bucket for the given object and id needs to be evaluated */
+  obs = &ObjObservers[ HASH_OBSERVER( aObject, 0, aId )];
+
   /* Search in the chain for the affected observer */
   while ( *obs && 
           (
@@ -910,11 +1049,8 @@ int EwDetachObjObserver( XSlot aSlot, XObject aObject, XUInt32 aId )
   tmp  = *obs;
   *obs = tmp->Next;
 
-  /* Track the RAM usage */
-  EwObjectsMemory -= sizeof( struct XObserver );
-
-  /* ... then free the memory occupied by the XObserver structure */
-  EwFree( tmp );
+  /* ... then release the XObserver structure */
+  FreeObserver( tmp );
 
   return 1;
 }
@@ -950,13 +1086,16 @@ int EwDetachObjObserver( XSlot aSlot, XObject aObject, XUInt32 aId )
 *******************************************************************************/
 int EwDetachRefObserver( XSlot aSlot, XRef aRef, XUInt32 aId )
 {
-  struct XObserver** obs = &RefObservers;
+  struct XObserver** obs;
   struct XObserver*  tmp;
 
   /* No observer to deregister */
   if ( !aSlot.Object || !aRef.Object )
     return 0;
 
+  /* Only the bucket for the given property and id needs to be evaluated */
+  obs = &RefObservers[ HASH_OBSERVER( aRef.Object, aRef.OnGet, aId )];
+
   /* Search in the chain for the affected observer */
   while ( *obs && 
           (
@@ -977,11 +1116,8 @@ int EwDetachRefObserver( XSlot aSlot, XRef aRef, XUInt32 aId )
   tmp  = *obs;
   *obs = tmp->Next;
 
-  /* Track the RAM usage */
-  EwObjectsMemory -= sizeof( struct XObserver );
-
-  /* ... then free the memory occupied by the XObserver structure */
-  EwFree( tmp );
+  /* ... then release the XObserver structure */
+  FreeObserver( tmp );
 
   return 1;
 }
@@ -1013,13 +1149,16 @@ int EwDetachRefObserver( XSlot aSlot, XRef aRef, XUInt32 aId )
 *******************************************************************************/
 int EwDetachObserver( XSlot aSlot, XUInt32 aId )
 {
-  struct XObserver** obs = &Observers;
+  struct XObserver** obs;
   struct XObserver*  tmp;
 
   /* No observer to deregister */
   if ( !aSlot.Object )
     return 0;
 
+  /* Only the bucket for the given id needs to be evaluated */
+  obs = &Observers[ HASH_OBSERVER( 0, 0, aId )];
+
   /* Search in the chain for the affected observer */
   while ( *obs && 
           (
@@ -1040,11 +1179,8 @@ int EwDetachObserver( XSlot aSlot, XUInt32 aId )
   tmp  = *obs;
   *obs = tmp->Next;
 
-  /* Track the RAM usage */
-  EwObjectsMemory -= sizeof( struct XObserver );
-
-  /* ... then free the memory occupied by the XObserver structure */
-  EwFree( tmp );
+  /* ... then release the XObserver structure */
+  FreeObserver( tmp );
 
   return 1;
 }
@@ -1075,13 +1211,16 @@ int EwDetachObserver( XSlot aSlot, XUInt32 aId )
 *******************************************************************************/
 void EwNotifyObjObservers( XObject aObject, XUInt32 aId )
 {
-  struct XObserver* obs = ObjObservers;
+  struct XObserver* obs;
 
   /* Nothing to do */
   if ( !aObject )
     return;
 
-  /* Look for observers registered with the given object and id */
+  /* Look for observers registered with the given object and id - all of them
+     are stored within the same bucket */
+  obs = ObjObservers[ HASH_OBSERVER( aObject, 0, aId )];
+
   while ( obs )
   {
     /* If the condition is fulfilled, the observer should receive a signal */
@@ -1123,12 +1262,15 @@ void EwNotifyObjObservers( XObject aObject, XUInt32 aId )
 *******************************************************************************/
 void EwNotifyRefObservers( XRef aRef, XUInt32 aId )
 {
-  struct XObserver* obs = RefObservers;
+  struct XObserver* obs;
 
   if ( !aRef.Object )
     return;
 
-  /* Look for observers registered with the given property and id */
+  /* Look for observers registered with the given property and id - all of
+     them are stored within the same bucket */
+  obs = RefObservers[ HASH_OBSERVER( aRef.Object, aRef.OnGet, aId )];
+
   while ( obs )
   {
     /* If the condition is fulfilled, the observer should receive a signal */
@@ -1167,9 +1309,9 @@ void EwNotifyRefObservers( XRef aRef, XUInt32 aId )
 *******************************************************************************/
 void EwNotifyObservers( XUInt32 aId )
 {
-  struct XObserver* obs = Observers;
+  struct XObserver* obs = Observers[ HASH_OBSERVER( 0, 0, aId )];
 
-  /* Look for observers registered with the given object and id */
+  /* Look for observers registered with the given id */
   while ( obs )
   {
     /* If the condition is fulfilled, the observer should receive a signal */
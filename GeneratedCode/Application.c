@@ -414,19 +414,22 @@ void ApplicationParamDialog_onParamCounter( ApplicationParamDialog _this, XObjec
 /* 'C' function for method : 'Application::ParamDialog.OnUpdate()' */
 void ApplicationParamDialog_OnUpdate( ApplicationParamDialog _this, XObject sender )
 {
+  XBool showValue;
+  XBool showQA;
+  XBool showTest;
+
   /* Dummy expressions to avoid the 'C' warning 'unused argument'. */
   EW_UNUSED_ARG( sender );
 
-  CoreGroup_OnSetVisible((CoreGroup)&_this->ParamToggle, 0 );
-  CoreGroup_OnSetVisible((CoreGroup)&_this->ParamValue, 0 );
-  CoreGroup_OnSetVisible((CoreGroup)&_this->ParamQA, 0 );
-  CoreGroup_OnSetVisible((CoreGroup)&_this->TestDialog, 0 );
+  showValue = 0;
+  showQA = 0;
+  showTest = 0;
   ApplicationScrollbar_OnSetMaximum( &_this->ParamQA.Scrollbar, EwGetAutoObject( 
   &ParameterActiveParameter, ParameterParameter )->totalparams );
 
   if ( EwGetAutoObject( &ParameterActiveParameter, ParameterParameter )->Id == 0 )
   {
-    CoreGroup_OnSetVisible((CoreGroup)&_this->ParamQA, 1 );
+    showQA = 1;
     ViewsImage_OnSetFrameNumber( &_this->ParamQA.Image, 14 );
     ApplicationScrollbar_OnSetSelected( &_this->ParamQA.Scrollbar, _this->ParamValue.Scrollbar.Maximum );
   }
@@ -434,7 +437,7 @@ void ApplicationParamDialog_OnUpdate( ApplicationParamDialog _this, XObject send
     if ( EwGetAutoObject( &ParameterActiveParameter, ParameterParameter )->type 
         >= 100 )
     {
-      CoreGroup_OnSetVisible((CoreGroup)&_this->ParamQA, 1 );
+      showQA = 1;
 
       if ( EwGetAutoObject( &ParameterActiveParameter, ParameterParameter )->type 
           == 100 )
@@ -468,7 +471,7 @@ void ApplicationParamDialog_OnUpdate( ApplicationParamDialog _this, XObject send
           == 84 ) && ( EwGetAutoObject( &ParameterActiveParameter, ParameterParameter )->unit_id 
           == 67 ))
       {
-        CoreGroup_OnSetVisible((CoreGroup)&_this->TestDialog, 1 );
+        showTest = 1;
 
         if ( !!( EwGetAutoObject( &ParameterActiveParameter, ParameterParameter )->type 
             & 1 ))
@@ -609,8 +612,12 @@ void ApplicationParamDialog_OnUpdate( ApplicationParamDialog _this, XObject send
           }
       }
       else
-        CoreGroup_OnSetVisible((CoreGroup)&_this->ParamValue, 1 );
+        showValue = 1;
 
+  CoreGroup_OnSetVisible((CoreGroup)&_this->ParamToggle, 0 );
+  CoreGroup_OnSetVisible((CoreGroup)&_this->ParamValue, showValue );
+  CoreGroup_OnSetVisible((CoreGroup)&_this->ParamQA, showQA );
+  CoreGroup_OnSetVisible((CoreGroup)&_this->TestDialog, showTest );
   return;
 }
 
@@ -152,6 +152,16 @@ void ParameterParameter_UpdateParameter( ParameterParameter _this, XUInt32 aID,
   XFloat aValue, XFloat aMax, XFloat aMin, XUInt8 aUnit, XUInt8 atype, XUInt8 aimage, 
   XUInt8 atext, XUInt8 atotalparams )
 {
+  XUInt8 oldId = _this->Id;
+  XFloat oldValue = _this->Value;
+  XFloat oldMax = _this->Max;
+  XFloat oldMin = _this->Min;
+  XUInt8 oldUnit = _this->unit_id;
+  XUInt8 oldType = _this->type;
+  XUInt8 oldImage = _this->image;
+  XUInt8 oldText = _this->text;
+  XUInt8 oldTotalParams = _this->totalparams;
+
   _this->Id = (XUInt8)aID;
   _this->Value = aValue;
   _this->Max = aMax;
@@ -183,6 +193,13 @@ void ParameterParameter_UpdateParameter( ParameterParameter _this, XUInt32 aID,
       }
 
   ParameterParameter_CalcAdvanced( _this );
+
+  if ((((((((( _this->Id == oldId ) && ( _this->Value == oldValue )) && ( _this->Max 
+      == oldMax )) && ( _this->Min == oldMin )) && ( _this->unit_id == oldUnit )) 
+      && ( _this->type == oldType )) && ( _this->image == oldImage )) && ( _this->text 
+      == oldText )) && ( _this->totalparams == oldTotalParams ))
+    return;
+
   EwNotifyObjObservers((XObject)_this, 0 );
 }
 
@@ -0,0 +1,189 @@
+/******************************************************************************
+** @file circbuff_bench.c
+** @author
+** @brief Host benchmark of utils_circbuff against the former byte loop
+**        implementation, and a two thread producer/consumer check.
+**
+**        gcc -O2 -pthread -ICore tools/circbuff_bench.c Core/utils_circbuff.c -o circbuff_bench
+**        ./circbuff_bench
+******************************************************************************/
+
+/*** Include *****************************************************************/
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "utils_circbuff.h"
+/* NO MORE DEFINITIONS */
+
+/*** Preprocessor definitions ************************************************/
+#define BENCH_BUFFER_SIZE 2048u     // same as the UART log ring
+#define BENCH_BYTES       (64u << 20) // bytes moved per measurement
+#define BENCH_SPSC_BYTES  (16u << 20) // bytes moved by the thread check
+/* NO MORE DEFINITIONS */
+
+/*** Definition of variables *************************************************/
+// former implementation: one byte per loop, one slot kept free
+typedef struct {
+    uint8_t *buffer;
+    uint16_t head;
+    uint16_t tail;
+    uint16_t maxlen;
+} bytewise_handle_t;
+
+static uint8_t bench_buffer[BENCH_BUFFER_SIZE];
+static utils_circbuff_handle_t spsc_hdl;
+/* NO MORE DEFINITIONS */
+
+/*** Definitions of functions ************************************************/
+static bool bytewise_enqueue(const uint8_t source[], bytewise_handle_t *const hdl, const uint8_t size) {
+    for (uint8_t i = 0; i < size; i++) {
+        uint16_t next = hdl->head + 1;
+        if (next >= hdl->maxlen) {
+            next = 0;
+        }
+        if (next == hdl->tail) {
+            return false;
+        }
+        hdl->buffer[hdl->head] = source[i];
+        hdl->head = next;
+    }
+    return true;
+}
+
+static bool bytewise_dequeue(bytewise_handle_t *const hdl, uint8_t destination[], const uint8_t size) {
+    for (uint8_t i = 0; i < size; i++) {
+        uint16_t next;
+        if (hdl->head == hdl->tail) {
+            return false;
+        }
+        next = hdl->tail + 1;
+        if (next >= hdl->maxlen) {
+            next = 0;
+        }
+        destination[i] = hdl->buffer[hdl->tail];
+        hdl->tail = next;
+    }
+    return true;
+}
+
+static double bench_now(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static double bench_bytewise(uint32_t chunk) {
+    bytewise_handle_t hdl = {bench_buffer, 0, 0, BENCH_BUFFER_SIZE};
+    uint8_t data[256];
+    volatile uint8_t sink = 0;
+    double start = bench_now();
+
+    memset(data, 0x5A, sizeof(data));
+    for (uint32_t moved = 0; moved < BENCH_BYTES; moved += chunk) {
+        bytewise_enqueue(data, &hdl, (uint8_t)chunk);
+        bytewise_dequeue(&hdl, data, (uint8_t)chunk);
+        sink ^= data[0];
+    }
+    return bench_now() - start;
+}
+
+static double bench_bulk(uint32_t chunk) {
+    utils_circbuff_handle_t hdl;
+    uint8_t data[256];
+    volatile uint8_t sink = 0;
+    double start;
+
+    utils_circbuff_init(&hdl, bench_buffer, BENCH_BUFFER_SIZE);
+    memset(data, 0x5A, sizeof(data));
+    start = bench_now();
+    for (uint32_t moved = 0; moved < BENCH_BYTES; moved += chunk) {
+        utils_circbuff_enqueue(data, &hdl, chunk);
+        utils_circbuff_dequeue(&hdl, data, chunk);
+        sink ^= data[0];
+    }
+    return bench_now() - start;
+}
+
+static double bench_zero_copy(uint32_t chunk) {
+    utils_circbuff_handle_t hdl;
+    volatile uint8_t sink = 0;
+    double start;
+
+    utils_circbuff_init(&hdl, bench_buffer, BENCH_BUFFER_SIZE);
+    start = bench_now();
+    for (uint32_t moved = 0; moved < BENCH_BYTES; moved += chunk) {
+        uint8_t *p_write;
+        const uint8_t *p_read;
+        uint32_t span = utils_circbuff_write_acquire(&hdl, &p_write);
+
+        if (span > chunk) {
+            span = chunk;
+        }
+        memset(p_write, 0x5A, span);
+        utils_circbuff_write_commit(&hdl, span);
+        span = utils_circbuff_read_acquire(&hdl, &p_read);
+        sink ^= p_read[0];
+        utils_circbuff_read_release(&hdl, span);
+    }
+    return bench_now() - start;
+}
+
+static void *spsc_producer(void *p_arg) {
+    uint8_t data[61]; // odd size, so the copies wrap at every position
+    uint32_t seq = 0;
+
+    (void)p_arg;
+    while (seq < BENCH_SPSC_BYTES) {
+        for (uint32_t i = 0; i < sizeof(data); i++) {
+            data[i] = (uint8_t)(seq + i);
+        }
+        if (utils_circbuff_enqueue(data, &spsc_hdl, sizeof(data))) {
+            seq += sizeof(data);
+        }
+    }
+    return NULL;
+}
+
+static int spsc_check(void) {
+    pthread_t producer;
+    uint32_t seq = 0;
+    int errors = 0;
+
+    utils_circbuff_init(&spsc_hdl, bench_buffer, BENCH_BUFFER_SIZE);
+    pthread_create(&producer, NULL, spsc_producer, NULL);
+    while (seq < BENCH_SPSC_BYTES) {
+        const uint8_t *p_read;
+        uint32_t span = utils_circbuff_read_acquire(&spsc_hdl, &p_read);
+
+        for (uint32_t i = 0; i < span; i++) {
+            if (p_read[i] != (uint8_t)(seq + i)) {
+                errors++;
+            }
+        }
+        utils_circbuff_read_release(&spsc_hdl, span);
+        seq += span;
+    }
+    pthread_join(producer, NULL);
+    return errors;
+}
+
+int main(void) {
+    static const uint32_t chunks[] = {1, 8, 64, 255};
+    int errors;
+
+    printf("%-8s %14s %14s %14s\n", "chunk", "byte loop", "memcpy", "zero-copy");
+    for (uint32_t i = 0; i < sizeof(chunks) / sizeof(chunks[0]); i++) {
+        double mb = BENCH_BYTES / 1e6;
+
+        printf("%-8u %9.0f MB/s %9.0f MB/s %9.0f MB/s\n", chunks[i], mb / bench_bytewise(chunks[i]),
+               mb / bench_bulk(chunks[i]), mb / bench_zero_copy(chunks[i]));
+    }
+
+    errors = spsc_check();
+    printf("producer/consumer threads: %u bytes, %d errors\n", BENCH_SPSC_BYTES, errors);
+    return errors ? EXIT_FAILURE : EXIT_SUCCESS;
+}
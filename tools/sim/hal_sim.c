@@ -0,0 +1,300 @@
+/******************************************************************************
+** @file hal_sim.c
+** @author
+** @brief Host simulation: HAL time base, NVIC and I2C on a simulated clock.
+**        The I2C transfers go to the DS2484/DS2431 model, each transfer
+**        takes its duration on the bus and the interrupt transfers complete
+**        as simulated interrupts.
+******************************************************************************/
+
+/*** Include *****************************************************************/
+#include <string.h>
+
+#include "stm32g4xx_hal.h"
+#include "hal_sim.h"
+#include "ow_model.h"
+#include "trace.h"
+/* NO MORE DEFINITIONS */
+
+/*** Definition of variables *************************************************/
+typedef struct {
+    uint64_t due;
+    IRQn_Type irqn; // pending while disabled by the NVIC
+    sim_event_cb_t *p_cb;
+    void *p_arg;
+} sim_event_t;
+
+/* running interrupt transfer */
+typedef enum { E_SIM_I2C_TX, E_SIM_I2C_RX, E_SIM_I2C_MEM_RX } sim_i2c_kind_t;
+
+typedef struct {
+    sim_i2c_kind_t kind;
+    uint8_t address;
+    uint16_t mem_address;
+    uint8_t *p_data;
+    uint16_t size;
+} sim_i2c_t;
+
+uint32_t sim_primask;
+uint32_t SystemCoreClock = SIM_CORE_CLOCK_HZ;
+I2C_HandleTypeDef hi2cOneWire;
+
+static uint64_t sim_now_us;
+static sim_event_t sim_events[SIM_EVENTS_MAX];
+static sim_i2c_t sim_i2c;
+static uint32_t sim_i2c_it_count; // interrupt transfers, for the stall fault
+static uint8_t sim_irq_disabled[SIM_IRQ_N];
+static DWT_Type sim_dwt_regs;
+/* NO MORE DEFINITIONS */
+
+/*** Prototypes of functions *************************************************/
+static int sim_irq_masked(IRQn_Type irqn);
+/* NO MORE DEFINITIONS */
+
+/*** Definitions of functions ************************************************/
+/******************************************************************************
+** Name               : @fn sim_reset
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function restarts the simulated clock at 0 without pending interrupts and
+**                       resets the peripherals and initializes the I2C handle
+**                       of the DS2484.
+**
+** Calling            : @remark before each scenario
+**
+** InputValues        : @param none
+**
+** OutputValues       : @retval none
+******************************************************************************/
+void sim_reset(void) {
+    sim_now_us = 0;
+    sim_primask = 0;
+    sim_i2c_it_count = 0;
+    memset(sim_events, 0, sizeof(sim_events));
+    memset(sim_irq_disabled, 0, sizeof(sim_irq_disabled));
+    sim_periph_reset();
+    HAL_I2C_Init(&hi2cOneWire);
+}
+
+uint64_t sim_time_us(void) {
+    return sim_now_us;
+}
+
+/******************************************************************************
+** Name               : @fn sim_advance
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function advances the simulated time and runs the interrupts which become due,
+**                       in the order of their due time. Masked interrupts and interrupts disabled by the NVIC
+**                       wait for the next call.
+**
+** Calling            : @remark HAL_Delay, blocking transfers, main loop of the scenarios
+**
+** InputValues        : @param uint64_t us which is the time to advance
+**
+** OutputValues       : @retval none
+******************************************************************************/
+void sim_advance(uint64_t us) {
+    uint64_t target = sim_now_us + us;
+
+    for (;;) {
+        sim_event_t *p_next = NULL;
+        sim_event_t event;
+
+        for (uint8_t i = 0; (i < SIM_EVENTS_MAX) && !sim_primask; i++) {
+            if (sim_events[i].p_cb && (sim_events[i].due <= target) && !sim_irq_masked(sim_events[i].irqn) &&
+                (!p_next || (sim_events[i].due < p_next->due))) {
+                p_next = &sim_events[i];
+            }
+        }
+        if (!p_next) {
+            break;
+        }
+        event = *p_next;
+        p_next->p_cb = NULL;
+        if (event.due > sim_now_us) {
+            sim_now_us = event.due;
+        }
+        event.p_cb(event.p_arg);
+    }
+    sim_now_us = target;
+}
+
+int sim_event_add(uint64_t due_us, sim_event_cb_t *p_cb, void *p_arg) {
+    return sim_irq_add(due_us, SIM_IRQ_NONE, p_cb, p_arg);
+}
+
+int sim_irq_add(uint64_t due_us, IRQn_Type irqn, sim_event_cb_t *p_cb, void *p_arg) {
+    for (uint8_t i = 0; i < SIM_EVENTS_MAX; i++) {
+        if (!sim_events[i].p_cb) {
+            sim_events[i] = (sim_event_t){due_us, irqn, p_cb, p_arg};
+            return 0;
+        }
+    }
+    return -1;
+}
+
+void sim_event_cancel(sim_event_cb_t *p_cb, void *p_arg) {
+    for (uint8_t i = 0; i < SIM_EVENTS_MAX; i++) {
+        if ((sim_events[i].p_cb == p_cb) && (sim_events[i].p_arg == p_arg)) {
+            sim_events[i].p_cb = NULL;
+        }
+    }
+}
+
+uint32_t HAL_GetTick(void) {
+    return (uint32_t)(sim_now_us / 1000);
+}
+
+/* as the HAL: at least Delay + 1 ticks of the 1 ms time base */
+void HAL_Delay(uint32_t Delay) {
+    uint64_t start = HAL_GetTick();
+
+    sim_advance(((start + Delay + 1) * 1000) - sim_now_us);
+}
+
+DWT_Type *sim_dwt(void) {
+    sim_dwt_regs.CYCCNT = (uint32_t)(sim_now_us * (SystemCoreClock / 1000000U));
+    return &sim_dwt_regs;
+}
+
+/*** NVIC ********************************************************************/
+static int sim_irq_masked(IRQn_Type irqn) {
+    return (irqn > SIM_IRQ_NONE) && (irqn < SIM_IRQ_N) && sim_irq_disabled[irqn];
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority) {
+    (void)IRQn;
+    (void)PreemptPriority;
+    (void)SubPriority;
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn) {
+    if ((IRQn > SIM_IRQ_NONE) && (IRQn < SIM_IRQ_N)) {
+        sim_irq_disabled[IRQn] = 0;
+    }
+}
+
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn) {
+    if ((IRQn > SIM_IRQ_NONE) && (IRQn < SIM_IRQ_N)) {
+        sim_irq_disabled[IRQn] = 1;
+    }
+}
+
+uint32_t NVIC_GetEnableIRQ(IRQn_Type IRQn) {
+    return !sim_irq_masked(IRQn);
+}
+
+/*** I2C *********************************************************************/
+static int sim_i2c_run(const sim_i2c_t *p_i2c) {
+    switch (p_i2c->kind) {
+    case E_SIM_I2C_TX:
+        return ow_model_i2c_write(p_i2c->address, p_i2c->p_data, p_i2c->size);
+    case E_SIM_I2C_RX:
+        return ow_model_i2c_read(p_i2c->address, p_i2c->p_data, p_i2c->size);
+    default:
+        return ow_model_i2c_mem_read(p_i2c->address, p_i2c->mem_address, p_i2c->p_data, p_i2c->size);
+    }
+}
+
+static uint16_t sim_i2c_bytes(const sim_i2c_t *p_i2c) {
+    return (p_i2c->kind == E_SIM_I2C_MEM_RX) ? (1 + 2 + 1 + p_i2c->size) : (1 + p_i2c->size);
+}
+
+static void sim_i2c_done(void *p_arg) {
+    I2C_HandleTypeDef *hi2c = p_arg;
+
+    hi2c->State = HAL_I2C_STATE_READY;
+    if (sim_i2c_run(&sim_i2c) != 0) {
+        HAL_I2C_ErrorCallback(hi2c);
+    } else if (sim_i2c.kind == E_SIM_I2C_TX) {
+        HAL_I2C_MasterTxCpltCallback(hi2c);
+    } else if (sim_i2c.kind == E_SIM_I2C_RX) {
+        HAL_I2C_MasterRxCpltCallback(hi2c);
+    } else {
+        HAL_I2C_MemRxCpltCallback(hi2c);
+    }
+}
+
+/* the data is transferred at the end of the transfer time */
+static HAL_StatusTypeDef sim_i2c_blocking(I2C_HandleTypeDef *hi2c, const sim_i2c_t *p_i2c) {
+    if (hi2c->State != HAL_I2C_STATE_READY) {
+        return HAL_BUSY;
+    }
+    hi2c->State = HAL_I2C_STATE_BUSY;
+    sim_advance(ow_model_i2c_us(sim_i2c_bytes(p_i2c)));
+    hi2c->State = HAL_I2C_STATE_READY;
+    return (sim_i2c_run(p_i2c) == 0) ? HAL_OK : HAL_ERROR;
+}
+
+static HAL_StatusTypeDef sim_i2c_start_it(I2C_HandleTypeDef *hi2c, const sim_i2c_t *p_i2c) {
+    if (hi2c->State != HAL_I2C_STATE_READY) {
+        return HAL_BUSY;
+    }
+    hi2c->State = HAL_I2C_STATE_BUSY;
+    sim_i2c = *p_i2c;
+    if (++sim_i2c_it_count == ow_model_faults()->i2c_stall_at) {
+        return HAL_OK; // no interrupt ever comes, e.g. SDA held low
+    }
+    sim_event_add(sim_now_us + ow_model_i2c_us(sim_i2c_bytes(p_i2c)) + ow_model_timing()->i2c_irq_us, sim_i2c_done,
+                  hi2c);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c) {
+    hi2c->State = HAL_I2C_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef *hi2c) {
+    sim_event_cancel(sim_i2c_done, hi2c);
+    hi2c->State = HAL_I2C_STATE_RESET;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size,
+                                          uint32_t Timeout) {
+    (void)Timeout;
+    return sim_i2c_blocking(hi2c, &(sim_i2c_t){E_SIM_I2C_TX, (uint8_t)DevAddress, 0, pData, Size});
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size,
+                                         uint32_t Timeout) {
+    (void)Timeout;
+    return sim_i2c_blocking(hi2c, &(sim_i2c_t){E_SIM_I2C_RX, (uint8_t)DevAddress, 0, pData, Size});
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                   uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout) {
+    (void)MemAddSize;
+    (void)Timeout;
+    return sim_i2c_blocking(hi2c, &(sim_i2c_t){E_SIM_I2C_MEM_RX, (uint8_t)DevAddress, MemAddress, pData, Size});
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                             uint16_t Size) {
+    return sim_i2c_start_it(hi2c, &(sim_i2c_t){E_SIM_I2C_TX, (uint8_t)DevAddress, 0, pData, Size});
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                            uint16_t Size) {
+    return sim_i2c_start_it(hi2c, &(sim_i2c_t){E_SIM_I2C_RX, (uint8_t)DevAddress, 0, pData, Size});
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                      uint16_t MemAddSize, uint8_t *pData, uint16_t Size) {
+    (void)MemAddSize;
+    return sim_i2c_start_it(hi2c, &(sim_i2c_t){E_SIM_I2C_MEM_RX, (uint8_t)DevAddress, MemAddress, pData, Size});
+}
+
+/*** Firmware services without simulation ************************************/
+void trace_write(trace_id_t id, uint32_t n, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3) {
+    (void)id;
+    (void)n;
+    (void)a0;
+    (void)a1;
+    (void)a2;
+    (void)a3;
+}
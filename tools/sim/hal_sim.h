@@ -0,0 +1,65 @@
+/******************************************************************************
+** @file hal_sim.h
+** @author
+** @brief Host simulation: simulated clock and interrupts of the HAL.
+**
+**        Time only advances in HAL_Delay(), in blocking transfers and in
+**        sim_advance(). Interrupt transfers complete as events on the
+**        simulated clock, their callbacks run within these calls unless
+**        the interrupts are masked or their interrupt is disabled by the
+**        NVIC.
+******************************************************************************/
+
+#ifndef _HAL_SIM_H
+#define _HAL_SIM_H
+
+/*** Include *****************************************************************/
+#include <stdint.h>
+
+#include "stm32g4xx_hal.h"
+/* NO MORE DEFINITIONS */
+
+/*** Preprocessor definitions ************************************************/
+#define SIM_EVENTS_MAX    16        // pending simulated interrupts
+#define SIM_CORE_CLOCK_HZ 168000000 // HCLK, clock of the DWT cycle counter and of the timers
+#define SIM_CAN_LOG       256       // transmitted CAN frames kept in the log
+/* NO MORE DEFINITIONS */
+
+/*** Definition of variables *************************************************/
+/* simulated interrupt, called when the simulated time reaches its due time */
+typedef void(sim_event_cb_t)(void *p_arg);
+
+/* CAN frame on the simulated bus, us is the end of the frame */
+typedef struct {
+    uint64_t us;
+    uint32_t id;
+    uint8_t data[8];
+} sim_can_frame_t;
+
+/* simulated CAN partner, sees each transmitted frame */
+typedef void(sim_can_tx_cb_t)(const sim_can_frame_t *p_frame);
+
+/* faults of the simulated FDCAN, set by the scenarios */
+typedef struct {
+    uint8_t b_tx_full; // HAL_FDCAN_AddMessageToTxFifoQ() fails
+} sim_can_faults_t;
+/* NO MORE DEFINITIONS */
+
+/*** Prototypes of functions *************************************************/
+void sim_reset(void);
+uint64_t sim_time_us(void);
+void sim_advance(uint64_t us);
+int sim_event_add(uint64_t due_us, sim_event_cb_t *p_cb, void *p_arg);
+int sim_irq_add(uint64_t due_us, IRQn_Type irqn, sim_event_cb_t *p_cb, void *p_arg);
+void sim_event_cancel(sim_event_cb_t *p_cb, void *p_arg);
+
+void sim_periph_reset(void);
+void sim_gpio_set(GPIO_TypeDef *port, uint16_t pin, uint8_t level);
+int sim_can_receive(uint32_t id, const uint8_t data[8]);
+void sim_can_set_partner(sim_can_tx_cb_t *p_cb);
+sim_can_faults_t *sim_can_faults_get(void);
+uint32_t sim_can_tx_count(void);
+const sim_can_frame_t *sim_can_tx(uint32_t index);
+/* NO MORE DEFINITIONS */
+
+#endif //_HAL_SIM_H
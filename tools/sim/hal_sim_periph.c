@@ -0,0 +1,436 @@
+/******************************************************************************
+** @file hal_sim_periph.c
+** @author
+** @brief Host simulation: GPIO with EXTI, TIM and FDCAN of the HAL on the
+**        simulated clock. The scenarios set the input levels and receive
+**        CAN frames, the transmitted frames are logged and passed to the
+**        simulated CAN partner.
+******************************************************************************/
+
+/*** Include *****************************************************************/
+#include <string.h>
+
+#include "stm32g4xx_hal.h"
+#include "hal_sim.h"
+/* NO MORE DEFINITIONS */
+
+/*** Preprocessor definitions ************************************************/
+#define SIM_EXTI_IRQ_US  1   // interrupt latency of an edge
+#define SIM_CAN_FRAME_US 250 // classic frame with 8 bytes at 500 kbit/s
+#define SIM_CAN_RX_FIFO  3   // depth of the receive FIFO 0
+/* NO MORE DEFINITIONS */
+
+/*** Definition of variables *************************************************/
+GPIO_TypeDef sim_gpio[SIM_GPIO_PORTS];
+
+static uint32_t sim_exti_lines;   // lines enabled by LL_EXTI_Init()
+static uint32_t sim_exti_pending; // lines with a pending interrupt
+static uint8_t sim_exti_port[16]; // port of each line, LL_SYSCFG_EXTI_PORTx
+
+static uint64_t sim_tim_due;
+static TIM_HandleTypeDef *p_sim_tim;
+static TIM_HandleTypeDef *p_sim_tim_cc; // timer started without interrupt, e.g. TIM17
+static uint64_t sim_tim_cc_start;      // start of its counter
+static uint32_t sim_tim_cc_compare;    // compare of channel 1
+static uint8_t sim_tim_cc_b_it;        // compare interrupt of channel 1 enabled
+
+static FDCAN_HandleTypeDef *p_sim_fdcan;
+static uint8_t sim_can_started;
+static sim_can_frame_t sim_can_rx[SIM_CAN_RX_FIFO];
+static uint8_t sim_can_rx_count;
+static sim_can_frame_t sim_can_log[SIM_CAN_LOG];
+static uint32_t sim_can_tx_n;
+static sim_can_tx_cb_t *p_sim_can_partner;
+static sim_can_faults_t sim_can_faults;
+/* NO MORE DEFINITIONS */
+
+/*** Definitions of functions ************************************************/
+/******************************************************************************
+** Name               : @fn sim_periph_reset
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function sets all inputs low and clears the EXTI, timer and CAN state.
+**
+** Calling            : @remark sim_reset
+**
+** InputValues        : @param none
+**
+** OutputValues       : @retval none
+******************************************************************************/
+void sim_periph_reset(void) {
+    memset(sim_gpio, 0, sizeof(sim_gpio));
+    sim_exti_lines = 0;
+    sim_exti_pending = 0;
+    memset(sim_exti_port, 0, sizeof(sim_exti_port));
+    p_sim_tim = NULL;
+    p_sim_tim_cc = NULL;
+    sim_tim_cc_b_it = 0;
+    p_sim_fdcan = NULL;
+    sim_can_started = 0;
+    sim_can_rx_count = 0;
+    sim_can_tx_n = 0;
+    p_sim_can_partner = NULL;
+    memset(&sim_can_faults, 0, sizeof(sim_can_faults));
+}
+
+/*** GPIO and EXTI ***********************************************************/
+static IRQn_Type sim_exti_irqn(uint8_t line) {
+    if (line <= 3) {
+        return (IRQn_Type)(EXTI0_IRQn + line);
+    }
+    return EXTI15_10_IRQn; // only the lines of the keys are simulated
+}
+
+static void sim_exti_irq(void *p_arg) {
+    uint16_t pin = (uint16_t)(uintptr_t)p_arg;
+
+    sim_exti_pending &= ~(uint32_t)pin;
+    HAL_GPIO_EXTI_Callback(pin);
+}
+
+/******************************************************************************
+** Name               : @fn sim_gpio_set
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function sets the level of an input. An edge on a pin whose EXTI line is
+**                       enabled and connected to the port raises the EXTI interrupt, it is pending once.
+**
+** Calling            : @remark scenarios
+**
+** InputValues        : @param port, pin, uint8_t level 0 or 1
+**
+** OutputValues       : @retval none
+******************************************************************************/
+void sim_gpio_set(GPIO_TypeDef *port, uint16_t pin, uint8_t level) {
+    uint32_t idr = level ? (port->IDR | pin) : (port->IDR & ~(uint32_t)pin);
+    uint8_t line = (uint8_t)__builtin_ctz(pin);
+
+    if (idr == port->IDR) {
+        return;
+    }
+    port->IDR = idr;
+    if ((sim_exti_lines & pin) && (sim_exti_port[line] == (uint8_t)(port - sim_gpio)) &&
+        !(sim_exti_pending & pin)) {
+        sim_exti_pending |= pin;
+        sim_irq_add(sim_time_us() + SIM_EXTI_IRQ_US, sim_exti_irqn(line), sim_exti_irq, (void *)(uintptr_t)pin);
+    }
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin) {
+    return (GPIOx->IDR & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState) {
+    GPIOx->ODR = (PinState == GPIO_PIN_SET) ? (GPIOx->ODR | GPIO_Pin) : (GPIOx->ODR & ~(uint32_t)GPIO_Pin);
+}
+
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin) {
+    GPIOx->ODR ^= GPIO_Pin;
+}
+
+uint32_t LL_GPIO_Init(GPIO_TypeDef *GPIOx, LL_GPIO_InitTypeDef *GPIO_InitStruct) {
+    (void)GPIOx;
+    (void)GPIO_InitStruct;
+    return 0;
+}
+
+uint32_t LL_EXTI_Init(LL_EXTI_InitTypeDef *EXTI_InitStruct) {
+    if (EXTI_InitStruct->LineCommand == ENABLE) {
+        sim_exti_lines |= EXTI_InitStruct->Line_0_31;
+    } else {
+        sim_exti_lines &= ~EXTI_InitStruct->Line_0_31;
+    }
+    return 0;
+}
+
+void LL_SYSCFG_SetEXTISource(uint32_t Port, uint32_t Line) {
+    sim_exti_port[Line & 0x0F] = (uint8_t)Port;
+}
+
+void LL_APB2_GRP1_EnableClock(uint32_t Periphs) {
+    (void)Periphs;
+}
+
+__attribute__((weak)) void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) {
+    (void)GPIO_Pin;
+}
+
+/*** TIM *********************************************************************/
+/* the timer clock is the CPU clock, an update while the interrupt is disabled stays pending once */
+static uint64_t sim_tim_period_us(const TIM_HandleTypeDef *htim) {
+    uint64_t period = ((uint64_t)(htim->Init.Prescaler + 1) * (htim->Init.Period + 1)) / (SystemCoreClock / 1000000U);
+
+    return period ? period : 1;
+}
+
+static void sim_tim_irq(void *p_arg) {
+    TIM_HandleTypeDef *htim = p_arg;
+
+    do {
+        sim_tim_due += sim_tim_period_us(htim);
+    } while (sim_tim_due <= sim_time_us());
+    sim_irq_add(sim_tim_due, TIM1_UP_TIM16_IRQn, sim_tim_irq, htim);
+    HAL_TIM_PeriodElapsedCallback(htim);
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *htim) {
+    (void)htim;
+    return HAL_OK;
+}
+
+/* only one timer with interrupt is simulated, TIM16 */
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim) {
+    if (p_sim_tim) {
+        return HAL_BUSY;
+    }
+    p_sim_tim = htim;
+    sim_tim_due = sim_time_us() + sim_tim_period_us(htim);
+    return (sim_irq_add(sim_tim_due, TIM1_UP_TIM16_IRQn, sim_tim_irq, htim) == 0) ? HAL_OK : HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_TIM_OC_ConfigChannel(TIM_HandleTypeDef *htim, TIM_OC_InitTypeDef *sConfig, uint32_t Channel) {
+    (void)htim;
+    (void)sConfig;
+    (void)Channel;
+    return HAL_OK;
+}
+
+__attribute__((weak)) void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim) {
+    (void)htim;
+}
+
+/* counter of the timer started without interrupt, the compare matches once per period while enabled */
+static void sim_tim_cc_schedule(void);
+
+static void sim_tim_cc_irq(void *p_arg) {
+    TIM_HandleTypeDef *htim = p_arg;
+
+    sim_tim_cc_schedule();
+    HAL_TIM_OC_DelayElapsedCallback(htim);
+}
+
+static void sim_tim_cc_schedule(void) {
+    uint64_t ticks;
+    uint32_t period;
+
+    sim_event_cancel(sim_tim_cc_irq, p_sim_tim_cc);
+    if (!p_sim_tim_cc || !sim_tim_cc_b_it) {
+        return;
+    }
+    period = p_sim_tim_cc->Init.Period + 1;
+    ticks = (sim_tim_cc_compare + period - sim_tim_get_counter(p_sim_tim_cc)) % period;
+    ticks = ticks ? ticks : period;
+    sim_irq_add(sim_time_us() + (ticks * (p_sim_tim_cc->Init.Prescaler + 1)) / (SystemCoreClock / 1000000U),
+                TIM1_TRG_COM_TIM17_IRQn, sim_tim_cc_irq, p_sim_tim_cc);
+}
+
+/* only one timer without interrupt is simulated, TIM17 */
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *htim) {
+    if (p_sim_tim_cc) {
+        return HAL_BUSY;
+    }
+    p_sim_tim_cc = htim;
+    sim_tim_cc_start = sim_time_us();
+    return HAL_OK;
+}
+
+uint32_t sim_tim_get_counter(TIM_HandleTypeDef *htim) {
+    uint64_t ticks;
+
+    if (htim != p_sim_tim_cc) {
+        return 0;
+    }
+    ticks = ((sim_time_us() - sim_tim_cc_start) * (SystemCoreClock / 1000000U)) / (htim->Init.Prescaler + 1);
+    return (uint32_t)(ticks % ((uint64_t)htim->Init.Period + 1));
+}
+
+void sim_tim_set_compare(TIM_HandleTypeDef *htim, uint32_t Channel, uint32_t Compare) {
+    if ((htim == p_sim_tim_cc) && (Channel == TIM_CHANNEL_1)) {
+        sim_tim_cc_compare = Compare;
+        sim_tim_cc_schedule();
+    }
+}
+
+void sim_tim_set_it(TIM_HandleTypeDef *htim, uint32_t Interrupt, uint8_t b_enable) {
+    if ((htim == p_sim_tim_cc) && (Interrupt == TIM_IT_CC1)) {
+        sim_tim_cc_b_it = b_enable;
+        sim_tim_cc_schedule();
+    }
+}
+
+__attribute__((weak)) void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim) {
+    (void)htim;
+}
+
+/*** FDCAN *******************************************************************/
+static void sim_can_rx_irq(void *p_arg) {
+    (void)p_arg;
+    HAL_FDCAN_RxFifo0Callback(p_sim_fdcan, FDCAN_IT_RX_FIFO0_NEW_MESSAGE);
+}
+
+/******************************************************************************
+** Name               : @fn sim_can_receive
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function puts a frame on the bus, it is in the receive FIFO after the frame
+**                       time and raises the FDCAN interrupt. A frame is lost if the FIFO is full or FDCAN is
+**                       stopped.
+**
+** Calling            : @remark scenarios, CAN partner
+**
+** InputValues        : @param uint32_t id, 8 data bytes
+**
+** OutputValues       : @retval int 0 = received, -1 = lost
+******************************************************************************/
+int sim_can_receive(uint32_t id, const uint8_t data[8]) {
+    sim_can_frame_t *p_frame;
+
+    if (!sim_can_started || (sim_can_rx_count >= SIM_CAN_RX_FIFO)) {
+        return -1;
+    }
+    p_frame = &sim_can_rx[sim_can_rx_count++];
+    p_frame->us = sim_time_us() + SIM_CAN_FRAME_US;
+    p_frame->id = id;
+    memcpy(p_frame->data, data, sizeof(p_frame->data));
+    return sim_irq_add(p_frame->us, FDCAN2_IT0_IRQn, sim_can_rx_irq, NULL);
+}
+
+void sim_can_set_partner(sim_can_tx_cb_t *p_cb) {
+    p_sim_can_partner = p_cb;
+}
+
+sim_can_faults_t *sim_can_faults_get(void) {
+    return &sim_can_faults;
+}
+
+uint32_t sim_can_tx_count(void) {
+    return sim_can_tx_n;
+}
+
+/* transmitted frame, the log keeps the last SIM_CAN_LOG frames */
+const sim_can_frame_t *sim_can_tx(uint32_t index) {
+    if ((index >= sim_can_tx_n) || ((sim_can_tx_n - index) > SIM_CAN_LOG)) {
+        return NULL;
+    }
+    return &sim_can_log[index % SIM_CAN_LOG];
+}
+
+HAL_StatusTypeDef HAL_FDCAN_Init(FDCAN_HandleTypeDef *hfdcan) {
+    p_sim_fdcan = hfdcan;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FDCAN_ConfigFilter(FDCAN_HandleTypeDef *hfdcan, FDCAN_FilterTypeDef *sFilterConfig) {
+    (void)hfdcan;
+    (void)sFilterConfig;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FDCAN_Start(FDCAN_HandleTypeDef *hfdcan) {
+    (void)hfdcan;
+    sim_can_started = 1;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FDCAN_Stop(FDCAN_HandleTypeDef *hfdcan) {
+    (void)hfdcan;
+    sim_can_started = 0;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FDCAN_ActivateNotification(FDCAN_HandleTypeDef *hfdcan, uint32_t ActiveITs,
+                                                 uint32_t BufferIndexes) {
+    (void)hfdcan;
+    (void)ActiveITs;
+    (void)BufferIndexes;
+    return HAL_OK;
+}
+
+/* frames whose frame time is not over yet are still on the bus */
+uint32_t HAL_FDCAN_GetRxFifoFillLevel(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo) {
+    uint32_t level = 0;
+
+    (void)hfdcan;
+    (void)RxFifo;
+    while ((level < sim_can_rx_count) && (sim_can_rx[level].us <= sim_time_us())) {
+        level++;
+    }
+    return level;
+}
+
+HAL_StatusTypeDef HAL_FDCAN_GetRxMessage(FDCAN_HandleTypeDef *hfdcan, uint32_t RxLocation,
+                                         FDCAN_RxHeaderTypeDef *pRxHeader, uint8_t *pRxData) {
+    if (!HAL_FDCAN_GetRxFifoFillLevel(hfdcan, RxLocation)) {
+        return HAL_ERROR;
+    }
+    pRxHeader->Identifier = sim_can_rx[0].id;
+    pRxHeader->IdType = FDCAN_STANDARD_ID;
+    pRxHeader->DataLength = FDCAN_DLC_BYTES_8;
+    memcpy(pRxData, sim_can_rx[0].data, sizeof(sim_can_rx[0].data));
+    memmove(&sim_can_rx[0], &sim_can_rx[1], --sim_can_rx_count * sizeof(sim_can_rx[0]));
+    return HAL_OK;
+}
+
+/* the frame is logged when it is queued, the partner sees it after the frame time */
+HAL_StatusTypeDef HAL_FDCAN_AddMessageToTxFifoQ(FDCAN_HandleTypeDef *hfdcan, FDCAN_TxHeaderTypeDef *pTxHeader,
+                                                uint8_t *pTxData) {
+    sim_can_frame_t *p_frame;
+
+    (void)hfdcan;
+    if (!sim_can_started || sim_can_faults.b_tx_full) {
+        return HAL_ERROR;
+    }
+    p_frame = &sim_can_log[sim_can_tx_n++ % SIM_CAN_LOG];
+    p_frame->us = sim_time_us() + SIM_CAN_FRAME_US;
+    p_frame->id = pTxHeader->Identifier;
+    memcpy(p_frame->data, pTxData, sizeof(p_frame->data));
+    if (p_sim_can_partner) {
+        p_sim_can_partner(p_frame);
+    }
+    return HAL_OK;
+}
+
+uint32_t HAL_FDCAN_IsTxBufferMessagePending(FDCAN_HandleTypeDef *hfdcan, uint32_t TxBufferIndex) {
+    (void)hfdcan;
+    (void)TxBufferIndex;
+    return 0;
+}
+
+uint32_t HAL_FDCAN_GetLatestTxFifoQRequestBuffer(FDCAN_HandleTypeDef *hfdcan) {
+    (void)hfdcan;
+    return 0;
+}
+
+HAL_StatusTypeDef HAL_FDCAN_GetProtocolStatus(FDCAN_HandleTypeDef *hfdcan,
+                                              FDCAN_ProtocolStatusTypeDef *ProtocolStatus) {
+    (void)hfdcan;
+    memset(ProtocolStatus, 0, sizeof(*ProtocolStatus));
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FDCAN_GetErrorCounters(FDCAN_HandleTypeDef *hfdcan, FDCAN_ErrorCountersTypeDef *ErrorCounters) {
+    (void)hfdcan;
+    memset(ErrorCounters, 0, sizeof(*ErrorCounters));
+    return HAL_OK;
+}
+
+/* the simulated interrupts call the callbacks directly */
+void HAL_FDCAN_IRQHandler(FDCAN_HandleTypeDef *hfdcan) {
+    (void)hfdcan;
+}
+
+__attribute__((weak)) void HAL_FDCAN_RxFifo0Callback(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo0ITs) {
+    FDCAN_RxHeaderTypeDef header;
+    uint8_t data[8];
+
+    (void)RxFifo0ITs;
+    HAL_FDCAN_GetRxMessage(hfdcan, FDCAN_RX_FIFO0, &header, data);
+}
+
+__attribute__((weak)) void HAL_FDCAN_ErrorStatusCallback(FDCAN_HandleTypeDef *hfdcan, uint32_t ErrorStatusITs) {
+    (void)hfdcan;
+    (void)ErrorStatusITs;
+}
@@ -0,0 +1,27 @@
+/******************************************************************************
+** @file Core.h
+** @author
+** @brief Host simulation: the Embedded Wizard types used in the interfaces
+**        of the simulated firmware modules, the GUI is not simulated.
+******************************************************************************/
+
+#ifndef _SIM_CORE_H
+#define _SIM_CORE_H
+
+/*** Definition of variables *************************************************/
+typedef struct CoreRoot *CoreRoot;
+
+typedef enum {
+    CoreKeyCodeNoKey,
+    CoreKeyCodeUp,
+    CoreKeyCodeDown,
+    CoreKeyCodeLeft,
+    CoreKeyCodeRight
+} CoreKeyCode;
+/* NO MORE DEFINITIONS */
+
+/*** Prototypes of functions *************************************************/
+int CoreRoot__DriveKeyboardHitting(CoreRoot _this, CoreKeyCode aCode, unsigned short aCharCode, int aDown);
+/* NO MORE DEFINITIONS */
+
+#endif //_SIM_CORE_H
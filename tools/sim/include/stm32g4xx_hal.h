@@ -0,0 +1,132 @@
+/******************************************************************************
+** @file stm32g4xx_hal.h
+** @author
+** @brief Host simulation: the part of the STM32G4 HAL used by the simulated
+**        firmware modules. The functions are implemented by hal_sim.c on a
+**        simulated clock, the I2C transfers go to the DS2484/DS2431 model.
+**        GPIO, TIM and FDCAN are declared by their own headers and
+**        implemented by hal_sim_periph.c.
+******************************************************************************/
+
+#ifndef _SIM_STM32G4XX_HAL_H
+#define _SIM_STM32G4XX_HAL_H
+
+/*** Include *****************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+/* NO MORE DEFINITIONS */
+
+/*** Preprocessor definitions ************************************************/
+#define HAL_MAX_DELAY 0xFFFFFFFFU
+
+#define I2C_MEMADD_SIZE_8BIT  (0x00000001U)
+#define I2C_MEMADD_SIZE_16BIT (0x00000002U)
+
+#define DISABLE 0U
+#define ENABLE  1U
+
+#define DWT (sim_dwt()) // the cycle counter follows the simulated clock
+/* NO MORE DEFINITIONS */
+
+/*** Definition of variables *************************************************/
+typedef enum { HAL_OK = 0x00U, HAL_ERROR = 0x01U, HAL_BUSY = 0x02U, HAL_TIMEOUT = 0x03U } HAL_StatusTypeDef;
+
+typedef enum {
+    HAL_I2C_STATE_RESET = 0x00U, // not initialized
+    HAL_I2C_STATE_READY = 0x20U, // initialized, no transfer
+    HAL_I2C_STATE_BUSY = 0x24U   // transfer running
+} HAL_I2C_StateTypeDef;
+
+typedef struct {
+    uint32_t Timing;
+} I2C_InitTypeDef;
+
+typedef struct __I2C_HandleTypeDef {
+    void *Instance;
+    I2C_InitTypeDef Init;
+    volatile HAL_I2C_StateTypeDef State;
+} I2C_HandleTypeDef;
+
+/* interrupts of the simulated peripherals, each can be disabled by the NVIC functions */
+typedef enum {
+    SIM_IRQ_NONE = -1, // not maskable by the NVIC, e.g. the I2C of the 1-Wire model
+    EXTI0_IRQn = 6,
+    EXTI1_IRQn = 7,
+    EXTI2_IRQn = 8,
+    EXTI3_IRQn = 9,
+    TIM1_UP_TIM16_IRQn = 25,
+    TIM1_TRG_COM_TIM17_IRQn = 26,
+    EXTI15_10_IRQn = 40,
+    FDCAN2_IT0_IRQn = 86,
+    SIM_IRQ_N = 128
+} IRQn_Type;
+
+typedef struct {
+    volatile uint32_t CYCCNT;
+} DWT_Type;
+
+/* interrupt mask, there are no real interrupts: the simulated ones are delivered while the simulated time advances */
+extern uint32_t sim_primask;
+extern uint32_t SystemCoreClock;
+/* NO MORE DEFINITIONS */
+
+/*** Prototypes of functions *************************************************/
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority);
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn);
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn);
+uint32_t NVIC_GetEnableIRQ(IRQn_Type IRQn);
+DWT_Type *sim_dwt(void);
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c);
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef *hi2c);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size,
+                                          uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size,
+                                         uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                   uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                             uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                            uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Mem_Read_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                      uint16_t MemAddSize, uint8_t *pData, uint16_t Size);
+
+/* callbacks of the interrupt transfers, implemented by the firmware */
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c);
+/* NO MORE DEFINITIONS */
+
+/*** Definitions of functions ************************************************/
+static inline uint32_t __get_PRIMASK(void) {
+    return sim_primask;
+}
+
+static inline void __set_PRIMASK(uint32_t priMask) {
+    sim_primask = priMask;
+}
+
+static inline void __disable_irq(void) {
+    sim_primask = 1;
+}
+
+static inline void __enable_irq(void) {
+    sim_primask = 0;
+}
+
+/* the simulated interrupts run in the same thread, a compiler barrier is enough */
+static inline void __DMB(void) {
+    __asm__ volatile("" ::: "memory");
+}
+/* NO MORE DEFINITIONS */
+
+#include "stm32g4xx_hal_gpio.h"
+#include "stm32g4xx_hal_tim.h"
+#include "stm32g4xx_hal_fdcan.h"
+
+#endif //_SIM_STM32G4XX_HAL_H
@@ -0,0 +1,135 @@
+/******************************************************************************
+** @file stm32g4xx_hal_fdcan.h
+** @author
+** @brief Host simulation: FDCAN with a receive FIFO filled by the scenarios
+**        and a log of the transmitted frames. A received frame raises
+**        HAL_FDCAN_RxFifo0Callback() unless the FDCAN interrupt is disabled.
+******************************************************************************/
+
+#ifndef _SIM_STM32G4XX_HAL_FDCAN_H
+#define _SIM_STM32G4XX_HAL_FDCAN_H
+
+/*** Include *****************************************************************/
+#include "stm32g4xx_hal.h"
+/* NO MORE DEFINITIONS */
+
+/*** Preprocessor definitions ************************************************/
+#define FDCAN2 ((void *)2)
+
+#define FDCAN_FRAME_CLASSIC     0U
+#define FDCAN_MODE_NORMAL       0U
+#define FDCAN_TX_FIFO_OPERATION 0U
+#define FDCAN_STANDARD_ID       0U
+#define FDCAN_FILTER_RANGE      0U
+#define FDCAN_FILTER_TO_RXFIFO0 1U
+#define FDCAN_DATA_FRAME        0U
+#define FDCAN_DLC_BYTES_8       8U
+#define FDCAN_ESI_ACTIVE        0U
+#define FDCAN_BRS_OFF           0U
+#define FDCAN_CLASSIC_CAN       0U
+#define FDCAN_NO_TX_EVENTS      0U
+#define FDCAN_RX_FIFO0          0x40U
+
+#define FDCAN_IT_RX_FIFO0_NEW_MESSAGE   0x00000001U
+#define FDCAN_IT_TX_COMPLETE            0x00000200U
+#define FDCAN_IT_ERROR_LOGGING_OVERFLOW 0x00400000U
+#define FDCAN_IR_EP                     0x00800000U
+#define FDCAN_IR_EW                     0x01000000U
+#define FDCAN_IR_BO                     0x02000000U
+
+#define FDCAN_PROTOCOL_ERROR_NONE      0U
+#define FDCAN_PROTOCOL_ERROR_STUFF     1U
+#define FDCAN_PROTOCOL_ERROR_FORM      2U
+#define FDCAN_PROTOCOL_ERROR_ACK       3U
+#define FDCAN_PROTOCOL_ERROR_BIT1      4U
+#define FDCAN_PROTOCOL_ERROR_BIT0      5U
+#define FDCAN_PROTOCOL_ERROR_CRC       6U
+#define FDCAN_PROTOCOL_ERROR_NO_CHANGE 7U
+/* NO MORE DEFINITIONS */
+
+/*** Definition of variables *************************************************/
+typedef struct {
+    uint32_t FrameFormat;
+    uint32_t Mode;
+    uint32_t AutoRetransmission;
+    uint32_t TransmitPause;
+    uint32_t ProtocolException;
+    uint32_t NominalPrescaler;
+    uint32_t NominalSyncJumpWidth;
+    uint32_t NominalTimeSeg1;
+    uint32_t NominalTimeSeg2;
+    uint32_t DataPrescaler;
+    uint32_t DataSyncJumpWidth;
+    uint32_t DataTimeSeg1;
+    uint32_t DataTimeSeg2;
+    uint32_t StdFiltersNbr;
+    uint32_t ExtFiltersNbr;
+    uint32_t TxFifoQueueMode;
+} FDCAN_InitTypeDef;
+
+typedef struct {
+    void *Instance;
+    FDCAN_InitTypeDef Init;
+} FDCAN_HandleTypeDef;
+
+typedef struct {
+    uint32_t IdType;
+    uint32_t FilterIndex;
+    uint32_t FilterType;
+    uint32_t FilterConfig;
+    uint32_t FilterID1;
+    uint32_t FilterID2;
+} FDCAN_FilterTypeDef;
+
+typedef struct {
+    uint32_t Identifier;
+    uint32_t IdType;
+    uint32_t TxFrameType;
+    uint32_t DataLength;
+    uint32_t ErrorStateIndicator;
+    uint32_t BitRateSwitch;
+    uint32_t FDFormat;
+    uint32_t TxEventFifoControl;
+    uint32_t MessageMarker;
+} FDCAN_TxHeaderTypeDef;
+
+typedef struct {
+    uint32_t Identifier;
+    uint32_t IdType;
+    uint32_t DataLength;
+} FDCAN_RxHeaderTypeDef;
+
+typedef struct {
+    uint32_t LastErrorCode;
+    uint32_t BusOff;
+} FDCAN_ProtocolStatusTypeDef;
+
+typedef struct {
+    uint32_t TxErrorCnt;
+    uint32_t RxErrorCnt;
+    uint32_t ErrorLogging;
+} FDCAN_ErrorCountersTypeDef;
+/* NO MORE DEFINITIONS */
+
+/*** Prototypes of functions *************************************************/
+HAL_StatusTypeDef HAL_FDCAN_Init(FDCAN_HandleTypeDef *hfdcan);
+HAL_StatusTypeDef HAL_FDCAN_ConfigFilter(FDCAN_HandleTypeDef *hfdcan, FDCAN_FilterTypeDef *sFilterConfig);
+HAL_StatusTypeDef HAL_FDCAN_Start(FDCAN_HandleTypeDef *hfdcan);
+HAL_StatusTypeDef HAL_FDCAN_Stop(FDCAN_HandleTypeDef *hfdcan);
+HAL_StatusTypeDef HAL_FDCAN_ActivateNotification(FDCAN_HandleTypeDef *hfdcan, uint32_t ActiveITs,
+                                                 uint32_t BufferIndexes);
+uint32_t HAL_FDCAN_GetRxFifoFillLevel(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo);
+HAL_StatusTypeDef HAL_FDCAN_GetRxMessage(FDCAN_HandleTypeDef *hfdcan, uint32_t RxLocation,
+                                         FDCAN_RxHeaderTypeDef *pRxHeader, uint8_t *pRxData);
+HAL_StatusTypeDef HAL_FDCAN_AddMessageToTxFifoQ(FDCAN_HandleTypeDef *hfdcan, FDCAN_TxHeaderTypeDef *pTxHeader,
+                                                uint8_t *pTxData);
+uint32_t HAL_FDCAN_IsTxBufferMessagePending(FDCAN_HandleTypeDef *hfdcan, uint32_t TxBufferIndex);
+uint32_t HAL_FDCAN_GetLatestTxFifoQRequestBuffer(FDCAN_HandleTypeDef *hfdcan);
+HAL_StatusTypeDef HAL_FDCAN_GetProtocolStatus(FDCAN_HandleTypeDef *hfdcan, FDCAN_ProtocolStatusTypeDef *ProtocolStatus);
+HAL_StatusTypeDef HAL_FDCAN_GetErrorCounters(FDCAN_HandleTypeDef *hfdcan, FDCAN_ErrorCountersTypeDef *ErrorCounters);
+void HAL_FDCAN_IRQHandler(FDCAN_HandleTypeDef *hfdcan);
+void HAL_FDCAN_RxFifo0Callback(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo0ITs);
+void HAL_FDCAN_ErrorStatusCallback(FDCAN_HandleTypeDef *hfdcan, uint32_t ErrorStatusITs);
+/* NO MORE DEFINITIONS */
+
+#endif //_SIM_STM32G4XX_HAL_FDCAN_H
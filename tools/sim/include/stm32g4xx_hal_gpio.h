@@ -0,0 +1,99 @@
+/******************************************************************************
+** @file stm32g4xx_hal_gpio.h
+** @author
+** @brief Host simulation: GPIO ports as input levels set by the scenarios,
+**        EXTI lines and the LL definitions of the key inputs. An edge on a
+**        pin of an enabled EXTI line raises HAL_GPIO_EXTI_Callback().
+******************************************************************************/
+
+#ifndef _SIM_STM32G4XX_HAL_GPIO_H
+#define _SIM_STM32G4XX_HAL_GPIO_H
+
+/*** Include *****************************************************************/
+#include "stm32g4xx_hal.h"
+/* NO MORE DEFINITIONS */
+
+/*** Preprocessor definitions ************************************************/
+#define SIM_GPIO_PORTS 7 // GPIOA .. GPIOG
+
+#define GPIOA (&sim_gpio[0])
+#define GPIOB (&sim_gpio[1])
+#define GPIOC (&sim_gpio[2])
+#define GPIOD (&sim_gpio[3])
+#define GPIOE (&sim_gpio[4])
+#define GPIOF (&sim_gpio[5])
+#define GPIOG (&sim_gpio[6])
+
+#define LL_GPIO_PIN_0  0x0001U
+#define LL_GPIO_PIN_1  0x0002U
+#define LL_GPIO_PIN_2  0x0004U
+#define LL_GPIO_PIN_3  0x0008U
+#define LL_GPIO_PIN_4  0x0010U
+#define LL_GPIO_PIN_5  0x0020U
+#define LL_GPIO_PIN_6  0x0040U
+#define LL_GPIO_PIN_7  0x0080U
+#define LL_GPIO_PIN_8  0x0100U
+#define LL_GPIO_PIN_9  0x0200U
+#define LL_GPIO_PIN_10 0x0400U
+#define LL_GPIO_PIN_11 0x0800U
+#define LL_GPIO_PIN_12 0x1000U
+#define LL_GPIO_PIN_13 0x2000U
+#define LL_GPIO_PIN_14 0x4000U
+#define LL_GPIO_PIN_15 0x8000U
+
+#define LL_GPIO_MODE_INPUT 0U
+#define LL_GPIO_PULL_DOWN  2U
+
+#define LL_SYSCFG_EXTI_PORTA 0U
+#define LL_SYSCFG_EXTI_PORTB 1U
+#define LL_SYSCFG_EXTI_PORTC 2U
+#define LL_SYSCFG_EXTI_PORTD 3U
+#define LL_SYSCFG_EXTI_LINE0  0U
+#define LL_SYSCFG_EXTI_LINE1  1U
+#define LL_SYSCFG_EXTI_LINE2  2U
+#define LL_SYSCFG_EXTI_LINE3  3U
+#define LL_SYSCFG_EXTI_LINE14 14U
+
+#define LL_EXTI_MODE_IT                0U
+#define LL_EXTI_TRIGGER_RISING_FALLING 3U
+
+#define LL_APB2_GRP1_PERIPH_SYSCFG 1U
+/* NO MORE DEFINITIONS */
+
+/*** Definition of variables *************************************************/
+typedef enum { GPIO_PIN_RESET = 0U, GPIO_PIN_SET } GPIO_PinState;
+
+typedef struct {
+    volatile uint32_t IDR; // input levels
+    volatile uint32_t ODR; // output levels
+} GPIO_TypeDef;
+
+typedef struct {
+    uint32_t Pin;
+    uint32_t Mode;
+    uint32_t Pull;
+} LL_GPIO_InitTypeDef;
+
+typedef struct {
+    uint32_t Line_0_31;
+    uint8_t LineCommand;
+    uint8_t Mode;
+    uint8_t Trigger;
+} LL_EXTI_InitTypeDef;
+
+extern GPIO_TypeDef sim_gpio[SIM_GPIO_PORTS];
+/* NO MORE DEFINITIONS */
+
+/*** Prototypes of functions *************************************************/
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin);
+
+uint32_t LL_GPIO_Init(GPIO_TypeDef *GPIOx, LL_GPIO_InitTypeDef *GPIO_InitStruct);
+uint32_t LL_EXTI_Init(LL_EXTI_InitTypeDef *EXTI_InitStruct);
+void LL_SYSCFG_SetEXTISource(uint32_t Port, uint32_t Line);
+void LL_APB2_GRP1_EnableClock(uint32_t Periphs);
+/* NO MORE DEFINITIONS */
+
+#endif //_SIM_STM32G4XX_HAL_GPIO_H
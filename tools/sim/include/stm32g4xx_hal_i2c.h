@@ -0,0 +1,8 @@
+/******************************************************************************
+** @file stm32g4xx_hal_i2c.h
+** @author
+** @brief Host simulation: the I2C part of the HAL is declared in
+**        stm32g4xx_hal.h.
+******************************************************************************/
+
+#include "stm32g4xx_hal.h"
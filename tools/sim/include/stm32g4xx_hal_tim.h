@@ -0,0 +1,78 @@
+/******************************************************************************
+** @file stm32g4xx_hal_tim.h
+** @author
+** @brief Host simulation: timers with a period elapsed interrupt. A timer
+**        started with interrupt raises HAL_TIM_PeriodElapsedCallback()
+**        every period. The counter of a timer started without interrupt
+**        runs, the compare of its channel 1 raises
+**        HAL_TIM_OC_DelayElapsedCallback() while its interrupt is enabled.
+******************************************************************************/
+
+#ifndef _SIM_STM32G4XX_HAL_TIM_H
+#define _SIM_STM32G4XX_HAL_TIM_H
+
+/*** Include *****************************************************************/
+#include "stm32g4xx_hal.h"
+/* NO MORE DEFINITIONS */
+
+/*** Preprocessor definitions ************************************************/
+#define TIM16 ((void *)16)
+#define TIM17 ((void *)17)
+#define TIM20 ((void *)20)
+
+#define TIM_COUNTERMODE_UP             0U
+#define TIM_CLOCKDIVISION_DIV1         0U
+#define TIM_AUTORELOAD_PRELOAD_DISABLE 0U
+#define TIM_OCMODE_TIMING              0U
+#define TIM_OCPOLARITY_HIGH            0U
+#define TIM_OCFAST_DISABLE             0U
+#define TIM_CHANNEL_1                  0x00U
+#define TIM_CHANNEL_2                  0x04U
+#define TIM_FLAG_CC1                   0x02U
+#define TIM_IT_CC1                     0x02U
+
+/* register access of the HAL, only the compare of channel 1 is simulated */
+#define __HAL_TIM_GET_COUNTER(h)          sim_tim_get_counter(h)
+#define __HAL_TIM_SET_COMPARE(h, ch, cmp) sim_tim_set_compare((h), (ch), (cmp))
+#define __HAL_TIM_CLEAR_FLAG(h, flag)     ((void)(h), (void)(flag))
+#define __HAL_TIM_ENABLE_IT(h, it)        sim_tim_set_it((h), (it), 1)
+#define __HAL_TIM_DISABLE_IT(h, it)       sim_tim_set_it((h), (it), 0)
+/* NO MORE DEFINITIONS */
+
+/*** Definition of variables *************************************************/
+typedef struct {
+    uint32_t Prescaler;
+    uint32_t CounterMode;
+    uint32_t Period;
+    uint32_t ClockDivision;
+    uint32_t RepetitionCounter;
+    uint32_t AutoReloadPreload;
+} TIM_Base_InitTypeDef;
+
+typedef struct {
+    void *Instance;
+    TIM_Base_InitTypeDef Init;
+} TIM_HandleTypeDef;
+
+typedef struct {
+    uint32_t OCMode;
+    uint32_t Pulse;
+    uint32_t OCPolarity;
+    uint32_t OCFastMode;
+} TIM_OC_InitTypeDef;
+/* NO MORE DEFINITIONS */
+
+/*** Prototypes of functions *************************************************/
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_OC_ConfigChannel(TIM_HandleTypeDef *htim, TIM_OC_InitTypeDef *sConfig, uint32_t Channel);
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim);
+void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim);
+
+uint32_t sim_tim_get_counter(TIM_HandleTypeDef *htim);
+void sim_tim_set_compare(TIM_HandleTypeDef *htim, uint32_t Channel, uint32_t Compare);
+void sim_tim_set_it(TIM_HandleTypeDef *htim, uint32_t Interrupt, uint8_t b_enable);
+/* NO MORE DEFINITIONS */
+
+#endif //_SIM_STM32G4XX_HAL_TIM_H
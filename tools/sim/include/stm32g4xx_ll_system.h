@@ -0,0 +1,8 @@
+/******************************************************************************
+** @file stm32g4xx_ll_system.h
+** @author
+** @brief Host simulation: the LL definitions used by the simulated firmware
+**        modules are declared in stm32g4xx_hal.h.
+******************************************************************************/
+
+#include "stm32g4xx_hal.h"
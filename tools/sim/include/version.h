@@ -0,0 +1,23 @@
+/******************************************************************************
+** @file version.h
+** @author
+** @brief Host simulation: version of the simulated firmware, generated by
+**        the firmware build from version.h.in otherwise.
+******************************************************************************/
+
+#ifndef _SIM_VERSION_H
+#define _SIM_VERSION_H
+
+#define VERSION_PREFIX     "R1"
+#define VERSION_MAJOR      0U
+#define VERSION_MINOR      0U
+#define VERSION_PATCHLEVEL 0U
+
+#define VERSION         "0.0.0"
+#define VERSION_POSTFIX "sim"
+#define FULL_VERSION    VERSION_PREFIX "-" VERSION "-" VERSION_POSTFIX
+
+// build date + time in format: YYMMDDHHMM
+#define K_VERSION 2610180000UL
+
+#endif //_SIM_VERSION_H
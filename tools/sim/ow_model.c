@@ -0,0 +1,728 @@
+/******************************************************************************
+** @file ow_model.c
+** @author
+** @brief Host simulation: behavioral model of the DS2484 and the DS2431.
+**
+**        The 1-Wire bus is modeled byte by byte: the devices take part in a
+**        byte when they run at the speed of the DS2484, a read byte is the
+**        wired AND of all devices. The result of a 1-Wire command is known
+**        when the command is received, the status shows 1WB until the
+**        operation would have ended on the line. Timing values follow the
+**        default port configuration, ADJUST PORT is stored but does not
+**        change them.
+******************************************************************************/
+
+/*** Include *****************************************************************/
+#include <string.h>
+
+#include "ow_model.h"
+#include "hal_sim.h"
+/* NO MORE DEFINITIONS */
+
+/*** Preprocessor definitions ************************************************/
+/* DS2484 commands */
+#define DS2484_DEVICE_RESET  0xF0
+#define DS2484_SET_READ_PTR  0xE1
+#define DS2484_WRITE_CONFIG  0xD2
+#define DS2484_ADJUST_PORT   0xC3
+#define DS2484_1WIRE_RESET   0xB4
+#define DS2484_1WIRE_BIT     0x87
+#define DS2484_1WIRE_WRITE   0xA5
+#define DS2484_1WIRE_READ    0x96
+#define DS2484_1WIRE_TRIPLET 0x78
+
+/* DS2484 read pointer codes */
+#define DS2484_PTR_STATUS 0xF0
+#define DS2484_PTR_DATA   0xE1
+#define DS2484_PTR_PORT   0xB4
+#define DS2484_PTR_CONFIG 0xC3
+
+/* DS2484 status and configuration bits */
+#define DS2484_STS_1WB 0x01
+#define DS2484_STS_PPD 0x02
+#define DS2484_STS_SD  0x04
+#define DS2484_STS_RST 0x10
+#define DS2484_STS_SBR 0x20
+#define DS2484_STS_TSB 0x40
+#define DS2484_STS_DIR 0x80
+#define DS2484_CFG_1WS 0x08
+
+/* DS2431 ROM and memory function commands */
+#define DS2431_READ_ROM      0x33
+#define DS2431_SKIP_ROM      0xCC
+#define DS2431_MATCH_ROM     0x55
+#define DS2431_SEARCH_ROM    0xF0
+#define DS2431_RESUME        0xA5
+#define DS2431_OD_SKIP_ROM   0x3C
+#define DS2431_OD_MATCH_ROM  0x69
+#define DS2431_WRITE_SCRATCH 0x0F
+#define DS2431_READ_SCRATCH  0xAA
+#define DS2431_COPY_SCRATCH  0x55
+#define DS2431_READ_MEMORY   0xF0
+
+#define DS2431_ES_AA       0x80 // E/S: authorization accepted
+#define DS2431_ES_PF       0x20 // E/S: partial byte
+#define DS2431_ROW         8    // bytes of the scratchpad
+#define DS2431_COPY_LIMIT  0x88 // the rows from here on hold the factory and ID bytes
+#define DS2431_COPY_STATUS 0xAA // read after a successful copy
+/* NO MORE DEFINITIONS */
+
+/*** Definition of variables *************************************************/
+/* protocol state of a device */
+typedef enum {
+    E_DEV_IDLE,         // not selected, waits for a reset
+    E_DEV_ROM,          // waits for a ROM command
+    E_DEV_READ_ROM,     // sends the ROM ID
+    E_DEV_MATCH,        // receives the ROM ID of a MATCH ROM
+    E_DEV_SEARCH,       // takes part in the triplets of a SEARCH ROM
+    E_DEV_FUNCTION,     // selected, waits for a memory function command
+    E_DEV_WRITE_TA,     // receives TA1 and TA2 of a WRITE SCRATCHPAD
+    E_DEV_WRITE_DATA,   // receives the scratchpad data up to its end, then the CRC16 is sent
+    E_DEV_SEND,         // sends a prepared answer, e.g. READ SCRATCHPAD
+    E_DEV_COPY_AUTH,    // receives the authorization of a COPY SCRATCHPAD
+    E_DEV_COPY_STATUS,  // sends the copy status
+    E_DEV_READ_MEM_TA,  // receives TA1 and TA2 of a READ MEMORY
+    E_DEV_READ_MEM      // sends the memory
+} ow_dev_state_t;
+
+typedef struct {
+    uint8_t rom[8];
+    uint8_t mem[OW_MODEL_MEM_SIZE];
+    uint8_t scratch[DS2431_ROW];
+    uint8_t ta1, ta2, es;   // target address and ending offset with the flags
+    uint8_t b_overdrive;    // speed of the device
+    uint8_t b_resume;       // RESUME flag, set by MATCH ROM and SEARCH ROM
+    ow_dev_state_t state;
+    uint8_t idx;            // byte or bit index of the actual state
+    uint8_t b_copied;       // copy authorized
+    uint8_t answer[16];     // prepared answer of E_DEV_SEND
+    uint8_t answer_len;
+    uint16_t crc;           // CRC16 of WRITE SCRATCHPAD
+    uint16_t address;       // address of READ MEMORY
+    uint64_t prog_until;    // end of the EEPROM programming
+} ow_dev_t;
+
+static struct {
+    uint8_t status;      // status register without 1WB
+    uint8_t config;      // device configuration, low nibble
+    uint8_t port[8];     // port configuration
+    uint8_t data;        // read data register
+    uint8_t ptr;         // read pointer
+    uint64_t busy_until; // end of the 1-Wire operation
+} ds2484;
+
+static ow_dev_t ow_devices[OW_MODEL_DEVICES];
+static uint8_t ow_device_count;
+static ow_model_timing_t ow_timing;
+static ow_model_faults_t ow_faults;
+static ow_model_stats_t ow_stats;
+static uint32_t ow_read_count; // 1-Wire bytes read, for read_error_every
+/* NO MORE DEFINITIONS */
+
+/*** Definitions of functions ************************************************/
+static uint8_t crc8(uint8_t crc, const uint8_t *p_data, uint16_t length) {
+    while (length--) {
+        crc ^= *p_data++;
+        for (uint8_t i = 0; i < 8; i++) {
+            crc = (crc & 1) ? ((crc >> 1) ^ 0x8C) : (crc >> 1);
+        }
+    }
+    return crc;
+}
+
+static uint16_t crc16(uint16_t crc, const uint8_t *p_data, uint16_t length) {
+    while (length--) {
+        crc ^= *p_data++;
+        for (uint8_t i = 0; i < 8; i++) {
+            crc = (crc & 1) ? ((crc >> 1) ^ 0xA001) : (crc >> 1);
+        }
+    }
+    return crc;
+}
+
+static uint8_t ow_speed(void) {
+    return (ds2484.config & DS2484_CFG_1WS) ? 1 : 0;
+}
+
+static uint8_t ow_busy(void) {
+    return sim_time_us() < ds2484.busy_until;
+}
+
+static void ow_start(uint32_t us) {
+    ds2484.busy_until = sim_time_us() + us;
+    ow_stats.ow_busy_us += us;
+}
+
+/* a device takes part in the bus traffic at its own speed only */
+static uint8_t dev_active(ow_dev_t *p_dev) {
+    if (p_dev->state == E_DEV_IDLE) {
+        return 0;
+    }
+    if (p_dev->b_overdrive != ow_speed()) {
+        p_dev->state = E_DEV_IDLE;
+        return 0;
+    }
+    if (sim_time_us() < p_dev->prog_until) {
+        ow_stats.violations++; // the line has to stay idle while the EEPROM is programmed
+    }
+    return 1;
+}
+
+static void dev_rom_command(ow_dev_t *p_dev, uint8_t command) {
+    p_dev->idx = 0;
+    switch (command) {
+    case DS2431_READ_ROM:
+        p_dev->b_resume = 0;
+        p_dev->state = E_DEV_READ_ROM;
+        break;
+    case DS2431_SKIP_ROM:
+        p_dev->b_resume = 0;
+        p_dev->state = E_DEV_FUNCTION;
+        break;
+    case DS2431_OD_SKIP_ROM:
+        p_dev->b_resume = 0;
+        p_dev->b_overdrive = 1;
+        p_dev->state = E_DEV_FUNCTION;
+        break;
+    case DS2431_MATCH_ROM:
+        p_dev->state = E_DEV_MATCH;
+        break;
+    case DS2431_OD_MATCH_ROM:
+        p_dev->b_overdrive = 1; // the ROM ID follows at overdrive speed
+        p_dev->state = E_DEV_MATCH;
+        break;
+    case DS2431_SEARCH_ROM:
+        p_dev->state = E_DEV_SEARCH;
+        break;
+    case DS2431_RESUME:
+        p_dev->state = p_dev->b_resume ? E_DEV_FUNCTION : E_DEV_IDLE;
+        break;
+    default:
+        p_dev->state = E_DEV_IDLE;
+        break;
+    }
+}
+
+static void dev_function_command(ow_dev_t *p_dev, uint8_t command) {
+    uint8_t offset = p_dev->ta1 & (DS2431_ROW - 1);
+    uint8_t end = p_dev->es & (DS2431_ROW - 1);
+    uint8_t n = 0;
+    uint16_t crc;
+
+    p_dev->idx = 0;
+    if (p_dev->rom[0] != OW_MODEL_FAMILY) {
+        p_dev->state = E_DEV_IDLE; // accessory without memory
+        return;
+    }
+    switch (command) {
+    case DS2431_WRITE_SCRATCH:
+        p_dev->crc = crc16(0, &command, 1);
+        p_dev->state = E_DEV_WRITE_TA;
+        break;
+    case DS2431_READ_SCRATCH:
+        p_dev->answer[n++] = p_dev->ta1;
+        p_dev->answer[n++] = p_dev->ta2;
+        p_dev->answer[n++] = p_dev->es;
+        for (uint8_t i = offset; i <= end; i++) {
+            p_dev->answer[n++] = p_dev->scratch[i];
+        }
+        crc = ~crc16(crc16(0, &command, 1), p_dev->answer, n);
+        p_dev->answer[n++] = (uint8_t)crc;
+        p_dev->answer[n++] = (uint8_t)(crc >> 8);
+        p_dev->answer_len = n;
+        p_dev->state = E_DEV_SEND;
+        break;
+    case DS2431_COPY_SCRATCH:
+        p_dev->state = E_DEV_COPY_AUTH;
+        break;
+    case DS2431_READ_MEMORY:
+        p_dev->state = E_DEV_READ_MEM_TA;
+        break;
+    default:
+        p_dev->state = E_DEV_IDLE;
+        break;
+    }
+}
+
+static void dev_copy(ow_dev_t *p_dev) {
+    uint16_t target = p_dev->ta1 | (p_dev->ta2 << 8);
+    uint16_t row = target & ~(DS2431_ROW - 1);
+
+    p_dev->b_copied = 0;
+    if ((p_dev->es & DS2431_ES_PF) || (row >= DS2431_COPY_LIMIT) || ow_faults.b_copy_fail) {
+        return;
+    }
+    for (uint8_t i = target & (DS2431_ROW - 1); i <= (p_dev->es & (DS2431_ROW - 1)); i++) {
+        p_dev->mem[row + i] = p_dev->scratch[i];
+    }
+    p_dev->es |= DS2431_ES_AA;
+    p_dev->prog_until = sim_time_us() + ow_timing.tprog_us;
+    p_dev->b_copied = 1;
+    ow_stats.copies++;
+}
+
+static void dev_write(ow_dev_t *p_dev, uint8_t value) {
+    uint8_t b_match;
+
+    switch (p_dev->state) {
+    case E_DEV_ROM:
+        dev_rom_command(p_dev, value);
+        break;
+    case E_DEV_MATCH:
+        if (value != p_dev->rom[p_dev->idx]) {
+            p_dev->b_resume = 0;
+            p_dev->state = E_DEV_IDLE;
+        } else if (++p_dev->idx == 8) {
+            p_dev->b_resume = 1;
+            p_dev->state = E_DEV_FUNCTION;
+        }
+        break;
+    case E_DEV_FUNCTION:
+        dev_function_command(p_dev, value);
+        break;
+    case E_DEV_WRITE_TA:
+        p_dev->crc = crc16(p_dev->crc, &value, 1);
+        if (p_dev->idx++ == 0) {
+            p_dev->ta1 = value;
+            break;
+        }
+        p_dev->ta2 = value;
+        p_dev->es = (p_dev->ta1 & (DS2431_ROW - 1)) | DS2431_ES_PF; // no data byte yet
+        p_dev->idx = p_dev->ta1 & (DS2431_ROW - 1);
+        p_dev->answer_len = 0;
+        p_dev->state = (p_dev->ta2 == 0) && (p_dev->ta1 < OW_MODEL_MEM_SIZE) ? E_DEV_WRITE_DATA : E_DEV_IDLE;
+        break;
+    case E_DEV_WRITE_DATA:
+        if (p_dev->idx >= DS2431_ROW) {
+            p_dev->state = E_DEV_IDLE; // writing beyond the scratchpad
+            break;
+        }
+        p_dev->crc = crc16(p_dev->crc, &value, 1);
+        p_dev->scratch[p_dev->idx] = value;
+        p_dev->es = p_dev->idx++;
+        if (p_dev->idx == DS2431_ROW) {
+            /* the CRC16 is sent after the end of the scratchpad */
+            p_dev->crc = ~p_dev->crc;
+            p_dev->answer[0] = (uint8_t)p_dev->crc;
+            p_dev->answer[1] = (uint8_t)(p_dev->crc >> 8);
+            p_dev->answer_len = 2;
+            p_dev->idx = 0;
+            p_dev->state = E_DEV_SEND;
+        }
+        break;
+    case E_DEV_COPY_AUTH:
+        b_match = (value == ((p_dev->idx == 0) ? p_dev->ta1 : (p_dev->idx == 1) ? p_dev->ta2 : p_dev->es));
+        if (!b_match) {
+            p_dev->b_copied = 0;
+            p_dev->state = E_DEV_COPY_STATUS; // not authorized, nothing is programmed
+            break;
+        }
+        if (++p_dev->idx == 3) {
+            dev_copy(p_dev);
+            p_dev->state = E_DEV_COPY_STATUS;
+        }
+        break;
+    case E_DEV_READ_MEM_TA:
+        if (p_dev->idx++ == 0) {
+            p_dev->address = value;
+            break;
+        }
+        p_dev->address |= value << 8;
+        p_dev->state = E_DEV_READ_MEM;
+        break;
+    default:
+        p_dev->state = E_DEV_IDLE;
+        break;
+    }
+}
+
+static uint8_t dev_read(ow_dev_t *p_dev) {
+    switch (p_dev->state) {
+    case E_DEV_READ_ROM:
+        return (p_dev->idx < 8) ? p_dev->rom[p_dev->idx++] : 0xFF;
+    case E_DEV_SEND:
+        return (p_dev->idx < p_dev->answer_len) ? p_dev->answer[p_dev->idx++] : 0xFF;
+    case E_DEV_COPY_STATUS:
+        if (sim_time_us() < p_dev->prog_until) {
+            return 0xFF; // still programming
+        }
+        return p_dev->b_copied ? DS2431_COPY_STATUS : 0xFF;
+    case E_DEV_READ_MEM:
+        return (p_dev->address < OW_MODEL_MEM_SIZE) ? p_dev->mem[p_dev->address++] : 0xFF;
+    default:
+        return 0xFF;
+    }
+}
+
+static uint8_t bus_reset(void) {
+    uint8_t status = 0;
+
+    ow_stats.ow_resets++;
+    for (uint8_t i = 0; i < ow_device_count; i++) {
+        ow_dev_t *p_dev = &ow_devices[i];
+
+        if (sim_time_us() < p_dev->prog_until) {
+            ow_stats.violations++;
+        }
+        /* a reset at standard speed returns the devices to standard speed, an overdrive reset is too short for
+         * devices at standard speed */
+        if (!ow_speed()) {
+            p_dev->b_overdrive = 0;
+        }
+        if (p_dev->b_overdrive == ow_speed()) {
+            p_dev->state = E_DEV_ROM;
+            status |= DS2484_STS_PPD;
+        } else {
+            p_dev->state = E_DEV_IDLE;
+        }
+    }
+    if (ow_faults.b_no_device || ow_faults.b_short) {
+        status = ow_faults.b_short ? DS2484_STS_SD : 0;
+        for (uint8_t i = 0; i < ow_device_count; i++) {
+            ow_devices[i].state = E_DEV_IDLE;
+        }
+    }
+    return status;
+}
+
+static void bus_write(uint8_t value) {
+    ow_stats.ow_bytes++;
+    for (uint8_t i = 0; i < ow_device_count; i++) {
+        if (dev_active(&ow_devices[i])) {
+            dev_write(&ow_devices[i], value);
+        }
+    }
+}
+
+static uint8_t bus_read(void) {
+    uint8_t value = 0xFF;
+
+    ow_stats.ow_bytes++;
+    for (uint8_t i = 0; i < ow_device_count; i++) {
+        if (dev_active(&ow_devices[i])) {
+            value &= dev_read(&ow_devices[i]);
+        }
+    }
+    if (ow_faults.read_error_every && (!ow_faults.b_read_error_od || ow_speed()) &&
+        ((++ow_read_count % ow_faults.read_error_every) == 0)) {
+        value ^= 0x10;
+    }
+    return value;
+}
+
+static uint8_t bus_triplet(uint8_t b_dir) {
+    uint8_t b_id = 1, b_cmp = 1, b_any = 0, status = 0;
+
+    ow_stats.ow_triplets++;
+    for (uint8_t i = 0; i < ow_device_count; i++) {
+        ow_dev_t *p_dev = &ow_devices[i];
+
+        if (dev_active(p_dev) && (p_dev->state == E_DEV_SEARCH)) {
+            uint8_t bit = (p_dev->rom[p_dev->idx / 8] >> (p_dev->idx % 8)) & 1;
+
+            b_id &= bit;
+            b_cmp &= !bit;
+            b_any = 1;
+        }
+    }
+    if (!b_any) {
+        return DS2484_STS_SBR | DS2484_STS_TSB;
+    }
+    /* without discrepancy the direction follows the devices, otherwise the requested one */
+    if (b_id != b_cmp) {
+        b_dir = b_id;
+    }
+    for (uint8_t i = 0; i < ow_device_count; i++) {
+        ow_dev_t *p_dev = &ow_devices[i];
+
+        if ((p_dev->state != E_DEV_SEARCH) || (p_dev->b_overdrive != ow_speed())) {
+            continue;
+        }
+        if (((p_dev->rom[p_dev->idx / 8] >> (p_dev->idx % 8)) & 1) != b_dir) {
+            p_dev->b_resume = 0;
+            p_dev->state = E_DEV_IDLE;
+        } else if (++p_dev->idx == 64) {
+            p_dev->b_resume = 1;
+            p_dev->state = E_DEV_FUNCTION;
+        }
+    }
+    status |= b_id ? DS2484_STS_SBR : 0;
+    status |= b_cmp ? DS2484_STS_TSB : 0;
+    status |= b_dir ? DS2484_STS_DIR : 0;
+    return status;
+}
+
+/* the 1-Wire commands are not acknowledged while 1WB is set */
+static int ds2484_command(const uint8_t *p_data, uint16_t size) {
+    uint8_t speed = ow_speed();
+
+    if ((p_data[0] != DS2484_DEVICE_RESET) && (p_data[0] != DS2484_SET_READ_PTR) && ow_busy()) {
+        ow_stats.violations++;
+        return -1;
+    }
+    switch (p_data[0]) {
+    case DS2484_DEVICE_RESET:
+        memset(&ds2484, 0, sizeof(ds2484));
+        ds2484.status = DS2484_STS_RST;
+        ds2484.ptr = DS2484_PTR_STATUS;
+        break;
+    case DS2484_SET_READ_PTR:
+        if ((size < 2) || ((p_data[1] != DS2484_PTR_STATUS) && (p_data[1] != DS2484_PTR_DATA) &&
+                           (p_data[1] != DS2484_PTR_PORT) && (p_data[1] != DS2484_PTR_CONFIG))) {
+            return -1;
+        }
+        ds2484.ptr = p_data[1];
+        break;
+    case DS2484_WRITE_CONFIG:
+        if ((size < 2) || ((p_data[1] >> 4) != (~p_data[1] & 0x0F))) {
+            return -1;
+        }
+        ds2484.config = p_data[1] & 0x0F;
+        ds2484.status &= ~DS2484_STS_RST;
+        ds2484.ptr = DS2484_PTR_CONFIG;
+        break;
+    case DS2484_ADJUST_PORT:
+        for (uint16_t i = 1; i < size; i++) {
+            uint8_t param = p_data[i] >> 5;
+            uint8_t index = (param < 3) ? ((param * 2) + ((p_data[i] >> 4) & 1)) : (param + 3);
+
+            if (index < sizeof(ds2484.port)) {
+                ds2484.port[index] = p_data[i] & 0x0F;
+            }
+        }
+        ds2484.ptr = DS2484_PTR_PORT;
+        break;
+    case DS2484_1WIRE_RESET:
+        ds2484.status = bus_reset();
+        ds2484.ptr = DS2484_PTR_STATUS;
+        ow_start(ow_timing.reset_us[speed]);
+        break;
+    case DS2484_1WIRE_BIT:
+        if (size < 2) {
+            return -1;
+        }
+        ds2484.status = (p_data[1] & 0x80) ? DS2484_STS_SBR : 0;
+        ds2484.ptr = DS2484_PTR_STATUS;
+        ow_start(ow_timing.slot_us[speed]);
+        break;
+    case DS2484_1WIRE_WRITE:
+        if (size < 2) {
+            return -1;
+        }
+        bus_write(p_data[1]);
+        ds2484.status = 0;
+        ds2484.ptr = DS2484_PTR_STATUS;
+        ow_start(8 * ow_timing.slot_us[speed]);
+        break;
+    case DS2484_1WIRE_READ:
+        ds2484.data = bus_read();
+        ds2484.status = 0;
+        ds2484.ptr = DS2484_PTR_STATUS;
+        ow_start(8 * ow_timing.slot_us[speed]);
+        break;
+    case DS2484_1WIRE_TRIPLET:
+        if (size < 2) {
+            return -1;
+        }
+        ds2484.status = bus_triplet((p_data[1] & 0x80) ? 1 : 0);
+        ds2484.ptr = DS2484_PTR_STATUS;
+        ow_start(3 * ow_timing.slot_us[speed]);
+        break;
+    default:
+        return -1;
+    }
+    return 0;
+}
+
+static void ds2484_read(uint8_t *p_data, uint16_t size) {
+    for (uint16_t i = 0; i < size; i++) {
+        switch (ds2484.ptr) {
+        case DS2484_PTR_STATUS:
+            p_data[i] = ds2484.status;
+            if (ow_busy()) {
+                p_data[i] |= DS2484_STS_1WB;
+                ow_stats.busy_polls++;
+            }
+            break;
+        case DS2484_PTR_DATA:
+            if (ow_busy()) {
+                ow_stats.violations++; // byte not yet received
+            }
+            p_data[i] = ds2484.data;
+            break;
+        case DS2484_PTR_PORT:
+            p_data[i] = ds2484.port[i % sizeof(ds2484.port)];
+            break;
+        default:
+            p_data[i] = ds2484.config;
+            break;
+        }
+    }
+}
+
+static int i2c_transfer(uint8_t address, uint16_t bytes) {
+    ow_stats.i2c_transfers++;
+    ow_stats.i2c_bytes += bytes;
+    ow_stats.i2c_busy_us += ow_model_i2c_us(bytes);
+    if (((address >> 1) != OW_MODEL_I2C_ADDRESS) || (ow_stats.i2c_transfers == ow_faults.i2c_nack_at)) {
+        ow_stats.i2c_nacks++;
+        return -1;
+    }
+    return 0;
+}
+
+/******************************************************************************
+** Name               : @fn ow_model_init
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function sets the model to power on: the DS2484 after reset, one DS2431 with
+**                       cleared memory on the bus, default timing and no faults.
+**
+** Calling            : @remark before each scenario
+**
+** InputValues        : @param none
+**
+** OutputValues       : @retval none
+******************************************************************************/
+void ow_model_init(void) {
+    static const uint8_t serial[6] = {0x31, 0x24, 0x84, 0x00, 0x00, 0x01};
+
+    memset(&ds2484, 0, sizeof(ds2484));
+    ds2484.status = DS2484_STS_RST;
+    ds2484.ptr = DS2484_PTR_STATUS;
+    memset(ow_devices, 0, sizeof(ow_devices));
+    ow_device_count = 0;
+    memset(&ow_faults, 0, sizeof(ow_faults));
+    ow_model_clear_stats();
+
+    /* DS2484 and DS2431 data sheet values at the default port configuration, 100 kHz I2C as hi2cOneWire */
+    ow_timing.i2c_khz = 100;
+    ow_timing.i2c_irq_us = 2;
+    ow_timing.reset_us[0] = 1148;
+    ow_timing.reset_us[1] = 146;
+    ow_timing.slot_us[0] = 69;
+    ow_timing.slot_us[1] = 11;
+    ow_timing.tprog_us = 10000;
+
+    ow_model_add_device(OW_MODEL_FAMILY, serial);
+}
+
+/******************************************************************************
+** Name               : @fn ow_model_add_device
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function adds a device to the 1-Wire bus. Only devices with the DS2431 family
+**                       code have the memory functions.
+**
+** Calling            : @remark scenarios
+**
+** InputValues        : @param uint8_t family which is the family code
+**                             const uint8_t serial[6] which is the serial number, LSB first
+**
+** OutputValues       : @retval index of the device, -1 if the bus is full.
+******************************************************************************/
+int ow_model_add_device(uint8_t family, const uint8_t serial[6]) {
+    ow_dev_t *p_dev;
+
+    if (ow_device_count >= OW_MODEL_DEVICES) {
+        return -1;
+    }
+    p_dev = &ow_devices[ow_device_count];
+    memset(p_dev, 0, sizeof(*p_dev));
+    p_dev->rom[0] = family;
+    memcpy(&p_dev->rom[1], serial, 6);
+    p_dev->rom[7] = crc8(0, p_dev->rom, 7);
+    p_dev->mem[0x85] = 0x55; // factory byte
+    return ow_device_count++;
+}
+
+uint8_t *ow_model_memory(uint8_t device) {
+    return ow_devices[device].mem;
+}
+
+void ow_model_rom_id(uint8_t device, uint8_t rom[8]) {
+    memcpy(rom, ow_devices[device].rom, 8);
+}
+
+ow_model_timing_t *ow_model_timing(void) {
+    return &ow_timing;
+}
+
+ow_model_faults_t *ow_model_faults(void) {
+    return &ow_faults;
+}
+
+void ow_model_get_stats(ow_model_stats_t *p_stats) {
+    *p_stats = ow_stats;
+}
+
+void ow_model_clear_stats(void) {
+    memset(&ow_stats, 0, sizeof(ow_stats));
+    ow_read_count = 0;
+}
+
+/******************************************************************************
+** Name               : @fn ow_model_i2c_us
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function returns the duration of an I2C transfer: 9 clocks per byte and
+**                       2 clocks for start and stop.
+**
+** Calling            : @remark hal_sim.c
+**
+** InputValues        : @param uint16_t bytes which is the number of bytes including the address bytes
+**
+** OutputValues       : @retval duration in us.
+******************************************************************************/
+uint32_t ow_model_i2c_us(uint16_t bytes) {
+    return ((bytes * 9u) + 2u) * 1000u / ow_timing.i2c_khz;
+}
+
+int ow_model_i2c_write(uint8_t address, const uint8_t *p_data, uint16_t size) {
+    if (i2c_transfer(address, 1 + size) != 0) {
+        return -1;
+    }
+    if (size == 0) {
+        return 0;
+    }
+    return ds2484_command(p_data, size);
+}
+
+int ow_model_i2c_read(uint8_t address, uint8_t *p_data, uint16_t size) {
+    if (i2c_transfer(address, 1 + size) != 0) {
+        return -1;
+    }
+    ds2484_read(p_data, size);
+    return 0;
+}
+
+/******************************************************************************
+** Name               : @fn ow_model_i2c_mem_read
+**
+** Created from /on   : @author / @date 18.10.2026
+**
+** Description        : @brief This function handles a memory read of the HAL: the 16-bit memory address is the
+**                       SET READ POINTER command with its pointer code, then the register is read after a
+**                       repeated start.
+**
+** Calling            : @remark hal_sim.c
+**
+** InputValues        : @param uint8_t address which is the I2C address
+**                             uint16_t mem_address which is the command byte and its parameter
+**                             uint8_t *p_data which receives the data
+**                             uint16_t size which is the number of bytes
+**
+** OutputValues       : @retval 0 if acknowledged, -1 if not.
+******************************************************************************/
+int ow_model_i2c_mem_read(uint8_t address, uint16_t mem_address, uint8_t *p_data, uint16_t size) {
+    uint8_t command[2] = {(uint8_t)(mem_address >> 8), (uint8_t)mem_address};
+
+    if ((i2c_transfer(address, 1 + 2 + 1 + size) != 0) || (ds2484_command(command, sizeof(command)) != 0)) {
+        return -1;
+    }
+    ds2484_read(p_data, size);
+    return 0;
+}
@@ -0,0 +1,86 @@
+/******************************************************************************
+** @file ow_model.h
+** @author
+** @brief Host simulation: behavioral model of the DS2484 I2C to 1-Wire
+**        bridge and of the devices on its 1-Wire bus, DS2431 EEPROMs and
+**        accessories which only answer the ROM commands.
+**
+**        DS2484: device reset, read pointer, device and port configuration,
+**        1-Wire reset, byte, single bit and triplet commands. The 1WB bit of
+**        the status register stays set for the duration of the 1-Wire
+**        operation on the simulated clock.
+**        DS2431: ROM ID with CRC8, READ/SKIP/MATCH/SEARCH ROM, RESUME,
+**        overdrive SKIP and MATCH ROM, scratchpad with TA1, TA2 and E/S,
+**        inverted CRC16 of WRITE and READ SCRATCHPAD, COPY SCRATCHPAD with
+**        authorization, programming time and AA status, READ MEMORY.
+******************************************************************************/
+
+#ifndef _OW_MODEL_H
+#define _OW_MODEL_H
+
+/*** Include *****************************************************************/
+#include <stdint.h>
+/* NO MORE DEFINITIONS */
+
+/*** Preprocessor definitions ************************************************/
+#define OW_MODEL_I2C_ADDRESS 0x18 // 7-bit I2C address of the DS2484
+#define OW_MODEL_DEVICES     4    // devices on the 1-Wire bus
+#define OW_MODEL_MEM_SIZE    144  // DS2431 memory: 128 bytes data, 16 bytes registers
+#define OW_MODEL_FAMILY      0x2D // family code of the DS2431
+/* NO MORE DEFINITIONS */
+
+/*** Definition of variables *************************************************/
+/* latencies, index 0 standard speed, index 1 overdrive */
+typedef struct {
+    uint32_t i2c_khz;     // I2C clock
+    uint32_t i2c_irq_us;  // interrupt latency of each interrupt transfer
+    uint32_t reset_us[2]; // 1-Wire reset and presence detect
+    uint32_t slot_us[2];  // 1-Wire time slot, a byte takes 8 slots and a triplet 3
+    uint32_t tprog_us;    // programming time of COPY SCRATCHPAD
+} ow_model_timing_t;
+
+/* injected faults, counters start at 1, 0 = off */
+typedef struct {
+    uint8_t b_no_device;       // no presence pulse
+    uint8_t b_short;           // short on the 1-Wire line
+    uint8_t b_copy_fail;       // COPY SCRATCHPAD programs nothing and reads 0xFF
+    uint8_t b_read_error_od;   // read_error_every only at overdrive speed
+    uint32_t read_error_every; // every n-th 1-Wire byte read has a bit error
+    uint32_t i2c_nack_at;      // the n-th I2C transfer is not acknowledged
+    uint32_t i2c_stall_at;     // the n-th I2C interrupt transfer never completes
+} ow_model_faults_t;
+
+/* bus activity since ow_model_init() or ow_model_clear_stats() */
+typedef struct {
+    uint32_t i2c_transfers;   // I2C transfers, a memory read counts once
+    uint32_t i2c_bytes;       // I2C bytes including the address bytes
+    uint32_t i2c_nacks;       // transfers not acknowledged
+    uint32_t ow_resets;       // 1-Wire resets
+    uint32_t ow_bytes;        // 1-Wire bytes written and read
+    uint32_t ow_triplets;     // 1-Wire triplets
+    uint32_t busy_polls;      // status reads with 1WB set
+    uint32_t copies;          // programmed EEPROM rows
+    uint32_t violations;      // commands while 1WB is set, data read while busy, bus activity during tPROG
+    uint64_t i2c_busy_us;     // time the I2C bus was busy
+    uint64_t ow_busy_us;      // time the 1-Wire line was busy
+} ow_model_stats_t;
+/* NO MORE DEFINITIONS */
+
+/*** Prototypes of functions *************************************************/
+void ow_model_init(void);
+int ow_model_add_device(uint8_t family, const uint8_t serial[6]);
+uint8_t *ow_model_memory(uint8_t device);
+void ow_model_rom_id(uint8_t device, uint8_t rom[8]);
+ow_model_timing_t *ow_model_timing(void);
+ow_model_faults_t *ow_model_faults(void);
+void ow_model_get_stats(ow_model_stats_t *p_stats);
+void ow_model_clear_stats(void);
+
+/* I2C side, called by hal_sim.c at the end of a transfer. 0 = acknowledged, -1 = not acknowledged */
+uint32_t ow_model_i2c_us(uint16_t bytes);
+int ow_model_i2c_write(uint8_t address, const uint8_t *p_data, uint16_t size);
+int ow_model_i2c_read(uint8_t address, uint8_t *p_data, uint16_t size);
+int ow_model_i2c_mem_read(uint8_t address, uint16_t mem_address, uint8_t *p_data, uint16_t size);
+/* NO MORE DEFINITIONS */
+
+#endif //_OW_MODEL_H
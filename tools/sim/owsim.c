@@ -0,0 +1,396 @@
+/******************************************************************************
+** @file owsim.c
+** @author
+** @brief Host simulation of the 1-Wire drivers Core/DS2484.c and
+**        Core/DS2431.c against the DS2484/DS2431 model. Each scenario runs
+**        in its own process from power on, the measured part is reported
+**        with the simulated time and the bus traffic, so driver changes
+**        can be compared by numbers.
+**
+**        make -C tools/sim owsim && tools/sim/owsim [-k kHz] [-l us] [-s name]
+******************************************************************************/
+
+/*** Include *****************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "stm32g4xx_hal.h"
+#include "DS2484.h"
+#include "DS2431.h"
+#include "hal_sim.h"
+#include "ow_model.h"
+/* NO MORE DEFINITIONS */
+
+/*** Preprocessor definitions ************************************************/
+#define OWSIM_WAIT_US  2000000 // limit of an asynchronous transaction
+#define OWSIM_NOTE_LEN 64
+/* NO MORE DEFINITIONS */
+
+/*** Definition of variables *************************************************/
+typedef struct {
+    const char *p_name;
+    int (*p_run)(void); // 0 = pass
+} owsim_scenario_t;
+
+extern owParamPage1 st_OwParamPage1;
+extern owParamPage2 st_OwParamPage2;
+extern owParamPage3 st_OwParamPage3;
+extern owParamPage4 st_OwParamPage4;
+
+static uint32_t owsim_loop_us = 1000; // main loop period, ow_async_process() is called once per pass
+static uint32_t owsim_i2c_khz = 100;
+static volatile HAL_StatusTypeDef owsim_status;
+static uint64_t owsim_start_us;
+static char owsim_note[OWSIM_NOTE_LEN];
+/* NO MORE DEFINITIONS */
+
+/*** Definitions of functions ************************************************/
+static void owsim_done(HAL_StatusTypeDef status) {
+    owsim_status = status;
+}
+
+/* main loop until the asynchronous transaction is done */
+static HAL_StatusTypeDef owsim_async(HAL_StatusTypeDef start) {
+    uint64_t limit = sim_time_us() + OWSIM_WAIT_US;
+
+    if (start != HAL_OK) {
+        return start;
+    }
+    while ((owsim_status == HAL_BUSY) && (sim_time_us() < limit)) {
+        ow_async_process();
+        sim_advance(owsim_loop_us);
+    }
+    return owsim_status;
+}
+
+#define OWSIM_ASYNC(call) (owsim_status = HAL_BUSY, owsim_async(call))
+
+/* begin of the measured part of a scenario */
+static void owsim_measure(void) {
+    owsim_start_us = sim_time_us();
+    ow_model_clear_stats();
+    ow_clear_stats_ds2484();
+}
+
+static int owsim_fail(const char *p_note) {
+    snprintf(owsim_note, sizeof(owsim_note), "%s", p_note);
+    return 1;
+}
+
+static void owsim_fill_memory(void) {
+    uint8_t *p_mem = ow_model_memory(0);
+
+    for (uint16_t i = 0; i < 0x80; i++) {
+        p_mem[i] = (uint8_t)((i * 7) + 3);
+    }
+}
+
+static int owsim_check_pages(void) {
+    uint8_t *p_mem = ow_model_memory(0);
+
+    if (memcmp(&st_OwParamPage1, &p_mem[0x00], BYTES_PER_PAGE) || memcmp(&st_OwParamPage2, &p_mem[0x20], BYTES_PER_PAGE) ||
+        memcmp(&st_OwParamPage3, &p_mem[0x40], BYTES_PER_PAGE) || memcmp(&st_OwParamPage4, &p_mem[0x60], BYTES_PER_PAGE)) {
+        return owsim_fail("pages differ from the EEPROM");
+    }
+    return 0;
+}
+
+static int owsim_check_rom(void) {
+    uint8_t rom[8], split[8];
+
+    ow_model_rom_id(0, rom);
+    ow_split_ROMID_ds2431(split);
+    return memcmp(rom, split, sizeof(rom)) ? owsim_fail("wrong ROM ID") : 0;
+}
+
+/* boot as the firmware: setup, ROM ID and all pages by asynchronous transactions */
+static int owsim_boot(void) {
+    HAL_StatusTypeDef status;
+
+    update_chipstatus(ow_setup_ds2484());
+    status = OWSIM_ASYNC(ow_read_ROMID_async_ds2431(owsim_done));
+    if (status != HAL_OK) {
+        status = ow_search_rom_ds2431();
+        update_chipstatus(status);
+    }
+    if (status == HAL_OK) {
+        status = OWSIM_ASYNC(owParamPage_read_all_async_ds2431(owsim_done));
+    }
+    return (status == HAL_OK) ? 0 : owsim_fail("boot failed");
+}
+
+static int scenario_setup(void) {
+    owsim_measure();
+    return (ow_setup_ds2484() == HAL_OK) ? 0 : owsim_fail("setup failed");
+}
+
+static int scenario_boot_blocking(void) {
+    owsim_fill_memory();
+    owsim_measure();
+    update_chipstatus(ow_setup_ds2484());
+    if (ow_read_ROMID_ds2431() != HAL_OK) {
+        return owsim_fail("ROM ID failed");
+    }
+    if (owParamPage_init_ds2431() != HAL_OK) {
+        return owsim_fail("page read failed");
+    }
+    return owsim_check_rom() || owsim_check_pages();
+}
+
+static int scenario_boot_async(void) {
+    owsim_fill_memory();
+    owsim_measure();
+    return owsim_boot() || owsim_check_rom() || owsim_check_pages();
+}
+
+static int scenario_torch_type(void) {
+    uint32_t torch_type = undef;
+    uint8_t *p_mem = ow_model_memory(0);
+
+    memset(p_mem, 0, 0x80);
+    if (owsim_boot()) {
+        return 1;
+    }
+    owsim_measure();
+    /* the driver answers "written" once the write flag is set, also after its own write */
+    if (ow_Write_TorchType(u400W) != CMD_BKCTORCH_TYPE_WRITTEN) {
+        return owsim_fail("write failed");
+    }
+    if ((ow_read_TorchType(&torch_type) != CMD_BKCTEST_PASS) || (torch_type != u400W)) {
+        return owsim_fail("read back failed");
+    }
+    if ((p_mem[0x40] != 1) || (p_mem[0x44] != u400W)) {
+        return owsim_fail("EEPROM not written");
+    }
+    return 0;
+}
+
+static int scenario_bkc_test(void) {
+    uint8_t *p_mem = ow_model_memory(0);
+
+    owsim_fill_memory();
+    if (owsim_boot()) {
+        return 1;
+    }
+    owsim_measure();
+    if (ow_BKCTest() != CMD_BKCTEST_PASS) {
+        return owsim_fail("BKC test failed");
+    }
+    for (uint8_t i = 0; i < 8; i++) {
+        if ((p_mem[0x60 + (i * 4)] != i) || (p_mem[0x61 + (i * 4)] != 0x44)) {
+            return owsim_fail("EEPROM not written");
+        }
+    }
+    return 0;
+}
+
+static int scenario_row_async(void) {
+    uint64_t value = 0x0123456789ABCDEFull;
+    uint8_t *p_mem = ow_model_memory(0);
+
+    owsim_fill_memory();
+    if (owsim_boot()) {
+        return 1;
+    }
+    owsim_measure();
+    if (OWSIM_ASYNC(ow_write_mem_row_async_ds2431(Page2, value, 8, owsim_done)) != HAL_OK) {
+        return owsim_fail("row write failed");
+    }
+    return memcmp(&p_mem[0x28], &value, sizeof(value)) ? owsim_fail("EEPROM not written") : 0;
+}
+
+static int scenario_search(void) {
+    static const uint8_t serial[6] = {0x10, 0x20, 0x30, 0x40, 0x50, 0x60};
+    uint8_t *p_mem = ow_model_memory(0);
+
+    ow_model_add_device(0x28, serial); // accessory without memory
+    owsim_fill_memory();
+    owsim_measure();
+    if (owsim_boot()) {
+        return 1;
+    }
+    if (ow_rom_count_ds2431() != 2) {
+        return owsim_fail("devices not found");
+    }
+    if (owsim_check_pages() || (ow_BKCTest() != CMD_BKCTEST_PASS)) {
+        return owsim_fail("EEPROM not selected");
+    }
+    return (p_mem[0x61] != 0x44) ? owsim_fail("EEPROM not written") : 0;
+}
+
+static int scenario_no_device(void) {
+    ow_model_faults()->b_no_device = 1;
+    owsim_measure();
+    update_chipstatus(ow_setup_ds2484());
+    update_chipstatus(ow_read_ROMID_ds2431());
+    if (ow_BKCTest() != CMD_BKCTEST_FAIL) {
+        return owsim_fail("missing device not detected");
+    }
+    return 0;
+}
+
+static int scenario_bit_error(void) {
+    ow_model_stats_t stats;
+
+    if (owsim_boot()) {
+        return 1;
+    }
+    ow_model_faults()->read_error_every = 1;
+    owsim_measure();
+    if (ow_Write_TorchType(u320W) != CMD_BKCTEST_FAIL) {
+        return owsim_fail("corrupt scratchpad not detected");
+    }
+    ow_model_get_stats(&stats);
+    return stats.copies ? owsim_fail("corrupt scratchpad copied") : 0;
+}
+
+static int scenario_copy_fail(void) {
+    if (owsim_boot()) {
+        return 1;
+    }
+    ow_model_faults()->b_copy_fail = 1;
+    owsim_measure();
+    return (ow_Write_TorchType(u320W) != CMD_BKCTEST_FAIL) ? owsim_fail("copy failure not detected") : 0;
+}
+
+static int scenario_i2c_stall(void) {
+    owsim_fill_memory();
+    update_chipstatus(ow_setup_ds2484());
+    ow_model_faults()->i2c_stall_at = 5;
+    owsim_measure();
+    if (OWSIM_ASYNC(ow_read_ROMID_async_ds2431(owsim_done)) != HAL_TIMEOUT) {
+        return owsim_fail("stalled transfer not aborted");
+    }
+    if (OWSIM_ASYNC(ow_read_ROMID_async_ds2431(owsim_done)) != HAL_OK) {
+        return owsim_fail("no recovery after the abort");
+    }
+    return owsim_check_rom();
+}
+
+static int scenario_i2c_nack(void) {
+    owsim_fill_memory();
+    update_chipstatus(ow_setup_ds2484());
+    owsim_measure();
+    ow_model_faults()->i2c_nack_at = 6; // counted from the measure start
+    if (OWSIM_ASYNC(ow_read_ROMID_async_ds2431(owsim_done)) != HAL_ERROR) {
+        return owsim_fail("NACK not detected");
+    }
+    return (OWSIM_ASYNC(owParamPage_read_all_async_ds2431(owsim_done)) == HAL_OK) ? owsim_check_pages()
+                                                                                   : owsim_fail("no recovery");
+}
+
+#if DS2431_OVERDRIVE
+static int scenario_overdrive_fallback(void) {
+    uint32_t torch_type = undef;
+
+    memset(ow_model_memory(0), 0, 0x80);
+    if (owsim_boot()) {
+        return 1;
+    }
+    ow_model_faults()->b_read_error_od = 1;
+    ow_model_faults()->read_error_every = 1;
+    owsim_measure();
+    if (ow_Write_TorchType(u500W) != CMD_BKCTORCH_TYPE_WRITTEN) {
+        return owsim_fail("no fallback to standard speed");
+    }
+    ow_read_TorchType(&torch_type);
+    return (ow_model_memory(0)[0x44] != u500W) ? owsim_fail("EEPROM not written") : 0;
+}
+#endif
+
+static const owsim_scenario_t owsim_scenarios[] = {
+    {"setup", scenario_setup},
+    {"boot blocking", scenario_boot_blocking},
+    {"boot async", scenario_boot_async},
+    {"torch type write", scenario_torch_type},
+    {"BKC test", scenario_bkc_test},
+    {"row write async", scenario_row_async},
+    {"search 2 devices", scenario_search},
+    {"no device", scenario_no_device},
+    {"read bit error", scenario_bit_error},
+    {"copy failure", scenario_copy_fail},
+    {"I2C stall", scenario_i2c_stall},
+    {"I2C NACK", scenario_i2c_nack},
+#if DS2431_OVERDRIVE
+    {"overdrive fallback", scenario_overdrive_fallback},
+#endif
+};
+
+/* runs a scenario from power on and prints its report line, 0 = pass */
+static int owsim_run(const owsim_scenario_t *p_scenario) {
+    ow_model_stats_t stats;
+    ow_stats_t drv_stats;
+    int result;
+
+    sim_reset();
+    ow_model_init();
+    ow_model_timing()->i2c_khz = owsim_i2c_khz;
+    owsim_note[0] = '\0';
+    owsim_measure();
+
+    result = p_scenario->p_run();
+
+    ow_model_get_stats(&stats);
+    ow_get_stats_ds2484(&drv_stats);
+    if (!result && stats.violations) {
+        result = owsim_fail("timing violation");
+    }
+    printf("%-20s %-4s %9.3f %6u %6u %6u %6u %6u %6u %6u %5u %5u  %s\n", p_scenario->p_name, result ? "FAIL" : "ok",
+           (sim_time_us() - owsim_start_us) / 1000.0, stats.i2c_transfers, drv_stats.i2c_transfers, stats.i2c_bytes,
+           stats.ow_resets, stats.ow_bytes, stats.ow_triplets, stats.busy_polls, stats.copies, stats.violations,
+           owsim_note);
+    return result;
+}
+
+int main(int argc, char *argv[]) {
+    const char *p_only = NULL;
+    int opt, failed = 0;
+
+    while ((opt = getopt(argc, argv, "k:l:s:")) != -1) {
+        switch (opt) {
+        case 'k':
+            owsim_i2c_khz = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'l':
+            owsim_loop_us = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            p_only = optarg;
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-k I2C kHz] [-l main loop us] [-s scenario]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (!owsim_i2c_khz || !owsim_loop_us) {
+        fprintf(stderr, "I2C clock and main loop period must not be 0\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("DS2431 %s speed, I2C %u kHz, main loop %u us\n", DS2431_OVERDRIVE ? "overdrive" : "standard", owsim_i2c_khz,
+           owsim_loop_us);
+    printf("%-20s %-4s %9s %6s %6s %6s %6s %6s %6s %6s %5s %5s\n", "scenario", "", "ms", "I2C", "drvI2C", "bytes",
+           "resets", "1Wbyte", "tripl", "polls", "copy", "viol");
+    for (size_t i = 0; i < sizeof(owsim_scenarios) / sizeof(owsim_scenarios[0]); i++) {
+        pid_t pid;
+        int status;
+
+        if (p_only && strcmp(p_only, owsim_scenarios[i].p_name)) {
+            continue;
+        }
+        /* the drivers keep their state in static variables, so each scenario gets a fresh process */
+        fflush(stdout);
+        pid = fork();
+        if (pid == 0) {
+            exit(owsim_run(&owsim_scenarios[i]) ? EXIT_FAILURE : EXIT_SUCCESS);
+        }
+        if ((pid < 0) || (waitpid(pid, &status, 0) < 0) || !WIFEXITED(status) || WEXITSTATUS(status)) {
+            failed++;
+        }
+    }
+    printf("%d scenario(s) failed\n", failed);
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,549 @@
+/******************************************************************************
+** @file tbsim.c
+** @author
+** @brief Host simulation of the end-of-line test Core/TestBoard.c with the
+**        CAN, key and 1-Wire modules of the firmware. The keys are GPIO
+**        inputs with EXTI lines, TIM16 samples them every 10 ms and the
+**        TIM17 compare takes the torch switch over once it settled, FDCAN2
+**        talks to a scripted test rig and the BKC test runs on the
+**        DS2484/DS2431 model. The main loop keeps TIM16 disabled during the
+**        emulated EwProcess() as the firmware does. Each scenario runs in
+**        its own process from power on and is reported with the step times
+**        the test rig reads by CO_GET_TESTTIME.
+**
+**        make -C tools/sim tbsim && tools/sim/tbsim [-g us] [-l us] [-s name] [-v]
+******************************************************************************/
+
+/*** Include *****************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "stm32g4xx_hal.h"
+#include "main.h"
+#include "TestBoard.h"
+#include "fdcan2.h"
+#include "timers.h"
+#include "inout.h"
+#include "msg.h"
+#include "DS2484.h"
+#include "DS2431.h"
+#include "eeprom_job.h"
+#include "cpu_load.h"
+#include "boot.h"
+#include "led.h"
+#include "serial.h"
+#include "bootloader_util.h"
+#include "hal_sim.h"
+#include "ow_model.h"
+/* NO MORE DEFINITIONS */
+
+/*** Preprocessor definitions ************************************************/
+#define TBSIM_NOTE_LEN    64
+#define TBSIM_SERIAL_LEN  4096
+#define TBSIM_ACK_US      2000     // answer time of the test rig
+#define TBSIM_TEST_MAX_MS 70000    // limit of a test run, all steps time out within 60 s
+#define TBSIM_PRESS_MS    100      // key held
+#define TBSIM_GAP_MS      200      // between two keys
+#define TBSIM_SETTLE_US   2000     // KEY_SETTLE_US of inout.c
+#define TBSIM_SEND_US     1000     // from the edge or the settle time to the end of the inputs message
+#define TBSIM_TICK_MS     10       // TIM16 period
+/* NO MORE DEFINITIONS */
+
+/*** Definition of variables *************************************************/
+typedef struct {
+    const char *p_name;
+    int (*p_run)(void); // 0 = pass
+} tbsim_scenario_t;
+
+/* key of the board, pressed at high level except the torch switch */
+typedef struct {
+    GPIO_TypeDef *p_port;
+    uint16_t pin;
+    uint8_t b_low;
+} tbsim_key_t;
+
+enum { TBSIM_UP, TBSIM_DOWN, TBSIM_LEFT, TBSIM_RIGHT, TBSIM_TORCH, TBSIM_KEY_N };
+
+static const tbsim_key_t tbsim_keys[TBSIM_KEY_N] = {
+    {BUTTON_UP_GPIO_Port, BUTTON_UP_Pin, 0},
+    {BUTTON_DOWN_GPIO_Port, BUTTON_DOWN_Pin, 0},
+    {BUTTON_LEFT_GPIO_Port, BUTTON_LEFT_Pin, 0},
+    {BUTTON_RIGHT_GPIO_Port, BUTTON_RIGHT_Pin, 0},
+    {TORCH_SWITCH_GPIO_Port, TORCH_SWITCH_Pin, 1},
+};
+
+extern test_result_status_t TestResult;
+extern test_stage_t e_TestStage;
+
+SE_FwExchgData_TypeDef BL_ExcData;
+
+static uint32_t tbsim_gui_us = 2000; // EwProcess() of a main loop pass, TIM16 is disabled meanwhile
+static uint32_t tbsim_loop_us = 500; // rest of a main loop pass
+static int tbsim_b_verbose;
+static uint8_t tbsim_b_ack; // the test rig acknowledges the CAN test message
+static char tbsim_note[TBSIM_NOTE_LEN];
+static char tbsim_serial[TBSIM_SERIAL_LEN];
+static size_t tbsim_serial_len;
+/* NO MORE DEFINITIONS */
+
+/*** Firmware services without simulation ************************************/
+void Serial_COM_PutString(char *pString) {
+    size_t len = strlen(pString);
+
+    if (len > (sizeof(tbsim_serial) - 1 - tbsim_serial_len)) {
+        len = sizeof(tbsim_serial) - 1 - tbsim_serial_len;
+    }
+    memcpy(&tbsim_serial[tbsim_serial_len], pString, len);
+    tbsim_serial_len += len;
+    tbsim_serial[tbsim_serial_len] = '\0';
+}
+
+void Serial_COM_GetLogStats(serial_log_stats_t *p_stats) {
+    memset(p_stats, 0, sizeof(*p_stats));
+}
+
+const led_pattern_t led_pattern_off;
+const led_pattern_t led_pattern_on;
+const led_pattern_t led_pattern_half;
+const led_pattern_t led_pattern_blink;
+const led_pattern_t led_pattern_blink_3;
+const led_pattern_t led_pattern_pass;
+const led_pattern_t led_pattern_fail;
+
+void led_set_pattern(led_t led, const led_pattern_t *p_pattern) {
+    (void)led;
+    (void)p_pattern;
+}
+
+void led_process(void) {
+}
+
+/* the boot sequence is done by tbsim_boot() */
+int boot_done(void) {
+    return 1;
+}
+
+uint16_t boot_get_time(uint8_t index) {
+    (void)index;
+    return 0;
+}
+
+void cpu_load_isr_enter(cpu_isr_t isr, cpu_isr_frame_t *p_frame) {
+    (void)isr;
+    (void)p_frame;
+}
+
+void cpu_load_isr_exit(cpu_isr_t isr, const cpu_isr_frame_t *p_frame) {
+    (void)isr;
+    (void)p_frame;
+}
+
+void cpu_load_get_can(uint8_t select, uint8_t data[4]) {
+    (void)select;
+    memset(data, 0, 4);
+}
+
+int CoreRoot__DriveKeyboardHitting(CoreRoot _this, CoreKeyCode aCode, unsigned short aCharCode, int aDown) {
+    (void)_this;
+    (void)aCode;
+    (void)aCharCode;
+    (void)aDown;
+    return 0;
+}
+
+void Error_Handler(void) {
+    fprintf(stderr, "Error_Handler() at %.3f ms\n", sim_time_us() / 1000.0);
+    exit(EXIT_FAILURE);
+}
+
+/*** Definitions of functions ************************************************/
+static int tbsim_fail(const char *p_note) {
+    snprintf(tbsim_note, sizeof(tbsim_note), "%s", p_note);
+    return 1;
+}
+
+/* test rig: answers the CAN test message of TestCAN_begin() with "ACK" */
+static void tbsim_rig_ack(void *p_arg) {
+    static const uint8_t ack[8] = {0, 0, 0, 'A', 'C', 'K', 0, 0};
+
+    (void)p_arg;
+    sim_can_receive(MSG_0x200, ack);
+}
+
+static void tbsim_rig(const sim_can_frame_t *p_frame) {
+    if ((p_frame->id == MSG_0x200) && !memcmp(p_frame->data, "CANTEST", 7) && tbsim_b_ack) {
+        sim_event_add(p_frame->us + TBSIM_ACK_US, tbsim_rig_ack, NULL);
+    }
+}
+
+/* main loop passes of the firmware for the given time */
+static void tbsim_run(uint32_t ms) {
+    uint64_t end = sim_time_us() + ((uint64_t)ms * 1000);
+
+    while (sim_time_us() < end) {
+        HAL_NVIC_DisableIRQ(TIM1_UP_TIM16_IRQn);
+        sim_advance(tbsim_gui_us);
+        HAL_NVIC_EnableIRQ(TIM1_UP_TIM16_IRQn);
+        sim_advance(0); // a pending TIM16 interrupt runs right away
+        ow_async_process();
+        BoardTest();
+        eeprom_job_process();
+        sim_advance(tbsim_loop_us);
+    }
+}
+
+static void tbsim_key(uint8_t key, uint8_t b_pressed) {
+    sim_gpio_set(tbsim_keys[key].p_port, tbsim_keys[key].pin, b_pressed != tbsim_keys[key].b_low);
+}
+
+static void tbsim_press(uint8_t key) {
+    tbsim_key(key, 1);
+    tbsim_run(TBSIM_PRESS_MS);
+    tbsim_key(key, 0);
+    tbsim_run(TBSIM_GAP_MS);
+}
+
+/* power on as main(): peripherals, keys and 1-Wire setup */
+static void tbsim_boot(void) {
+    tbsim_key(TBSIM_TORCH, 0);
+    TestMode_Init();
+    MX_TIM16_Init();
+    MX_TIM17_Init();
+    MX_FDCAN2_Init();
+    HAL_TIM_Base_Start_IT(&htim16);
+    HAL_TIM_Base_Start(&htim17);
+    inout_keys_init();
+    msg_send_cfg_request();
+    update_chipstatus(ow_setup_ds2484());
+    tbsim_run(100);
+}
+
+static void tbsim_test_start(void) {
+    static const uint8_t start[8] = {TEST_MODE_T, TEST_MODE_C, TEST_MODE_2, TEST_MODE_2, 0, 0, 0, 0};
+
+    sim_can_receive(MSG_0x1FF, start);
+}
+
+static int tbsim_test_wait(void) {
+    uint64_t limit = sim_time_us() + ((uint64_t)TBSIM_TEST_MAX_MS * 1000);
+
+    while ((e_TestStage != TestOver) && (sim_time_us() < limit)) {
+        tbsim_run(TBSIM_TICK_MS);
+    }
+    return (e_TestStage == TestOver) ? 0 : tbsim_fail("test not finished");
+}
+
+/* results in the order of the 0x200 message: CAN, BKC, UP, DOWN, LEFT, RIGHT, torch switch */
+static int tbsim_results(const char *p_expected) {
+    const test_result_t results[7] = {TestResult.CANTestResult,      TestResult.BKCTestResult,
+                                      TestResult.UPKeyTestResult,    TestResult.DOWNKeyTestResult,
+                                      TestResult.LEFTKeyTestResult,  TestResult.RIGHTKeyTestResult,
+                                      TestResult.StartWeldKeyTestResult};
+    const sim_can_frame_t *p_frame = NULL;
+    char text[8];
+
+    for (uint8_t i = 0; i < 7; i++) {
+        text[i] = (results[i] == Pass) ? 'P' : ((results[i] == Fail) ? 'F' : '-');
+    }
+    text[7] = '\0';
+    if (strcmp(text, p_expected)) {
+        char note[TBSIM_NOTE_LEN];
+
+        snprintf(note, sizeof(note), "results %s, expected %s", text, p_expected);
+        return tbsim_fail(note);
+    }
+    /* the last results message carries the same */
+    for (uint32_t i = sim_can_tx_count(); i-- > 0 && sim_can_tx(i);) {
+        if ((sim_can_tx(i)->id == MSG_0x200) && memcmp(sim_can_tx(i)->data, "CANTEST", 7)) {
+            p_frame = sim_can_tx(i);
+            break;
+        }
+    }
+    for (uint8_t i = 0; p_frame && (i < 7); i++) {
+        if (p_frame->data[i] != results[i]) {
+            p_frame = NULL;
+        }
+    }
+    return p_frame ? 0 : tbsim_fail("results message differs");
+}
+
+/* CO_GET_TESTTIME over CAN as the test rig asks, -1 if not answered */
+static int64_t tbsim_can_testtime(uint8_t index, uint8_t *p_stage) {
+    uint8_t request[8] = {CAN_SW_ID_SystemTorch_FW, CO_GET_TESTTIME, index, 0, 0, 0, 0, TORCH_ID};
+    uint32_t from = sim_can_tx_count();
+
+    sim_can_receive(MSG_0x400, request);
+    tbsim_run(TBSIM_TICK_MS);
+    for (uint32_t i = from; i < sim_can_tx_count(); i++) {
+        const sim_can_frame_t *p_frame = sim_can_tx(i);
+
+        if (p_frame && (p_frame->id == MSG_0x401) && (p_frame->data[1] == CO_GET_TESTTIME) &&
+            (p_frame->data[2] == index)) {
+            *p_stage = p_frame->data[6];
+            return p_frame->data[3] | (p_frame->data[4] << 8) | ((uint32_t)p_frame->data[5] << 16);
+        }
+    }
+    return -1;
+}
+
+/* first inputs message since the frame from whose inputs masked by mask equal expected */
+static const sim_can_frame_t *tbsim_inputs(uint32_t from, uint16_t mask, uint16_t expected) {
+    for (uint32_t i = from; i < sim_can_tx_count(); i++) {
+        const sim_can_frame_t *p_frame = sim_can_tx(i);
+
+        if (p_frame && (p_frame->id == MSG_INPUTS) &&
+            ((((p_frame->data[1] << 8) | p_frame->data[2]) & mask) == expected)) {
+            return p_frame;
+        }
+    }
+    return NULL;
+}
+
+static void tbsim_press_all(void) {
+    for (uint8_t key = 0; key < TBSIM_KEY_N; key++) {
+        tbsim_press(key);
+    }
+}
+
+static int scenario_all_pass(void) {
+    tbsim_boot();
+    tbsim_test_start();
+    tbsim_run(100);
+    tbsim_press_all();
+    return tbsim_test_wait() || tbsim_results("PPPPPPP");
+}
+
+static int scenario_no_ack(void) {
+    tbsim_b_ack = 0;
+    tbsim_boot();
+    tbsim_test_start();
+    tbsim_run(100);
+    tbsim_press_all();
+    if (tbsim_test_wait() || tbsim_results("FPPPPPP")) {
+        return 1;
+    }
+    if ((Get_TestTime(0) < (CANTEST_TIMEOUT * TBSIM_TICK_MS)) ||
+        (Get_TestTime(0) > (CANTEST_TIMEOUT * TBSIM_TICK_MS) + TBSIM_TICK_MS)) {
+        return tbsim_fail("CAN step not timed out after 5 s");
+    }
+    return 0;
+}
+
+static int scenario_tx_error(void) {
+    tbsim_boot();
+    sim_can_faults_get()->b_tx_full = 1;
+    tbsim_test_start();
+    tbsim_run(100);
+    sim_can_faults_get()->b_tx_full = 0;
+    tbsim_press_all();
+    if (tbsim_test_wait() || tbsim_results("FPPPPPP")) {
+        return 1;
+    }
+    return strstr(tbsim_serial, "Transmission request Error") ? 0 : tbsim_fail("transmit error not reported");
+}
+
+static int scenario_key_timeout(void) {
+    int64_t key_ms, total_ms;
+    uint8_t stage = NoState;
+
+    tbsim_boot();
+    tbsim_test_start();
+    if (tbsim_test_wait() || tbsim_results("PPFFFFF")) {
+        return 1;
+    }
+    key_ms = tbsim_can_testtime(2, &stage);
+    total_ms = tbsim_can_testtime(TEST_STEP_N, &stage);
+    if ((key_ms != Get_TestTime(2)) || (total_ms != Get_TestTime(TEST_STEP_N)) || (stage != TestOver)) {
+        return tbsim_fail("CO_GET_TESTTIME differs");
+    }
+    return (key_ms < (KEY_TIMEOUT * TBSIM_TICK_MS)) ? tbsim_fail("key step shorter than 60 s") : 0;
+}
+
+static int scenario_no_eeprom(void) {
+    ow_model_faults()->b_no_device = 1;
+    tbsim_boot();
+    tbsim_test_start();
+    tbsim_run(100);
+    tbsim_press_all();
+    return tbsim_test_wait() || tbsim_results("PFPPPPP");
+}
+
+static int scenario_copy_fail(void) {
+    ow_model_faults()->b_copy_fail = 1;
+    tbsim_boot();
+    tbsim_test_start();
+    tbsim_run(100);
+    tbsim_press_all();
+    return tbsim_test_wait() || tbsim_results("PFPPPPP");
+}
+
+/* a glitch of the torch switch is not sent, a press is sent by the TIM17 compare once it settled */
+static int scenario_torch_glitch(void) {
+    const sim_can_frame_t *p_frame;
+    uint32_t from;
+    uint64_t press_us;
+
+    tbsim_boot();
+    from = sim_can_tx_count();
+    tbsim_key(TBSIM_TORCH, 1);
+    sim_advance(TBSIM_SETTLE_US / 2);
+    tbsim_key(TBSIM_TORCH, 0);
+    tbsim_run(200);
+    if (tbsim_inputs(from, INOUT_TORCH_SWITCH, INOUT_TORCH_SWITCH)) {
+        return tbsim_fail("glitch sent");
+    }
+    press_us = sim_time_us();
+    tbsim_key(TBSIM_TORCH, 1);
+    tbsim_run(100);
+    p_frame = tbsim_inputs(from, INOUT_TORCH_SWITCH, INOUT_TORCH_SWITCH);
+    if (!p_frame) {
+        return tbsim_fail("press not sent");
+    }
+    if ((p_frame->us - press_us) < TBSIM_SETTLE_US) {
+        return tbsim_fail("press sent before it settled");
+    }
+    return ((p_frame->us - press_us) > (TBSIM_SETTLE_US + TBSIM_SEND_US)) ? tbsim_fail("press late") : 0;
+}
+
+/* keys pressed during EwProcess() are sent while TIM16 is disabled, the torch switch once it settled */
+static int scenario_key_during_gui(void) {
+    const sim_can_frame_t *p_frame;
+    uint32_t from;
+    uint64_t press_us;
+
+    tbsim_boot();
+    from = sim_can_tx_count();
+    HAL_NVIC_DisableIRQ(TIM1_UP_TIM16_IRQn);
+    press_us = sim_time_us();
+    tbsim_key(TBSIM_LEFT, 1);
+    sim_advance(10000);
+    p_frame = tbsim_inputs(from, INOUT_BUTTON_LEFT, INOUT_BUTTON_LEFT);
+    if (!p_frame || ((p_frame->us - press_us) > TBSIM_SEND_US)) {
+        return tbsim_fail("push button not sent during EwProcess");
+    }
+    press_us = sim_time_us();
+    tbsim_key(TBSIM_TORCH, 1);
+    sim_advance(20000);
+    p_frame = tbsim_inputs(from, INOUT_TORCH_SWITCH, INOUT_TORCH_SWITCH);
+    if (!p_frame || ((p_frame->us - press_us) > (TBSIM_SETTLE_US + TBSIM_SEND_US))) {
+        return tbsim_fail("torch switch not sent during EwProcess");
+    }
+    HAL_NVIC_EnableIRQ(TIM1_UP_TIM16_IRQn);
+    tbsim_run(20);
+    return 0;
+}
+
+/* a bouncing push button changes the inputs once */
+static int scenario_bounce(void) {
+    uint32_t from, changes = 0;
+    uint16_t left = 0;
+
+    tbsim_boot();
+    from = sim_can_tx_count();
+    for (uint8_t i = 0; i < 5; i++) {
+        tbsim_key(TBSIM_LEFT, !(i & 1));
+        sim_advance(1000);
+    }
+    tbsim_run(200);
+    tbsim_key(TBSIM_LEFT, 0);
+    tbsim_run(200);
+    for (uint32_t i = from; i < sim_can_tx_count(); i++) {
+        const sim_can_frame_t *p_frame = sim_can_tx(i);
+
+        if (p_frame && (p_frame->id == MSG_INPUTS) && ((p_frame->data[1] << 8 & INOUT_BUTTON_LEFT) != left)) {
+            left ^= INOUT_BUTTON_LEFT;
+            changes++;
+        }
+    }
+    return (changes != 2) ? tbsim_fail("bounce sent as several presses") : 0;
+}
+
+static const tbsim_scenario_t tbsim_scenarios[] = {
+    {"all pass", scenario_all_pass},
+    {"CAN no ack", scenario_no_ack},
+    {"CAN TX error", scenario_tx_error},
+    {"key timeout", scenario_key_timeout},
+    {"no EEPROM", scenario_no_eeprom},
+    {"copy failure", scenario_copy_fail},
+    {"torch glitch", scenario_torch_glitch},
+    {"key during GUI", scenario_key_during_gui},
+    {"button bounce", scenario_bounce},
+};
+
+/* runs a scenario from power on and prints its report line, 0 = pass */
+static int tbsim_run_scenario(const tbsim_scenario_t *p_scenario) {
+    uint32_t latency, latency_max;
+    int result;
+
+    sim_reset();
+    ow_model_init();
+    sim_can_set_partner(tbsim_rig);
+    tbsim_b_ack = 1;
+    tbsim_note[0] = '\0';
+
+    result = p_scenario->p_run();
+
+    inout_get_key_latency(&latency, &latency_max);
+    printf("%-16s %-4s %9.3f %6u %6u %6u %6u %6u %6u  %s\n", p_scenario->p_name, result ? "FAIL" : "ok",
+           sim_time_us() / 1000.0, Get_TestTime(0), Get_TestTime(1), Get_TestTime(2), Get_TestTime(TEST_STEP_N),
+           sim_can_tx_count(), latency_max, tbsim_note);
+    if (tbsim_b_verbose) {
+        printf("%s\n", tbsim_serial);
+    }
+    return result;
+}
+
+int main(int argc, char *argv[]) {
+    const char *p_only = NULL;
+    int opt, failed = 0;
+
+    while ((opt = getopt(argc, argv, "g:l:s:v")) != -1) {
+        switch (opt) {
+        case 'g':
+            tbsim_gui_us = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'l':
+            tbsim_loop_us = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            p_only = optarg;
+            break;
+        case 'v':
+            tbsim_b_verbose = 1;
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-g EwProcess us] [-l main loop us] [-s scenario] [-v]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (!tbsim_loop_us) {
+        fprintf(stderr, "main loop period must not be 0\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("EwProcess %u us, main loop %u us\n", tbsim_gui_us, tbsim_loop_us);
+    printf("%-16s %-4s %9s %6s %6s %6s %6s %6s %6s\n", "scenario", "", "ms", "CAN", "BKC", "keys", "total", "CANtx",
+           "latus");
+    for (size_t i = 0; i < sizeof(tbsim_scenarios) / sizeof(tbsim_scenarios[0]); i++) {
+        pid_t pid;
+        int status;
+
+        if (p_only && strcmp(p_only, tbsim_scenarios[i].p_name)) {
+            continue;
+        }
+        /* the firmware keeps its state in static variables, so each scenario gets a fresh process */
+        fflush(stdout);
+        pid = fork();
+        if (pid == 0) {
+            exit(tbsim_run_scenario(&tbsim_scenarios[i]) ? EXIT_FAILURE : EXIT_SUCCESS);
+        }
+        if ((pid < 0) || (waitpid(pid, &status, 0) < 0) || !WIFEXITED(status) || WEXITSTATUS(status)) {
+            failed++;
+        }
+    }
+    printf("%d scenario(s) failed\n", failed);
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+"""Decode the trace ring of the SystemTorch firmware (Core/trace.c).
+
+The ring is read by the debugger as binary dump of the symbol trace_buffer,
+e.g. with gdb:
+
+    dump binary value trace.bin trace_buffer
+
+The format strings are taken from TRACE_TABLE in Core/trace.h, the index of
+an entry is its trace ID.
+
+    tools/trace_decode.py trace.bin [--table Core/trace.h]
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+TRACE_MAGIC = 0x54524331
+HEADER_SYNC = 0xA5
+ARGS_MAX = 4
+
+DEFAULT_TABLE = os.path.join(os.path.dirname(__file__), "..", "Core", "trace.h")
+
+
+def read_table(path):
+    """Returns the format strings of TRACE_TABLE, indexed by trace ID."""
+    with open(path, encoding="utf-8") as f:
+        text = f.read()
+    return [(name, fmt) for name, fmt in re.findall(r'X\((\w+),\s*"((?:[^"\\]|\\.)*)"\)', text)]
+
+
+def read_ring(path):
+    """Returns the CPU clock and the words of the ring, oldest first."""
+    with open(path, "rb") as f:
+        data = f.read()
+    magic, words, head, cpu_hz = struct.unpack_from("<4I", data)
+    if magic != TRACE_MAGIC:
+        sys.exit("no trace_buffer: magic 0x%08x" % magic)
+    ring = struct.unpack_from("<%dI" % words, data, 16)
+    if head <= words:
+        return cpu_hz, list(ring[:head]), False
+    start = head % words
+    return cpu_hz, list(ring[start:] + ring[:start]), True
+
+
+def is_header(word, table):
+    return (word >> 24) == HEADER_SYNC and ((word >> 16) & 0xFF) <= ARGS_MAX and (word & 0xFFFF) < len(table)
+
+
+def records(words, table, b_wrapped):
+    """Yields (id, time stamp, arguments). After a wrap the first record may
+    be cut, decoding starts at the first header from which the records
+    chain up to the end of the ring."""
+    start = 0
+    if b_wrapped:
+        for start in range(len(words)):
+            pos = start
+            while pos < len(words) and is_header(words[pos], table):
+                pos += 2 + ((words[pos] >> 16) & 0xFF)
+            if pos == len(words):
+                break
+    pos = start
+    while pos + 1 < len(words):
+        word = words[pos]
+        if not is_header(word, table):
+            pos += 1
+            continue
+        n = (word >> 16) & 0xFF
+        if pos + 2 + n > len(words):
+            break
+        yield word & 0xFFFF, words[pos + 1], words[pos + 2:pos + 2 + n]
+        pos += 2 + n
+
+
+def format_record(fmt, args):
+    args = list(args)
+    # %d takes the argument as signed 32 bit value
+    conv = re.findall(r"%[-+ #0]*\d*(?:\.\d+)?([diouxXc])", fmt)
+    for i, c in enumerate(conv[:len(args)]):
+        if c in "di" and args[i] & 0x80000000:
+            args[i] -= 1 << 32
+    try:
+        return fmt % tuple(args[:len(conv)])
+    except (TypeError, ValueError):
+        return fmt + " " + " ".join("0x%08x" % a for a in args)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("dump", help="binary dump of trace_buffer")
+    parser.add_argument("--table", default=DEFAULT_TABLE, help="trace.h with TRACE_TABLE")
+    args = parser.parse_args()
+
+    table = read_table(args.table)
+    cpu_hz, words, b_wrapped = read_ring(args.dump)
+    if not cpu_hz:
+        cpu_hz = 1
+
+    time_us = 0.0
+    last = None
+    for trace_id, stamp, trace_args in records(words, table, b_wrapped):
+        # the 32 bit cycle counter wraps, records are assumed to be less than one wrap apart
+        if last is not None:
+            time_us += ((stamp - last) & 0xFFFFFFFF) * 1e6 / cpu_hz
+        last = stamp
+        name, fmt = table[trace_id]
+        print("%12.1f us  %-18s %s" % (time_us, name, format_record(fmt, trace_args)))
+
+
+if __name__ == "__main__":
+    main()